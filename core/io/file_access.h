@@ -192,6 +192,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Returns a read-only view of the next p_length bytes and advances the position, if the storage allows reading in place (e.g., memory-mapped packs).
+	// Returns an empty span otherwise, leaving the position untouched; get_buffer() must be used then. The view is only valid while the file is open.
+	virtual Span<uint8_t> get_buffer_span(uint64_t p_length) const { return Span<uint8_t>(); }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -76,6 +76,12 @@ Error FileAccessMemory::open_custom(const uint8_t *p_data, uint64_t p_len) {
 	return OK;
 }
 
+Error FileAccessMemory::open_buffer(const Vector<uint8_t> &p_data) {
+	buffer = p_data;
+	// Not using ptrw() to avoid a copy-on-write while the caller still holds a reference.
+	return open_custom(buffer.ptr(), buffer.size());
+}
+
 Error FileAccessMemory::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_NULL_V(files, ERR_FILE_NOT_FOUND);
 
@@ -143,6 +149,16 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Span<uint8_t> FileAccessMemory::get_buffer_span(uint64_t p_length) const {
+	if (!data || p_length > length - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> span(&data[pos], p_length);
+	pos += p_length;
+	return span;
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
@@ -37,6 +37,7 @@ class FileAccessMemory : public FileAccess {
 	uint8_t *data = nullptr;
 	uint64_t length = 0;
 	mutable uint64_t pos = 0;
+	Vector<uint8_t> buffer; // Keeps the data passed to open_buffer() alive.
 
 	static Ref<FileAccess> create();
 
@@ -45,6 +46,7 @@ public:
 	static void cleanup();
 
 	virtual Error open_custom(const uint8_t *p_data, uint64_t p_len); ///< open a file
+	Error open_buffer(const Vector<uint8_t> &p_data); ///< open a file that shares ownership of p_data, meant for reading only
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -56,6 +58,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual Span<uint8_t> get_buffer_span(uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -30,12 +30,169 @@
 
 #include "file_access_pack.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
+#ifdef LINUXBSD_ENABLED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Ref<PackMapping> PackMapping::create(const String &p_path) {
+#ifdef LINUXBSD_ENABLED
+	String path = p_path;
+	if (ProjectSettings::get_singleton() && (path.begins_with("res://") || path.begins_with("user://"))) {
+		path = ProjectSettings::get_singleton()->globalize_path(path);
+	}
+
+	// Packs that aren't plain files on disk (e.g., nested in another pack) are read through FileAccess instead.
+	int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return Ref<PackMapping>();
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		::close(fd);
+		return Ref<PackMapping>();
+	}
+
+	void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // The mapping keeps its own reference to the file.
+	if (ptr == MAP_FAILED) {
+		return Ref<PackMapping>();
+	}
+
+	Ref<PackMapping> mapping;
+	mapping.instantiate();
+	mapping->data = (const uint8_t *)ptr;
+	mapping->size = st.st_size;
+	return mapping;
+#else
+	return Ref<PackMapping>();
+#endif
+}
+
+PackMapping::~PackMapping() {
+#ifdef LINUXBSD_ENABLED
+	if (data) {
+		munmap((void *)data, size);
+	}
+#endif
+}
+
+//////////////////////////////////////////////////////////////////
+
+// Spreads p_count items over native tasks of the worker pool, with the calling thread taking part too.
+// Unlike group tasks, waiting for native tasks from another pool task (e.g., a threaded resource load) is collaborative.
+struct PackParallelFor {
+	void (*func)(void *, uint32_t) = nullptr;
+	void *userdata = nullptr;
+	uint32_t count = 0;
+	SafeNumeric<uint32_t> next;
+};
+
+static void _pack_parallel_for_task(void *p_userdata) {
+	PackParallelFor &data = *(PackParallelFor *)p_userdata;
+	for (uint32_t i = data.next.postincrement(); i < data.count; i = data.next.postincrement()) {
+		data.func(data.userdata, i);
+	}
+}
+
+static void _pack_parallel_for(void (*p_func)(void *, uint32_t), void *p_userdata, uint32_t p_count, const String &p_description) {
+	PackParallelFor data;
+	data.func = p_func;
+	data.userdata = p_userdata;
+	data.count = p_count;
+
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	uint32_t task_count = MIN(p_count, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	for (uint32_t i = 1; i < task_count; i++) {
+		task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(&_pack_parallel_for_task, &data, false, p_description));
+	}
+	_pack_parallel_for_task(&data);
+	for (WorkerThreadPool::TaskID task_id : task_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+}
+
+struct PackCompressJob {
+	const uint8_t *src = nullptr;
+	uint32_t src_size = 0;
+	LocalVector<uint8_t> dst;
+};
+
+struct PackCompressJobs {
+	PackCompressJob *jobs = nullptr;
+	Compression::Mode mode = Compression::MODE_ZSTD;
+};
+
+static void _pack_compress_block(void *p_userdata, uint32_t p_index) {
+	PackCompressJobs &jobs = *(PackCompressJobs *)p_userdata;
+	PackCompressJob &job = jobs.jobs[p_index];
+
+	job.dst.resize(Compression::get_max_compressed_buffer_size(job.src_size, jobs.mode));
+	int64_t size = Compression::compress(job.dst.ptr(), job.src, job.src_size, jobs.mode);
+	if (size < 0 || size >= job.src_size) {
+		// Store as is.
+		job.dst.resize(job.src_size);
+		memcpy(job.dst.ptr(), job.src, job.src_size);
+	} else {
+		job.dst.resize(size);
+	}
+}
+
+Vector<uint8_t> PackedData::compress_entry(const Vector<uint8_t> &p_data, Compression::Mode p_mode) {
+	uint64_t size = p_data.size();
+	if (size == 0) {
+		return Vector<uint8_t>();
+	}
+
+	uint32_t block_count = (size + PACK_COMPRESSED_BLOCK_SIZE - 1) / PACK_COMPRESSED_BLOCK_SIZE;
+	LocalVector<PackCompressJob> blocks;
+	blocks.resize(block_count);
+	for (uint32_t i = 0; i < block_count; i++) {
+		uint64_t from = (uint64_t)i * PACK_COMPRESSED_BLOCK_SIZE;
+		blocks[i].src = p_data.ptr() + from;
+		blocks[i].src_size = MIN((uint64_t)PACK_COMPRESSED_BLOCK_SIZE, size - from);
+	}
+
+	PackCompressJobs jobs;
+	jobs.jobs = blocks.ptr();
+	jobs.mode = p_mode;
+	_pack_parallel_for(&_pack_compress_block, &jobs, block_count, "PackedData compression");
+
+	uint64_t total = 12 + block_count * 4;
+	for (const PackCompressJob &block : blocks) {
+		total += block.dst.size();
+	}
+	if (total >= size) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> entry;
+	entry.resize(total);
+	uint8_t *w = entry.ptrw();
+	w += encode_uint32(p_mode, w);
+	w += encode_uint32(PACK_COMPRESSED_BLOCK_SIZE, w);
+	w += encode_uint32(block_count, w);
+	for (const PackCompressJob &block : blocks) {
+		w += encode_uint32(block.dst.size(), w);
+	}
+	for (const PackCompressJob &block : blocks) {
+		memcpy(w, block.dst.ptr(), block.dst.size());
+		w += block.dst.size();
+	}
+	return entry;
+}
+
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
@@ -46,7 +203,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,6 +213,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -180,9 +338,25 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 	}
 }
 
+void PackedData::map_pack(const String &p_pack_path) {
+	// Always map again, the pack may have been rewritten since it was last added.
+	Ref<PackMapping> mapping = PackMapping::create(p_pack_path);
+	if (mapping.is_valid()) {
+		pack_mappings.insert(p_pack_path, mapping);
+	} else {
+		pack_mappings.erase(p_pack_path);
+	}
+}
+
+Ref<PackMapping> PackedData::get_pack_mapping(const String &p_pack_path) const {
+	HashMap<String, Ref<PackMapping>>::ConstIterator E = pack_mappings.find(p_pack_path);
+	return E ? E->value : Ref<PackMapping>();
+}
+
 void PackedData::clear() {
 	files.clear();
 	delta_patches.clear();
+	pack_mappings.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -291,21 +465,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled since V3.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and later: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -346,14 +520,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		if (version < PACK_FORMAT_VERSION_V4) {
+			flags &= ~PACK_FILE_COMPRESSED; // Not defined yet, older packs may have anything there.
+		}
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA));
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), (flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
+	if (!sparse_bundle) {
+		PackedData::get_singleton()->map_pack(p_path);
+	}
+
 	return true;
 }
 
@@ -417,7 +598,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -425,7 +608,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -433,7 +616,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -454,7 +639,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -467,21 +652,270 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	uint64_t from = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.compressed) {
+		ERR_FAIL_COND_V_MSG(!_read_compressed(p_dst, from, to_read), -1, vformat(R"(Can't decompress pack-referenced file "%s", it is corrupted.)", path));
+	} else if (mapped) {
+		memcpy(p_dst, mapped + from, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_buffer_span(uint64_t p_length) const {
+	if (!mapped || pf.compressed || eof || pos > pf.size || p_length > pf.size - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> span(mapped + pos, p_length);
+	pos += p_length;
+	return span;
+}
+
+void FileAccessPack::_decompress_job(void *p_userdata) {
+	DecompressJob &job = *(DecompressJob *)p_userdata;
+	if (job.failed) {
+		return; // Reading the compressed data failed.
+	}
+	if (job.src_size == job.dst_size) {
+		memcpy(job.dst, job.src, job.dst_size); // Stored as is.
+	} else {
+		job.failed = Compression::decompress(job.dst, job.dst_size, job.src, job.src_size, job.mode) != (int64_t)job.dst_size;
+	}
+}
+
+void FileAccessPack::_decompress_jobs(void *p_userdata, uint32_t p_index) {
+	_decompress_job(&((DecompressJob *)p_userdata)[p_index]);
+}
+
+void FileAccessPack::_read_ahead_task(void *p_userdata) {
+	CachedBlock *cached = (CachedBlock *)p_userdata;
+	_decompress_job(&cached->job);
+	_unref_cached_block(cached);
+}
+
+void FileAccessPack::_unref_cached_block(CachedBlock *p_cached) {
+	if (p_cached->refcount.unref()) {
+		memdelete(p_cached);
+	}
+}
+
+// Read-aheads that couldn't be awaited when their file was done with them (see _finish_cached_block()).
+// Awaiting a completed task works from any thread, and is what lets the pool free it.
+static Mutex orphaned_read_aheads_mutex;
+static LocalVector<WorkerThreadPool::TaskID> orphaned_read_aheads;
+
+void FileAccessPack::_reap_orphaned_read_aheads() {
+	MutexLock lock(orphaned_read_aheads_mutex);
+	for (uint32_t i = 0; i < orphaned_read_aheads.size();) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(orphaned_read_aheads[i])) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(orphaned_read_aheads[i]);
+			orphaned_read_aheads.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+Error FileAccessPack::_read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const {
+	if (mapped) {
+		if (p_offset > mapping->get_size() - pf.offset || p_length > mapping->get_size() - pf.offset - p_offset) {
+			return ERR_FILE_CORRUPT;
+		}
+		memcpy(p_dst, mapped + p_offset, p_length);
+		return OK;
+	}
+
+	f->seek(off + p_offset);
+	return f->get_buffer(p_dst, p_length) == p_length ? OK : ERR_FILE_CORRUPT;
+}
+
+Error FileAccessPack::_open_compressed() {
+	uint8_t header[12];
+	Error err = _read_raw(0, header, 12);
+	if (err != OK) {
+		return err;
+	}
+
+	uint32_t mode = decode_uint32(&header[0]);
+	block_size = decode_uint32(&header[4]);
+	uint32_t block_count = decode_uint32(&header[8]);
+	if (mode > Compression::MODE_BROTLI || block_size == 0 || block_count != (pf.size + block_size - 1) / block_size) {
+		return ERR_FILE_CORRUPT;
+	}
+	compression_mode = Compression::Mode(mode);
+
+	LocalVector<uint8_t> sizes;
+	sizes.resize(block_count * 4);
+	err = _read_raw(12, sizes.ptr(), sizes.size());
+	if (err != OK) {
+		return err;
+	}
+
+	block_sizes.resize(block_count);
+	block_offsets.resize(block_count);
+	uint64_t offset = 12 + sizes.size();
+	for (uint32_t i = 0; i < block_count; i++) {
+		block_sizes[i] = decode_uint32(&sizes[i * 4]);
+		block_offsets[i] = offset;
+		offset += block_sizes[i];
+	}
+
+	if (mapped && offset > mapping->get_size() - pf.offset) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	return OK;
+}
+
+void FileAccessPack::_prepare_job(DecompressJob &r_job, uint32_t p_block, LocalVector<uint8_t> &r_compressed, uint8_t *p_dst) const {
+	r_job.block = p_block;
+	r_job.mode = compression_mode;
+	r_job.src_size = block_sizes[p_block];
+	r_job.dst = p_dst;
+	r_job.dst_size = _get_block_data_size(p_block);
+	r_job.failed = false;
+
+	if (mapped) {
+		r_job.src = mapped + block_offsets[p_block];
+	} else {
+		// The file handle can't be shared with worker threads, so the compressed data is read here.
+		r_compressed.resize(r_job.src_size);
+		r_job.failed = _read_raw(block_offsets[p_block], r_compressed.ptr(), r_job.src_size) != OK;
+		r_job.src = r_compressed.ptr();
+	}
+}
+
+void FileAccessPack::_finish_cached_block(CachedBlock *&r_cached) const {
+	if (!r_cached || r_cached->task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
+	Error err = WorkerThreadPool::get_singleton()->wait_for_task_completion(r_cached->task_id);
+	if (err == ERR_BUSY) {
+		// Pool threads can't await tasks older than the one they run (e.g. this file was handed
+		// over from another task), so the read-ahead may still be running. Leave the block to it,
+		// and its task to whoever reaps it once it's done.
+		{
+			MutexLock lock(orphaned_read_aheads_mutex);
+			orphaned_read_aheads.push_back(r_cached->task_id);
+		}
+		_unref_cached_block(r_cached);
+		r_cached = nullptr;
+		return;
+	}
+	r_cached->task_id = WorkerThreadPool::INVALID_TASK_ID;
+}
+
+FileAccessPack::CachedBlock *FileAccessPack::_acquire_cached_block(uint32_t p_slot) const {
+	CachedBlock *&cached = block_cache[p_slot];
+	_finish_cached_block(cached);
+	if (!cached) {
+		cached = memnew(CachedBlock);
+	}
+	return cached;
+}
+
+const uint8_t *FileAccessPack::_get_block(uint32_t p_block) const {
+	CachedBlock &cached = *_acquire_cached_block(p_block % READ_AHEAD_BLOCKS);
+	if (cached.job.block != p_block) {
+		cached.data.resize(_get_block_data_size(p_block));
+		_prepare_job(cached.job, p_block, cached.compressed, cached.data.ptr());
+		_decompress_job(&cached.job);
+	}
+
+	if (p_block == last_block + 1) {
+		// Reading in order, so decompress the next blocks in the background.
+		for (uint32_t i = p_block + 1; i < p_block + READ_AHEAD_BLOCKS && i < block_sizes.size(); i++) {
+			if (block_cache[i % READ_AHEAD_BLOCKS] && block_cache[i % READ_AHEAD_BLOCKS]->job.block == i) {
+				continue;
+			}
+			CachedBlock &ahead = *_acquire_cached_block(i % READ_AHEAD_BLOCKS);
+			ahead.data.resize(_get_block_data_size(i));
+			_prepare_job(ahead.job, i, ahead.compressed, ahead.data.ptr());
+			ahead.mapping = mapping;
+			ahead.refcount.ref(); // Released by the task.
+			ahead.task_id = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessPack::_read_ahead_task, &ahead, false, "FileAccessPack read-ahead");
+		}
+	}
+	last_block = p_block;
+
+	return cached.job.failed ? nullptr : cached.data.ptr();
+}
+
+bool FileAccessPack::_read_cached(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const {
+	while (p_length > 0) {
+		uint32_t block = p_from / block_size;
+		uint64_t block_offset = p_from - (uint64_t)block * block_size;
+		const uint8_t *data = _get_block(block);
+		if (!data) {
+			return false;
+		}
+
+		uint64_t count = MIN(p_length, MIN((uint64_t)block_size, pf.size - (uint64_t)block * block_size) - block_offset);
+		memcpy(p_dst, data + block_offset, count);
+		p_dst += count;
+		p_from += count;
+		p_length -= count;
+	}
+	return true;
+}
+
+bool FileAccessPack::_read_compressed(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const {
+	uint64_t end = p_from + p_length;
+	// Range of blocks covered entirely by the read (the last block ends at the end of the file).
+	uint32_t first_full = (p_from + block_size - 1) / block_size;
+	uint32_t end_full = end == pf.size ? block_sizes.size() : end / block_size;
+
+	if (end_full < first_full + 2) {
+		return _read_cached(p_dst, p_from, p_length);
+	}
+
+	// Large read: decompress whole blocks straight into the destination, in parallel.
+	uint64_t head = (uint64_t)first_full * block_size - p_from;
+	if (head > 0 && !_read_cached(p_dst, p_from, head)) {
+		return false;
+	}
+
+	uint32_t count = end_full - first_full;
+	LocalVector<DecompressJob> jobs;
+	LocalVector<LocalVector<uint8_t>> compressed;
+	jobs.resize(count);
+	compressed.resize(mapped ? 0 : count);
+	LocalVector<uint8_t> unused;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t block = first_full + i;
+		_prepare_job(jobs[i], block, mapped ? unused : compressed[i], p_dst + ((uint64_t)block * block_size - p_from));
+	}
+	_pack_parallel_for(&FileAccessPack::_decompress_jobs, jobs.ptr(), count, "FileAccessPack decompression");
+	for (const DecompressJob &job : jobs) {
+		if (job.failed) {
+			return false;
+		}
+	}
+	last_block = end_full - 1;
+
+	uint64_t tail_from = MIN((uint64_t)end_full * block_size, pf.size);
+	if (tail_from < end && !_read_cached(p_dst + (tail_from - p_from), tail_from, end - tail_from)) {
+		return false;
+	}
+	return true;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -504,7 +938,17 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	for (CachedBlock *&cached : block_cache) {
+		_finish_cached_block(cached);
+		if (cached) {
+			_unref_cached_block(cached);
+			cached = nullptr;
+		}
+	}
+	_reap_orphaned_read_aheads();
 	f = Ref<FileAccess>();
+	mapping = Ref<PackMapping>();
+	mapped = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
@@ -516,10 +960,22 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from sparse pack "%s".)", simplified_path, pf.pack));
 		off = 0; // For the sparse pack offset is always zero.
 	} else {
-		f = FileAccess::open(pf.pack, FileAccess::READ);
-		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
-		f->seek(pf.offset);
-		off = pf.offset;
+		if (!pf.encrypted) {
+			mapping = PackedData::get_singleton()->get_pack_mapping(pf.pack);
+		}
+		// The stored size of compressed entries is only known once their header is read, it's checked then.
+		if (mapping.is_valid() && pf.offset <= mapping->get_size() && (pf.compressed || pf.size <= mapping->get_size() - pf.offset)) {
+			// Read straight from the mapped pack, without opening a file handle.
+			mapped = mapping->get_data() + pf.offset;
+			off = pf.offset;
+		} else {
+			mapping = Ref<PackMapping>();
+
+			f = FileAccess::open(pf.pack, FileAccess::READ);
+			ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+			f->seek(pf.offset);
+			off = pf.offset;
+		}
 	}
 
 	if (pf.encrypted) {
@@ -540,6 +996,18 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	}
 	pos = 0;
 	eof = false;
+
+	if (pf.compressed) {
+		Error err = _open_compressed();
+		if (err != OK) {
+			close();
+			ERR_FAIL_MSG(vformat(R"(Can't open compressed pack-referenced file "%s" from pack "%s", it is corrupted.)", p_path, pf.pack));
+		}
+	}
+}
+
+FileAccessPack::~FileAccessPack() {
+	close();
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -30,8 +30,10 @@
 
 #pragma once
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -41,9 +43,10 @@
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION_V4 4 // Same layout as V3, adds compressed entries (PACK_FILE_COMPRESSED).
 
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -55,10 +58,34 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3, // Since PACK_FORMAT_VERSION_V4, ignored before.
 };
 
+// Compressed entries (PACK_FILE_COMPRESSED) start with the compression mode, the block size and the
+// block count (32 bits each), followed by the compressed size of every block, and then the blocks.
+// Blocks that don't shrink are stored as is, with their compressed size equal to the uncompressed one.
+// The size stored in the directory is always the uncompressed one.
+#define PACK_COMPRESSED_BLOCK_SIZE (128 * 1024)
+
 class PackSource;
 
+// Read-only memory mapping of a whole pack file. Shared by the files reading
+// from it, so the mapping outlives a PackedData::clear() while they are open.
+class PackMapping : public RefCounted {
+	GDSOFTCLASS(PackMapping, RefCounted);
+
+	const uint8_t *data = nullptr;
+	uint64_t size = 0;
+
+public:
+	static Ref<PackMapping> create(const String &p_path);
+
+	_FORCE_INLINE_ const uint8_t *get_data() const { return data; }
+	_FORCE_INLINE_ uint64_t get_size() const { return size; }
+
+	~PackMapping();
+};
+
 class PackedData {
 	friend class FileAccessPack;
 	friend class DirAccessPack;
@@ -74,6 +101,7 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed;
 	};
 
 private:
@@ -108,6 +136,7 @@ private:
 	HashMap<PathMD5, Vector<PackedFile>, PathMD5> delta_patches;
 
 	Vector<PackSource *> sources;
+	HashMap<String, Ref<PackMapping>> pack_mappings;
 
 	PackedDir *root = nullptr;
 
@@ -119,16 +148,21 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
 	bool has_delta_patches(const String &p_path) const;
 	HashSet<String> get_file_paths() const;
+	void map_pack(const String &p_pack_path); // for PackSource
+	Ref<PackMapping> get_pack_mapping(const String &p_pack_path) const;
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Returns p_data encoded as a compressed entry, or an empty buffer if compressing doesn't make it smaller.
+	static Vector<uint8_t> compress_entry(const Vector<uint8_t> &p_data, Compression::Mode p_mode);
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -177,6 +211,57 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Ref<PackMapping> mapping;
+	const uint8_t *mapped = nullptr; // Start of the file contents, if read from a mapping instead of f.
+
+	// Compressed entries are decompressed one block at a time. Large reads decompress
+	// their blocks in parallel, and sequential reads decompress the next blocks ahead.
+	static constexpr uint32_t READ_AHEAD_BLOCKS = 4;
+
+	struct DecompressJob {
+		uint32_t block = UINT32_MAX;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		const uint8_t *src = nullptr;
+		uint32_t src_size = 0;
+		uint8_t *dst = nullptr;
+		uint32_t dst_size = 0;
+		bool failed = false;
+	};
+
+	// Shared by the file and its read-ahead task, whichever is done with it last frees it.
+	struct CachedBlock {
+		DecompressJob job;
+		LocalVector<uint8_t> compressed; // Only used when not reading from a mapping.
+		LocalVector<uint8_t> data;
+		Ref<PackMapping> mapping; // Keeps the source of the job alive.
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		SafeRefCount refcount;
+
+		CachedBlock() { refcount.init(); }
+	};
+
+	Compression::Mode compression_mode = Compression::MODE_ZSTD;
+	uint32_t block_size = 0;
+	LocalVector<uint32_t> block_sizes; // Compressed.
+	LocalVector<uint64_t> block_offsets; // From the start of the entry.
+	mutable CachedBlock *block_cache[READ_AHEAD_BLOCKS] = {};
+	mutable uint32_t last_block = UINT32_MAX;
+
+	static void _decompress_job(void *p_userdata);
+	static void _decompress_jobs(void *p_userdata, uint32_t p_index);
+	static void _read_ahead_task(void *p_userdata);
+	static void _unref_cached_block(CachedBlock *p_cached);
+	static void _reap_orphaned_read_aheads();
+	Error _read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const;
+	Error _open_compressed();
+	_FORCE_INLINE_ uint32_t _get_block_data_size(uint32_t p_block) const { return MIN((uint64_t)block_size, pf.size - (uint64_t)p_block * block_size); }
+	void _prepare_job(DecompressJob &r_job, uint32_t p_block, LocalVector<uint8_t> &r_compressed, uint8_t *p_dst) const;
+	void _finish_cached_block(CachedBlock *&r_cached) const;
+	CachedBlock *_acquire_cached_block(uint32_t p_slot) const;
+	const uint8_t *_get_block(uint32_t p_block) const;
+	bool _read_cached(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const;
+	bool _read_compressed(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -203,6 +288,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_span(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -217,6 +303,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	~FileAccessPack();
 };
 
 int64_t PackedData::get_size(const String &p_path) {
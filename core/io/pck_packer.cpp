@@ -31,9 +31,8 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
-#include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FORMAT_VERSION_V3
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -51,6 +50,10 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_compression_mode", "mode"), &PCKPacker::set_compression_mode);
+	ClassDB::bind_method(D_METHOD("get_compression_mode"), &PCKPacker::get_compression_mode);
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -90,7 +93,8 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	// Raised in flush() if any entry ends up compressed, so other packs stay readable by older versions.
+	file->store_32(PACK_FORMAT_VERSION_V3);
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -172,6 +176,14 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	}
 	pf.encrypted = p_encrypt;
 
+	if (compression_enabled) {
+		Vector<uint8_t> compressed = PackedData::compress_entry(data, Compression::Mode(compression_mode));
+		if (!compressed.is_empty()) {
+			data = compressed;
+			pf.compressed = true;
+		}
+	}
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -253,6 +265,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -265,10 +280,34 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	for (const File &pf : files) {
+		if (pf.compressed) {
+			file->seek(4); // Version, right after the magic.
+			file->store_32(PACK_FORMAT_VERSION);
+			break;
+		}
+	}
+
 	file.unref();
 	return OK;
 }
 
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_compression_mode(FileAccess::CompressionMode p_mode) {
+	compression_mode = p_mode;
+}
+
+FileAccess::CompressionMode PCKPacker::get_compression_mode() const {
+	return compression_mode;
+}
+
 PCKPacker::~PCKPacker() {
 	if (file.is_valid()) {
 		flush();
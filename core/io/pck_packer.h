@@ -30,10 +30,9 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
 
-class FileAccess;
-
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
@@ -42,6 +41,8 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool compression_enabled = false;
+	FileAccess::CompressionMode compression_mode = FileAccess::COMPRESSION_ZSTD;
 
 	uint64_t file_base = 0;
 	uint64_t file_base_ofs = 0;
@@ -55,6 +56,7 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		bool removal = false;
 		Vector<uint8_t> md5;
 	};
@@ -66,5 +68,10 @@ public:
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+	void set_compression_mode(FileAccess::CompressionMode p_mode);
+	FileAccess::CompressionMode get_compression_mode() const;
+
 	~PCKPacker();
 };
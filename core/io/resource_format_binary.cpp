@@ -157,12 +157,16 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
+		Span<uint8_t> span = f->get_buffer_span(len);
+		if (!span.is_empty()) {
+			return String::utf8((const char *)span.ptr(), len);
+		}
+		if ((int)len > str_buf.size()) {
+			str_buf.resize(len);
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		return String::utf8(&str_buf[0], len);
 	}
@@ -923,12 +927,17 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
 	if (len == 0) {
 		return String();
 	}
+	// Parse in place when the file is memory-backed (e.g., mapped packs or prefetched data).
+	Span<uint8_t> span = f->get_buffer_span(len);
+	if (!span.is_empty()) {
+		return String::utf8((const char *)span.ptr(), len);
+	}
+	if (len > str_buf.size()) {
+		str_buf.resize(len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	return String::utf8(&str_buf[0], len);
 }
@@ -1214,8 +1223,12 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 		*r_error = ERR_FILE_CANT_OPEN;
 	}
 
-	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Error err = OK;
+	// A threaded load may have read this file ahead already, along with the rest of its dependencies.
+	Ref<FileAccess> f = ResourceLoader::take_prefetched_file(p_path);
+	if (f.is_null()) {
+		f = FileAccess::open(p_path, FileAccess::READ, &err);
+	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
 
@@ -1296,10 +1309,14 @@ void ResourceFormatLoaderBinary::get_dependencies(const String &p_path, List<Str
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot open file '%s'.", p_path));
 
+	get_file_dependencies(f, p_path, p_dependencies, p_add_types);
+}
+
+void ResourceFormatLoaderBinary::get_file_dependencies(Ref<FileAccess> p_f, const String &p_path, List<String> *p_dependencies, bool p_add_types) {
 	ResourceLoaderBinary loader;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
 	loader.res_path = loader.local_path;
-	loader.get_dependencies(f, p_dependencies, p_add_types);
+	loader.get_dependencies(p_f, p_dependencies, p_add_types);
 }
 
 Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) {
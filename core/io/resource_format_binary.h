@@ -120,6 +120,8 @@ public:
 	virtual ResourceUID::ID get_resource_uid(const String &p_path) const override;
 	virtual bool has_custom_uid_support() const override;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override;
+	// Same as get_dependencies(), for a file that is already open (or read into memory).
+	static void get_file_dependencies(Ref<FileAccess> p_f, const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) override;
 };
 
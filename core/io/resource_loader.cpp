@@ -34,6 +34,9 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -389,6 +392,10 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	}
 	// --
 
+	if (load_task.prefetch_budget) {
+		_prefetch_dependencies(load_task);
+	}
+
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
@@ -398,6 +405,11 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 		MessageQueue::get_singleton()->flush();
 	}
 
+	if (load_task.prefetched_files.size()) {
+		// Anything left was not consumed (e.g., already cached or loaded by a non-binary loader).
+		_release_prefetched_files(load_task);
+	}
+
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
@@ -613,6 +625,11 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			if (p_for_user && load_task.use_sub_threads) {
+				// Only the root of a threaded request reads ahead; sub-tasks consume what it prefetched.
+				int64_t budget_mb = GLOBAL_GET("threading/resource_loader/prefetch_budget_mb");
+				load_task.prefetch_budget = (uint64_t)MAX(budget_mb, 0) * 1024 * 1024;
+			}
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -663,6 +680,186 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+void ResourceLoader::_prefetch_file(void *p_userdata) {
+	PrefetchRequest &request = *(PrefetchRequest *)p_userdata;
+
+	request.file_path = _path_remap(request.path);
+	if (ResourceFormatImporter::get_singleton()->recognize_path(request.file_path)) {
+		request.file_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(request.file_path);
+		if (request.file_path.is_empty()) {
+			get_dependencies(request.path, &request.dependencies);
+			return;
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open(request.file_path, FileAccess::READ);
+	uint8_t header[4] = {};
+	if (f.is_valid() && f->get_buffer(header, 4) != 4) {
+		f.unref();
+	}
+	bool compressed = header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C';
+	if (f.is_null() || (!compressed && (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C'))) {
+		// Only binary resources are read ahead, as their loader is the one consuming prefetched data.
+		// Other files are only scanned for their dependencies.
+		f.unref();
+		get_dependencies(request.path, &request.dependencies);
+		return;
+	}
+
+	Ref<FileAccess> src = f;
+	uint64_t offset = 0;
+	if (compressed) {
+		// Decompress here, so the loader gets a plain binary resource to parse.
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		if (fac->open_after_magic(f) != OK) {
+			return;
+		}
+		src = fac;
+		offset = 4;
+	} else {
+		f->seek(0);
+	}
+
+	uint64_t size = src->get_length() + offset;
+	if (prefetched_bytes.add(size) > request.budget) {
+		prefetched_bytes.sub(size);
+		f->seek(0);
+		ResourceFormatLoaderBinary::get_file_dependencies(f, request.file_path, &request.dependencies);
+		return;
+	}
+
+	request.data.resize(size);
+	uint8_t *w = request.data.ptrw();
+	if (compressed) {
+		memcpy(w, "RSRC", 4);
+	}
+	if (src->get_buffer(w + offset, size - offset) != size - offset) {
+		request.data.clear();
+		prefetched_bytes.sub(size);
+		return;
+	}
+
+	// Parse the dependencies from the data read ahead, so the file is only read once.
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_buffer(request.data);
+	ResourceFormatLoaderBinary::get_file_dependencies(fa, request.file_path, &request.dependencies);
+}
+
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task) {
+	bool deep = p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP || p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP;
+
+	HashSet<String> visited;
+	visited.insert(p_load_task.local_path);
+
+	LocalVector<PrefetchRequest> requests;
+	requests.resize(1);
+	requests[0].path = p_load_task.local_path;
+	requests[0].budget = p_load_task.prefetch_budget;
+
+	// Walk the dependency closure one level at a time. Every file in a level is
+	// read (and decompressed) by its own task, which also discovers the next level.
+	while (requests.size()) {
+		if (requests.size() == 1) {
+			_prefetch_file(&requests[0]);
+		} else {
+			LocalVector<WorkerThreadPool::TaskID> task_ids;
+			task_ids.resize(requests.size());
+			for (uint32_t i = 0; i < requests.size(); i++) {
+				task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_prefetch_file, &requests[i], false, "ResourceLoader prefetch");
+			}
+			for (WorkerThreadPool::TaskID task_id : task_ids) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+			}
+		}
+
+		LocalVector<PrefetchRequest> next_requests;
+		{
+			MutexLock prefetch_lock(prefetch_mutex);
+			for (PrefetchRequest &request : requests) {
+				if (request.data.is_empty()) {
+					continue;
+				}
+				if (prefetched_files.has(request.file_path)) {
+					// Another threaded load read it ahead already.
+					prefetched_bytes.sub(request.data.size());
+					continue;
+				}
+				prefetched_files.insert(request.file_path, request.data);
+				p_load_task.prefetched_files.push_back(request.file_path);
+				prefetched_count.increment();
+			}
+		}
+
+		for (const PrefetchRequest &request : requests) {
+			for (const String &dep : request.dependencies) {
+				// Dependencies come as "uid::type::fallback_path", with the last two being optional.
+				String path = ResourceUID::ensure_path(dep.get_slice("::", 0));
+				if (path.is_empty() && dep.get_slice_count("::") > 2) {
+					path = dep.get_slice("::", 2);
+				}
+				if (path.is_empty()) {
+					continue;
+				}
+				path = _validate_local_path(path);
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+				if (!deep && ResourceCache::has(path)) {
+					continue;
+				}
+
+				PrefetchRequest next_request;
+				next_request.path = path;
+				next_request.budget = p_load_task.prefetch_budget;
+				next_requests.push_back(next_request);
+			}
+		}
+
+		requests = next_requests;
+	}
+}
+
+void ResourceLoader::_release_prefetched_files(ThreadLoadTask &p_load_task) {
+	MutexLock prefetch_lock(prefetch_mutex);
+	for (const String &path : p_load_task.prefetched_files) {
+		HashMap<String, Vector<uint8_t>>::Iterator E = prefetched_files.find(path);
+		if (E) {
+			prefetched_bytes.sub(E->value.size());
+			prefetched_count.decrement();
+			prefetched_files.remove(E);
+		}
+	}
+	p_load_task.prefetched_files.clear();
+}
+
+Ref<FileAccess> ResourceLoader::take_prefetched_file(const String &p_path) {
+	if (prefetched_count.get() == 0) {
+		return Ref<FileAccess>();
+	}
+
+	Vector<uint8_t> data;
+	{
+		MutexLock prefetch_lock(prefetch_mutex);
+		HashMap<String, Vector<uint8_t>>::Iterator E = prefetched_files.find(p_path);
+		if (!E) {
+			return Ref<FileAccess>();
+		}
+		data = E->value;
+		prefetched_files.remove(E);
+	}
+	prefetched_bytes.sub(data.size());
+	prefetched_count.decrement();
+	prefetch_hit_count.increment();
+
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_buffer(data);
+	return fa;
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -1584,6 +1781,12 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+Mutex ResourceLoader::prefetch_mutex;
+HashMap<String, Vector<uint8_t>> ResourceLoader::prefetched_files;
+SafeNumeric<uint64_t> ResourceLoader::prefetched_bytes;
+SafeNumeric<uint32_t> ResourceLoader::prefetched_count;
+SafeNumeric<uint64_t> ResourceLoader::prefetch_hit_count;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 
@@ -33,13 +33,16 @@
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 namespace CoreBind {
 class ResourceLoader;
 }
 
 class ConditionVariable;
+class FileAccess;
 
 template <int Tag>
 class SafeBinaryMutex;
@@ -189,6 +192,8 @@ private:
 		Error error = OK;
 		Ref<Resource> resource;
 		HashSet<String> sub_tasks;
+		uint64_t prefetch_budget = 0; // Non-zero if the dependency closure is read ahead before loading.
+		LocalVector<String> prefetched_files; // Read-ahead entries this task owns, dropped once it finishes.
 
 		bool awaited : 1; // If it's in the pool, this helps not awaiting from more than one dependent thread.
 		bool need_wait : 1;
@@ -210,6 +215,24 @@ private:
 	};
 	static void _run_load_task(void *p_userdata);
 
+	struct PrefetchRequest {
+		String path; // Local path, used to discover further dependencies.
+		String file_path; // Path of the file actually read, after remaps.
+		uint64_t budget = 0;
+		Vector<uint8_t> data;
+		List<String> dependencies;
+	};
+
+	static Mutex prefetch_mutex;
+	static HashMap<String, Vector<uint8_t>> prefetched_files;
+	static SafeNumeric<uint64_t> prefetched_bytes;
+	static SafeNumeric<uint32_t> prefetched_count;
+	static SafeNumeric<uint64_t> prefetch_hit_count; // Files handed over by take_prefetched_file().
+
+	static void _prefetch_file(void *p_userdata);
+	static void _prefetch_dependencies(ThreadLoadTask &p_load_task);
+	static void _release_prefetched_files(ThreadLoadTask &p_load_task);
+
 	static thread_local bool import_thread;
 	static thread_local int load_nesting;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
@@ -237,6 +260,10 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; }
 
+	// Returns the file contents read ahead by a threaded load, if any, handing them over to the caller.
+	static Ref<FileAccess> take_prefetched_file(const String &p_path);
+	static uint64_t get_prefetch_hit_count() { return prefetch_hit_count.get(); }
+
 	static void resource_changed_connect(Resource *p_source, const Callable &p_callable, uint32_t p_flags);
 	static void resource_changed_disconnect(Resource *p_source, const Callable &p_callable);
 	static void resource_changed_emit(Resource *p_source);
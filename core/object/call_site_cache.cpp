@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  call_site_cache.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "call_site_cache.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/object.h"
+#include "core/variant/variant_internal.h"
+
+void CallSiteCache::_set_signature(int p_argument_count, bool p_vararg, bool p_returns, Variant::Type p_return_type) {
+	returns = p_returns;
+	return_type = p_return_type;
+	validated_argument_count = -1;
+	if (p_vararg || p_argument_count > MAX_VALIDATED_ARGUMENTS) {
+		return;
+	}
+	for (int i = 0; i < p_argument_count; i++) {
+		Variant::Type arg_type = Variant::Type(argument_types[i]);
+		if (arg_type == Variant::OBJECT || arg_type == Variant::ARRAY || arg_type == Variant::DICTIONARY) {
+			return;
+		}
+	}
+	validated_argument_count = p_argument_count;
+}
+
+bool CallSiteCache::_can_call_validated(const Variant **p_args, int p_argcount) const {
+	if (p_argcount != validated_argument_count) {
+		return false;
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		// NIL stands for a Variant parameter, which takes anything.
+		if (argument_types[i] != Variant::NIL && p_args[i]->get_type() != argument_types[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void CallSiteCache::reset() {
+	// The resolve count carries on, owners compare it with their copy to know whether it resolved again.
+	const uint32_t count = resolve_count;
+	*this = CallSiteCache();
+	resolve_count = count;
+}
+
+Variant CallSiteCache::call_method_bind(Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	const GDType *object_type = &p_object->get_gdtype();
+	const uint32_t methods_version = ClassDB::get_methods_version();
+	if (unlikely(type != object_type || version != methods_version)) {
+		reset();
+		type = object_type;
+		version = methods_version;
+		resolve_count++;
+		uses_callp = p_object->_is_callp_overriddenv();
+		method_bind = ClassDB::get_method(object_type->get_name(), p_method);
+		if (method_bind && !uses_callp) {
+			int argument_count = method_bind->get_argument_count();
+			for (int i = 0; i < MIN(argument_count, MAX_VALIDATED_ARGUMENTS); i++) {
+				argument_types[i] = method_bind->get_argument_type(i);
+			}
+			_set_signature(argument_count, method_bind->is_vararg(), method_bind->has_return(), method_bind->get_argument_type(-1));
+		}
+	}
+
+	if (unlikely(uses_callp)) {
+		return p_object->callp(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	if (unlikely(!method_bind)) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+		return Variant();
+	}
+
+	if (_can_call_validated(p_args, p_argcount)) {
+		Variant ret;
+		if (returns) {
+			VariantInternal::initialize(&ret, return_type);
+		}
+		method_bind->validated_call(p_object, p_args, &ret);
+		return ret;
+	}
+	return method_bind->call(p_object, p_args, p_argcount, r_error);
+}
+
+void CallSiteCache::call(Variant &p_self, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	const Variant::Type self_type = p_self.get_type();
+	if (self_type == Variant::OBJECT) {
+		Object *obj = p_self.get_validated_object();
+		if (unlikely(!obj)) {
+			// Let Variant report the null or freed instance.
+			p_self.callp(p_method, p_args, p_argcount, r_ret, r_error);
+			return;
+		}
+		r_ret = obj->callp_cached(p_method, p_args, p_argcount, r_error, *this);
+		return;
+	}
+
+	if (unlikely(type != nullptr || builtin_type != self_type || !builtin_method)) {
+		reset();
+		builtin_type = self_type;
+		resolve_count++;
+		builtin_method = Variant::get_validated_builtin_method(self_type, p_method);
+		if (builtin_method) {
+			int argument_count = Variant::get_builtin_method_argument_count(self_type, p_method);
+			for (int i = 0; i < MIN(argument_count, MAX_VALIDATED_ARGUMENTS); i++) {
+				argument_types[i] = Variant::get_builtin_method_argument_type(self_type, p_method, i);
+			}
+			_set_signature(argument_count, Variant::is_builtin_method_vararg(self_type, p_method), Variant::has_builtin_method_return_value(self_type, p_method), Variant::get_builtin_method_return_type(self_type, p_method));
+		}
+	}
+
+	if (!builtin_method || !_can_call_validated(p_args, p_argcount)) {
+		// Unknown methods, default arguments and conversions are handled (and reported) by the regular path.
+		p_self.callp(p_method, p_args, p_argcount, r_ret, r_error);
+		return;
+	}
+
+	// Not written in place, r_ret may be one of the arguments.
+	r_error.error = Callable::CallError::CALL_OK;
+	Variant ret;
+	if (returns) {
+		VariantInternal::initialize(&ret, return_type);
+	}
+	builtin_method(&p_self, p_args, p_argcount, &ret);
+	r_ret = ret;
+}
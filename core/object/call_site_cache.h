@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  call_site_cache.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/callable.h"
+#include "core/variant/variant.h"
+
+class GDType;
+class MethodBind;
+class Object;
+
+// Remembers what a call site resolved its method name to, so calling the same
+// method on the same type again skips the ClassDB (or builtin method) lookup.
+//
+// The cache is keyed by the object's GDType (or the Variant type for builtin
+// calls) and the ClassDB methods version, so it re-resolves by itself when the
+// target's type changes or methods are (un)registered. The method name is not
+// stored: the owner passes it to every call and must always pass the same one.
+//
+// When the arguments' Variant types match the method signature exactly, the
+// call goes straight to the validated call, skipping argument conversion and
+// default argument handling. Object, Array and Dictionary parameters always go
+// through the regular call, since their class or element types can't be
+// checked from the Variant type alone.
+//
+// Caches are plain data and not thread-safe; each call site owns its copy.
+class CallSiteCache {
+public:
+	static constexpr int MAX_VALIDATED_ARGUMENTS = 8;
+
+private:
+	const GDType *type = nullptr;
+	MethodBind *method_bind = nullptr;
+	Variant::ValidatedBuiltInMethod builtin_method = nullptr;
+	uint32_t version = 0;
+	uint32_t resolve_count = 0;
+	Variant::Type builtin_type = Variant::NIL;
+	Variant::Type return_type = Variant::NIL;
+	int8_t validated_argument_count = -1; // -1 if the validated call can't be used.
+	bool returns = false;
+	bool uses_callp = false; // The class overrides Object::callp(), so it must always be called through it.
+	uint8_t argument_types[MAX_VALIDATED_ARGUMENTS] = {};
+
+	void _set_signature(int p_argument_count, bool p_vararg, bool p_returns, Variant::Type p_return_type);
+	bool _can_call_validated(const Variant **p_args, int p_argcount) const;
+
+public:
+	bool is_resolved() const { return type != nullptr || builtin_method != nullptr; }
+	// Increases every time the cache resolves a call site, which tells owners holding a copy whether to write it back.
+	uint32_t get_resolve_count() const { return resolve_count; }
+	void reset();
+
+	// Calls a method bound in ClassDB. Only to be used once the object's script instance has been ruled out,
+	// prefer Object::callp_cached() which does that.
+	Variant call_method_bind(Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// Equivalent to Variant::callp().
+	void call(Variant &p_self, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+};
@@ -63,6 +63,7 @@ ClassDB::APIType ClassDB::get_current_api() {
 }
 
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
+SafeNumeric<uint32_t> ClassDB::methods_version;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
@@ -1934,6 +1935,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 #endif // DEBUG_ENABLED
 
 	type->method_map[method_name] = p_method;
+	methods_version.increment();
 }
 
 MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility) {
@@ -1960,6 +1962,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, vformat("Method already bound: '%s::%s'.", instance_type, p_name));
 	}
 	type->method_map[p_name] = bind;
+	methods_version.increment();
 #ifdef DEBUG_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
@@ -2023,6 +2026,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 		_bind_compatibility(type, p_bind);
 	} else {
 		type->method_map[mdname] = p_bind;
+		methods_version.increment();
 	}
 
 	Vector<Variant> defvals;
@@ -2380,6 +2384,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_
 		}
 	}
 	classes.erase(p_class);
+	methods_version.increment();
 	default_values_cached.erase(p_class);
 	default_values.erase(p_class);
 #ifdef TOOLS_ENABLED
@@ -2438,6 +2443,7 @@ void ClassDB::cleanup() {
 	}
 
 	classes.clear();
+	methods_version.increment();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
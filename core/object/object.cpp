@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/object/class_db.h"
 #include "core/object/message_queue.h"
+#include "core/object/persistence_schema.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
@@ -720,45 +721,26 @@ Dictionary Object::get_persistent_properties(const Variant &p_tags) const {
 
 	Dictionary result;
 
-	// Get all properties
-	List<PropertyInfo> properties;
-	get_property_list(&properties);
-
-	// Filter and group properties with PROPERTY_USAGE_PERSISTENCE flag
-	StringName current_tag = SNAME("general");
-
-	for (const PropertyInfo &prop : properties) {
-		// Detect persistence group change
-		if ((prop.usage & PROPERTY_USAGE_GROUP) && (prop.usage & PROPERTY_USAGE_PERSISTENCE)) {
-			current_tag = prop.name;
-			continue;
-		}
-
-		if (!(prop.usage & PROPERTY_USAGE_PERSISTENCE)) {
-			continue;
-		}
-
-		StringName tag = prop.hint_string;
-		if (tag.is_empty()) {
-			tag = current_tag;
-		}
+	// The schema holds the PROPERTY_USAGE_PERSISTENCE properties already grouped by tag.
+	Ref<PersistenceSchema> schema = PersistenceSchema::get_for_object(this);
+	ERR_FAIL_COND_V(schema.is_null(), result);
 
+	for (const PersistenceSchema::Tag &tag : schema->tags) {
 		// Filter by requested tags if needed
-		if (!tags.is_empty() && !tags.has(tag)) {
+		if (!tags.is_empty() && !tags.has(tag.name)) {
 			continue;
 		}
 
-		// Ensure sub-dictionary for the tag exists
-		if (!result.has(tag)) {
-			result[tag] = Dictionary();
-		}
-
-		// Get property value
-		bool valid = false;
-		Variant value = get(prop.name, &valid);
-		if (valid) {
-			((Dictionary)result[tag])[prop.name] = value;
+		Dictionary tag_data;
+		for (uint32_t prop_idx : tag.properties) {
+			const PersistenceSchema::Property &prop = schema->properties[prop_idx];
+			bool valid = false;
+			Variant value = schema->get_value(this, prop, &valid);
+			if (valid) {
+				tag_data[prop.name] = value;
+			}
 		}
+		result[tag.name] = tag_data;
 	}
 
 	// Call virtual hook for custom persistence data
@@ -768,82 +750,58 @@ Dictionary Object::get_persistent_properties(const Variant &p_tags) const {
 	return result;
 }
 
+static void _restore_persistent_value(Object *p_object, const PersistenceSchema *p_schema, const PersistenceSchema::Property &p_prop, const Variant &p_value) {
+	// Type validation: Ensure loaded value matches property type
+	if (p_value.get_type() != p_prop.type && p_prop.type != Variant::NIL) {
+		// Attempt type conversion for common cases
+		Callable::CallError ce;
+		Variant converted;
+		const Variant *args[] = { &p_value };
+		Variant::construct(p_prop.type, converted, args, 1, ce);
+
+		if (ce.error == Callable::CallError::CALL_OK && converted.get_type() == p_prop.type) {
+			p_schema->set_value(p_object, p_prop, converted);
+		} else {
+			ERR_PRINT(vformat("SaveServer: Type mismatch for property '%s'. Expected %s, got %s. Skipping.",
+					p_prop.name, Variant::get_type_name(p_prop.type), Variant::get_type_name(p_value.get_type())));
+		}
+	} else {
+		p_schema->set_value(p_object, p_prop, p_value);
+	}
+}
+
 void Object::set_persistent_properties(const Dictionary &p_data) {
 	// Send notification before loading
 	notification(NOTIFICATION_PERSISTENCE_LOAD);
 
-	// Get all properties to validate and map by name
-	List<PropertyInfo> properties;
-	get_property_list(&properties);
-
-	// Build a map of valid persistent properties: Name -> (Tag, Type)
-	struct PropertyMetadata {
-		StringName tag;
-		Variant::Type type;
-	};
-	HashMap<StringName, PropertyMetadata> persistence_map;
-	StringName current_tag = SNAME("general");
-
-	for (const PropertyInfo &prop : properties) {
-		// Detect persistence group change
-		if ((prop.usage & PROPERTY_USAGE_GROUP) && (prop.usage & PROPERTY_USAGE_PERSISTENCE)) {
-			current_tag = prop.name;
-			continue;
-		}
-
-		if (prop.usage & PROPERTY_USAGE_PERSISTENCE) {
-			StringName tag = prop.hint_string;
-			if (tag.is_empty()) {
-				tag = current_tag;
-			}
-			PropertyMetadata meta;
-			meta.tag = tag;
-			meta.type = prop.type;
-			persistence_map[prop.name] = meta;
-		}
-	}
+	Ref<PersistenceSchema> schema = PersistenceSchema::get_for_object(this);
+	ERR_FAIL_COND(schema.is_null());
 
 	// Restore properties from hierarchical structure
-	Array tags = p_data.keys();
-	for (int i = 0; i < tags.size(); i++) {
-		Variant tag_val = p_data[tags[i]];
-		if (tag_val.get_type() != Variant::DICTIONARY) {
+	for (const KeyValue<Variant, Variant> &tag_kv : p_data) {
+		if (tag_kv.value.get_type() != Variant::DICTIONARY) {
 			continue;
 		}
 
-		Dictionary tag_data = tag_val;
-		Array property_names = tag_data.keys();
-		for (int j = 0; j < property_names.size(); j++) {
-			StringName prop_name = property_names[j];
+		// Validation: Tags and properties unknown to the schema are skipped.
+		HashMap<StringName, uint32_t>::ConstIterator T = schema->tag_map.find(tag_kv.key);
+		if (!T) {
+			continue;
+		}
 
-			// Validation: Check if property exists and matches the tag
-			if (!persistence_map.has(prop_name)) {
+		const Dictionary tag_data = tag_kv.value;
+		for (const KeyValue<Variant, Variant> &prop_kv : tag_data) {
+			HashMap<StringName, uint32_t>::ConstIterator P = schema->property_map.find(prop_kv.key);
+			if (!P) {
 				continue;
 			}
 
-			const PropertyMetadata &meta = persistence_map[prop_name];
-			if (meta.tag != (StringName)tags[i]) {
+			const PersistenceSchema::Property &prop = schema->properties[P->value];
+			if (prop.tag != T->value) {
 				continue;
 			}
 
-			// Type validation: Ensure loaded value matches property type
-			Variant loaded_value = tag_data[prop_name];
-			if (loaded_value.get_type() != meta.type) {
-				// Attempt type conversion for common cases
-				Callable::CallError ce;
-				Variant converted;
-				const Variant *args[] = { &loaded_value };
-				Variant::construct(meta.type, converted, args, 1, ce);
-
-				if (ce.error == Callable::CallError::CALL_OK && converted.get_type() == meta.type) {
-					set(prop_name, converted);
-				} else {
-					ERR_PRINT(vformat("SaveServer: Type mismatch for property '%s'. Expected %s, got %s. Skipping.",
-							prop_name, Variant::get_type_name(meta.type), Variant::get_type_name(loaded_value.get_type())));
-				}
-			} else {
-				set(prop_name, loaded_value);
-			}
+			_restore_persistent_value(this, schema.ptr(), prop, prop_kv.value);
 		}
 	}
 
@@ -851,6 +809,38 @@ void Object::set_persistent_properties(const Dictionary &p_data) {
 	_load_persistence(p_data);
 }
 
+void Object::set_persistent_values(const StringName *p_tags, const StringName *p_properties, const Variant *const *p_values, uint32_t p_count) {
+	notification(NOTIFICATION_PERSISTENCE_LOAD);
+
+	Ref<PersistenceSchema> schema = PersistenceSchema::get_for_object(this);
+	ERR_FAIL_COND(schema.is_null());
+
+	// _load_persistence() gets the same hierarchical data as from set_persistent_properties().
+	Dictionary data;
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (p_properties[i].is_empty()) {
+			data[p_tags[i]] = *p_values[i];
+			continue;
+		}
+
+		HashMap<StringName, uint32_t>::ConstIterator P = schema->property_map.find(p_properties[i]);
+		if (P) {
+			const PersistenceSchema::Property &prop = schema->properties[P->value];
+			if (schema->tags[prop.tag].name == p_tags[i]) {
+				_restore_persistent_value(this, schema.ptr(), prop, *p_values[i]);
+			}
+		}
+
+		if (!data.has(p_tags[i])) {
+			data[p_tags[i]] = Dictionary();
+		}
+		Dictionary tag_data = data[p_tags[i]];
+		tag_data[p_properties[i]] = *p_values[i];
+	}
+
+	_load_persistence(data);
+}
+
 Variant Object::_call_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	if (p_argcount < 1) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
@@ -1069,6 +1059,17 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 	return ret;
 }
 
+Variant Object::callp_cached(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error, CallSiteCache &r_cache) {
+	if (unlikely(script_instance || p_method == CoreStringName(free_))) {
+		// Scripts can define or override the method, and freeing needs its checks.
+		return callp(p_method, p_args, p_argcount, r_error);
+	}
+
+	OBJ_DEBUG_LOCK
+
+	return r_cache.call_method_bind(this, p_method, p_args, p_argcount, r_error);
+}
+
 Variant Object::call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
@@ -1418,9 +1419,11 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
 	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
 	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
+	alignas(CallSiteCache) uint8_t slot_cache_stack[sizeof(CallSiteCache) * MAX_SLOTS_ON_STACK];
 
 	Callable *slot_callables = (Callable *)slot_callable_stack;
 	uint32_t *slot_flags = slot_flags_stack;
+	CallSiteCache *slot_caches = (CallSiteCache *)slot_cache_stack;
 	uint32_t slot_count = 0;
 
 	{
@@ -1440,6 +1443,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
 			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
 			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
+			slot_caches = (CallSiteCache *)memalloc(sizeof(CallSiteCache) * s->slot_map.size());
 		}
 
 		// Ensure that disconnecting the signal or even deleting the object
@@ -1447,6 +1451,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
 			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
 			slot_flags[slot_count] = slot_kv.value.conn.flags;
+			memnew_placement(&slot_caches[slot_count], CallSiteCache(slot_kv.value.call_cache));
 			++slot_count;
 		}
 
@@ -1477,6 +1482,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	bool pending_unref = Object::cast_to<RefCounted>(this) ? ((RefCounted *)this)->reference() : false;
 
 	Error err = OK;
+	bool caches_resolved = false;
 
 	Vector<const Variant *> append_source_mem;
 	Variant source = this;
@@ -1524,7 +1530,9 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			Callable::CallError ce;
 			_emitting = true;
 			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			const uint32_t resolve_count = slot_caches[i].get_resolve_count();
+			callable.callp(args, argc, ret, ce, slot_caches[i]);
+			caches_resolved = caches_resolved || slot_caches[i].get_resolve_count() != resolve_count;
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1548,6 +1556,19 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
+	if (caches_resolved) {
+		// Store what the copies resolved, so the next emission skips the lookups. Slots may be gone by now.
+		OBJ_SIGNAL_LOCK
+
+		SignalData *s = signal_map.getptr(p_name);
+		for (uint32_t i = 0; s && i < slot_count; ++i) {
+			SignalData::Slot *slot = s->slot_map.getptr(slot_callables[i]);
+			if (slot && slot->call_cache.get_resolve_count() != slot_caches[i].get_resolve_count()) {
+				slot->call_cache = slot_caches[i];
+			}
+		}
+	}
+
 	for (uint32_t i = 0; i < slot_count; ++i) {
 		slot_callables[i].~Callable();
 	}
@@ -1555,6 +1576,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	if (slot_callables != (Callable *)slot_callable_stack) {
 		memfree(slot_callables);
 		memfree(slot_flags);
+		memfree(slot_caches);
 	}
 
 	if (pending_unref) {
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/extension/gdextension_interface.gen.h"
+#include "core/object/call_site_cache.h"
 #include "core/object/gdtype.h"
 #include "core/object/message_queue.h"
 #include "core/object/object_id.h"
@@ -497,6 +498,9 @@ public:
 	virtual const GDType &_get_typev() const override {                                                                                     \
 		return get_gdtype_static();                                                                                                         \
 	}                                                                                                                                       \
+	virtual bool _is_callp_overriddenv() const override {                                                                                   \
+		return !std::is_same_v<decltype(&m_class::callp), decltype(&Object::callp)>;                                                        \
+	}                                                                                                                                       \
 	static const GDType &get_gdtype_static() {                                                                                              \
 		static GDType *_class_static;                                                                                                       \
 		if (unlikely(!_class_static)) {                                                                                                     \
@@ -622,6 +626,7 @@ private:
 #ifdef DEBUG_ENABLED
 	friend struct _ObjectDebugLock;
 #endif // DEBUG_ENABLED
+	friend class CallSiteCache;
 	friend bool predelete_handler(Object *);
 	friend void postinitialize_handler(Object *);
 
@@ -633,6 +638,7 @@ private:
 			int reference_count = 0;
 			Connection conn;
 			List<Connection>::Element *cE = nullptr;
+			CallSiteCache call_cache;
 		};
 
 		MethodInfo user;
@@ -786,6 +792,8 @@ protected:
 	Variant _call_deferred_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	virtual const GDType &_get_typev() const { return get_gdtype_static(); }
+	// Whether the class replaces callp(), in which case call site caches can't bypass it.
+	virtual bool _is_callp_overriddenv() const { return false; }
 
 	TypedArray<StringName> _get_meta_list_bind() const;
 	TypedArray<Dictionary> _get_property_list_bind() const;
@@ -913,6 +921,8 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// Same as callp(), but resolves native methods through the caller's cache instead of looking them up in ClassDB.
+	Variant callp_cached(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error, CallSiteCache &r_cache);
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
@@ -1027,6 +1037,10 @@ public:
 	// Persistence
 	Dictionary get_persistent_properties(const Variant &p_tags = Variant()) const;
 	void set_persistent_properties(const Dictionary &p_data);
+	// Columnar variant of set_persistent_properties() used by packed snapshots. An empty property name
+	// means the tag holds a plain value. All values are grouped by tag and handed to _load_persistence(),
+	// as set_persistent_properties() does.
+	void set_persistent_values(const StringName *p_tags, const StringName *p_properties, const Variant *const *p_values, uint32_t p_count);
 
 #ifdef TOOLS_ENABLED
 	virtual void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const;
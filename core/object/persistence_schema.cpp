@@ -0,0 +1,239 @@
+/**************************************************************************/
+/*  persistence_schema.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "persistence_schema.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/script_instance.h"
+#include "core/object/script_language.h"
+#include "core/templates/hash_set.h"
+
+Mutex PersistenceSchema::mutex;
+HashMap<PersistenceSchema::Key, Ref<PersistenceSchema>> PersistenceSchema::cache;
+
+void PersistenceSchema::_compile(const Object *p_object) {
+	List<PropertyInfo> plist;
+	p_object->get_property_list(&plist);
+
+	HashSet<StringName> script_members;
+	ScriptInstance *si = p_object->get_script_instance();
+	if (si) {
+		List<PropertyInfo> script_plist;
+		si->get_property_list(&script_plist);
+		for (const PropertyInfo &E : script_plist) {
+			script_members.insert(E.name);
+		}
+	}
+
+	// What the script declares, as opposed to what this instance reports.
+	HashSet<StringName> declared_members;
+	Ref<Script> script = p_object->get_script();
+	if (script.is_valid()) {
+		dynamic = script->has_method(SNAME("_get_property_list")) || script->has_method(SNAME("_validate_property"));
+		List<PropertyInfo> declared_plist;
+		script->get_script_property_list(&declared_plist);
+		for (const PropertyInfo &E : declared_plist) {
+			declared_members.insert(E.name);
+		}
+	}
+
+	const StringName class_name = p_object->get_class_name();
+	StringName current_tag = SNAME("general");
+
+	for (const PropertyInfo &prop : plist) {
+		// Detect persistence group change.
+		if ((prop.usage & PROPERTY_USAGE_GROUP) && (prop.usage & PROPERTY_USAGE_PERSISTENCE)) {
+			current_tag = prop.name;
+			continue;
+		}
+
+		// Persistence must come from the declarations, or other instances may get another list.
+		if (!dynamic && !(prop.usage & (PROPERTY_USAGE_GROUP | PROPERTY_USAGE_SUBGROUP | PROPERTY_USAGE_CATEGORY))) {
+			if (script_members.has(prop.name)) {
+				dynamic = (prop.usage & PROPERTY_USAGE_PERSISTENCE) && !declared_members.has(prop.name);
+			} else {
+				PropertyInfo registered;
+				if (ClassDB::get_property_info(class_name, prop.name, &registered)) {
+					dynamic = (registered.usage & PROPERTY_USAGE_PERSISTENCE) != (prop.usage & PROPERTY_USAGE_PERSISTENCE);
+				} else {
+					dynamic = (prop.usage & PROPERTY_USAGE_PERSISTENCE) != 0;
+				}
+			}
+		}
+
+		if (!(prop.usage & PROPERTY_USAGE_PERSISTENCE) || property_map.has(prop.name)) {
+			continue;
+		}
+
+		StringName tag_name = prop.hint_string;
+		if (tag_name.is_empty()) {
+			tag_name = current_tag;
+		}
+
+		uint32_t tag_idx;
+		HashMap<StringName, uint32_t>::Iterator T = tag_map.find(tag_name);
+		if (T) {
+			tag_idx = T->value;
+		} else {
+			tag_idx = tags.size();
+			Tag tag;
+			tag.name = tag_name;
+			tags.push_back(tag);
+			tag_map.insert(tag_name, tag_idx);
+		}
+
+		Property p;
+		p.name = prop.name;
+		p.type = prop.type;
+		p.tag = tag_idx;
+		p.script_member = script_members.has(prop.name);
+
+		if (!p.script_member && ClassDB::get_property_index(class_name, prop.name) == -1) {
+			StringName getter = ClassDB::get_property_getter(class_name, prop.name);
+			StringName setter = ClassDB::get_property_setter(class_name, prop.name);
+			if (getter != StringName()) {
+				p.getter = ClassDB::get_method(class_name, getter);
+			}
+			if (setter != StringName()) {
+				p.setter = ClassDB::get_method(class_name, setter);
+			}
+		}
+
+		uint32_t prop_idx = properties.size();
+		properties.push_back(p);
+		property_map.insert(prop.name, prop_idx);
+		tags[tag_idx].properties.push_back(prop_idx);
+	}
+}
+
+Variant PersistenceSchema::get_value(const Object *p_object, const Property &p_property, bool *r_valid) const {
+	if (p_property.getter) {
+		Callable::CallError ce;
+		Variant ret = p_property.getter->call(const_cast<Object *>(p_object), nullptr, 0, ce);
+		if (r_valid) {
+			*r_valid = ce.error == Callable::CallError::CALL_OK;
+		}
+		return ret;
+	}
+
+	if (p_property.script_member) {
+		ScriptInstance *si = p_object->get_script_instance();
+		Variant ret;
+		if (si && si->get(p_property.name, ret)) {
+			if (r_valid) {
+				*r_valid = true;
+			}
+			return ret;
+		}
+	}
+
+	return p_object->get(p_property.name, r_valid);
+}
+
+void PersistenceSchema::set_value(Object *p_object, const Property &p_property, const Variant &p_value) const {
+	if (p_property.setter) {
+		Callable::CallError ce;
+		const Variant *args[1] = { &p_value };
+		p_property.setter->call(p_object, args, 1, ce);
+		if (ce.error == Callable::CallError::CALL_OK) {
+			return;
+		}
+	}
+
+	if (p_property.script_member) {
+		ScriptInstance *si = p_object->get_script_instance();
+		if (si && si->set(p_property.name, p_value)) {
+			return;
+		}
+	}
+
+	p_object->set(p_property.name, p_value);
+}
+
+Ref<PersistenceSchema> PersistenceSchema::get_for_object(const Object *p_object) {
+	ERR_FAIL_NULL_V(p_object, Ref<PersistenceSchema>());
+
+	Ref<Script> script = p_object->get_script();
+	Key key(p_object->get_class_name(), script.is_valid() ? (uint64_t)script->get_instance_id() : 0);
+
+	MutexLock lock(mutex);
+
+	HashMap<Key, Ref<PersistenceSchema>>::Iterator E = cache.find(key);
+	if (E) {
+		return E->value;
+	}
+
+	Ref<PersistenceSchema> schema;
+	schema.instantiate();
+	schema->_compile(p_object);
+	if (!schema->dynamic) {
+		cache.insert(key, schema);
+	}
+	return schema;
+}
+
+void PersistenceSchema::invalidate_script(ObjectID p_script) {
+	MutexLock lock(mutex);
+
+	LocalVector<Key> to_erase;
+	for (const KeyValue<Key, Ref<PersistenceSchema>> &E : cache) {
+		if (E.key.second == (uint64_t)p_script) {
+			to_erase.push_back(E.key);
+		}
+	}
+
+	// Schemas still in use elsewhere are freed by their last reference.
+	for (const Key &key : to_erase) {
+		cache.erase(key);
+	}
+}
+
+void PersistenceSchema::clear_script_cache() {
+	MutexLock lock(mutex);
+
+	// Reloading a base script changes the schema of every script extending it,
+	// so all script-backed entries are dropped together.
+	LocalVector<Key> to_erase;
+	for (const KeyValue<Key, Ref<PersistenceSchema>> &E : cache) {
+		if (E.key.second != 0) {
+			to_erase.push_back(E.key);
+		}
+	}
+
+	for (const Key &key : to_erase) {
+		cache.erase(key);
+	}
+}
+
+void PersistenceSchema::cleanup() {
+	MutexLock lock(mutex);
+	cache.clear();
+}
@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  persistence_schema.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object_id.h"
+#include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/variant/variant.h"
+
+class MethodBind;
+class Object;
+
+// Precompiled view of the PROPERTY_USAGE_PERSISTENCE properties of a class/script pair.
+// Compiling walks the full property list once; capture and restore then become flat
+// array walks with direct MethodBind access for native properties.
+//
+// Objects whose persistent properties don't match what their class and script declare
+// (added or changed by _get_property_list() or _validate_property()) may differ per
+// instance, their schemas are compiled for each call instead of being cached.
+class PersistenceSchema : public RefCounted {
+	GDSOFTCLASS(PersistenceSchema, RefCounted);
+
+public:
+	struct Property {
+		StringName name;
+		Variant::Type type = Variant::NIL;
+		uint32_t tag = 0; // Index into `tags`.
+		MethodBind *getter = nullptr; // Only set for native properties without index.
+		MethodBind *setter = nullptr;
+		bool script_member = false;
+	};
+
+	struct Tag {
+		StringName name;
+		LocalVector<uint32_t> properties; // Indices into `properties`, in declaration order.
+	};
+
+	LocalVector<Property> properties;
+	LocalVector<Tag> tags;
+	HashMap<StringName, uint32_t> tag_map;
+	HashMap<StringName, uint32_t> property_map;
+	bool dynamic = false; // Depends on the instance it was compiled from, not cached.
+
+	_FORCE_INLINE_ bool is_empty() const { return properties.is_empty(); }
+
+	Variant get_value(const Object *p_object, const Property &p_property, bool *r_valid = nullptr) const;
+	void set_value(Object *p_object, const Property &p_property, const Variant &p_value) const;
+
+private:
+	typedef Pair<StringName, uint64_t> Key; // Class name, script ObjectID.
+
+	static Mutex mutex;
+	static HashMap<Key, Ref<PersistenceSchema>> cache;
+
+	void _compile(const Object *p_object);
+
+public:
+	// The returned schema stays usable even if the cache is invalidated meanwhile (e.g. a script
+	// reloaded on another thread), callers just keep working with the previous version.
+	static Ref<PersistenceSchema> get_for_object(const Object *p_object);
+
+	static void invalidate_script(ObjectID p_script);
+	static void clear_script_cache();
+	static void cleanup();
+};
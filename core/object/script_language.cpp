@@ -35,6 +35,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
 #include "core/io/resource_loader.h"
+#include "core/object/persistence_schema.h"
 #include "core/templates/sort_array.h"
 
 ScriptLanguage *ScriptServer::_languages[MAX_LANGUAGES];
@@ -63,6 +64,9 @@ void Script::_notification(int p_what) {
 				callable_mp(this, &Script::_set_debugger_break_language).call_deferred();
 			}
 		} break;
+		case NOTIFICATION_PREDELETE: {
+			PersistenceSchema::invalidate_script(get_instance_id());
+		} break;
 	}
 }
 
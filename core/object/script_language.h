@@ -179,6 +179,8 @@ public:
 	virtual bool is_tool() const = 0;
 	virtual bool is_valid() const = 0;
 	virtual bool is_abstract() const = 0;
+	// If true, processing an instance only touches its node's own subtree, so it's safe to process on a worker thread.
+	virtual bool is_process_thread_safe() const { return false; }
 
 	virtual ScriptLanguage *get_language() const = 0;
 
@@ -30,6 +30,8 @@
 
 #include "script_language_extension.h"
 
+#include "core/object/persistence_schema.h"
+
 void ScriptExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_editor_can_reload_from_file);
 	GDVIRTUAL_BIND(_placeholder_erased, "placeholder");
@@ -86,6 +88,14 @@ void ScriptExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_get_rpc_config);
 }
 
+Error ScriptExtension::reload(bool p_keep_state) {
+	Error ret = OK;
+	GDVIRTUAL_CALL(_reload, p_keep_state, ret);
+	// Member declarations may have changed, drop any compiled persistence schemas.
+	PersistenceSchema::clear_script_cache();
+	return ret;
+}
+
 void ScriptLanguageExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_get_name);
 	GDVIRTUAL_BIND(_init);
@@ -73,7 +73,8 @@ public:
 	EXBIND0RC(bool, has_source_code)
 	EXBIND0RC(String, get_source_code)
 	EXBIND1(set_source_code, const String &)
-	EXBIND1R(Error, reload, bool)
+	GDVIRTUAL1R_REQUIRED(Error, _reload, bool)
+	virtual Error reload(bool p_keep_state) override;
 
 	GDVIRTUAL0RC_REQUIRED(StringName, _get_doc_class_name)
 	GDVIRTUAL0RC_REQUIRED(TypedArray<Dictionary>, _get_documentation)
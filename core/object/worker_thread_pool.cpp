@@ -52,10 +52,11 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 thread_local WorkerThreadPool::UnlockableLocks WorkerThreadPool::unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
+thread_local WorkerThreadPool::ThreadData *WorkerThreadPool::current_thread_data = nullptr;
+
 void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
-	int pool_thread_index = thread_ids[Thread::get_caller_id()];
-	ThreadData &curr_thread = threads[pool_thread_index];
+	ThreadData &curr_thread = *_get_caller_thread_data();
 	Task *prev_task = nullptr; // In case this is recursively called.
 
 	bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
@@ -72,15 +73,17 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		prev_task = curr_thread.current_task;
-		curr_thread.current_task = p_task;
+		// Only this thread writes these, so starting a task doesn't need the lock.
+		prev_task = curr_thread.current_task.load(std::memory_order_relaxed);
+		curr_thread.current_task.store(p_task, std::memory_order_release);
 		curr_thread.has_pump_task = p_task->is_pump_task;
-		if (p_task->pending_notify_yield_over) {
+		p_task->pool_thread_index.set(curr_thread.index);
+		// Pairs with notify_yield_over(): either it finds this thread, or the flag is seen here.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (p_task->pending_notify_yield_over.is_set()) {
+			MutexLock lock(task_mutex);
 			curr_thread.yield_is_over = true;
 		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -125,15 +128,13 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
+		// For groups, tasks get rid of themselves.
+
+		MutexLock data_lock(task_data_mutex);
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			MutexLock task_lock(task_mutex);
 			group_allocator.free(p_task->group);
 		}
-
-		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
 		if (p_task->native_func) {
@@ -145,35 +146,14 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
-			}
-		}
+		_complete_task(p_task);
 	}
 
 #ifdef THREADS_ENABLED
-	{
-		curr_thread.current_task = prev_task;
-		if (low_priority) {
-			low_priority_threads_used--;
-
-			if (_try_promote_low_priority_task()) {
-				if (prev_task) { // Otherwise, this thread will catch it.
-					_notify_threads(&curr_thread, 1, 0);
-				}
-			}
-		}
-
-		task_mutex.unlock();
+	curr_thread.current_task.store(prev_task, std::memory_order_release);
+	if (low_priority) {
+		// If not nested, this thread will catch a promoted task anyway.
+		_release_low_priority_slot(&curr_thread, prev_task != nullptr);
 	}
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
@@ -181,13 +161,40 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+void WorkerThreadPool::_complete_task(Task *p_task) {
+	p_task->pool_thread_index.set(-1);
+	uint32_t prev_state = p_task->state.bit_or(Task::STATE_COMPLETED);
+	if (!(prev_state & Task::STATE_WAITING_MASK)) {
+		// Nobody awaiting. Later awaiters will find it completed and the task must not be touched anymore.
+		return;
+	}
+
+	// Awaiters only get rid of the task under the lock, so it's still valid here.
+	MutexLock lock(task_mutex);
+	uint32_t waiting_user = prev_state & Task::STATE_WAITING_USER_MASK;
+	if (waiting_user) {
+		p_task->done_semaphore.post(waiting_user);
+	}
+	if ((prev_state & Task::STATE_WAITING_MASK) >= Task::STATE_WAITING_POOL) {
+		// Let awaiters know.
+		for (uint32_t i = 0; i < threads.size(); i++) {
+			if (threads[i].awaited_task == p_task) {
+				threads[i].cond_var.notify_one();
+				threads[i].signaled = true;
+			}
+		}
+	}
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	current_thread_data = thread_data;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks in the deques don't need the pool lock to be picked up.
+		Task *task_to_process = thread_data->pool->_pop_or_steal_task(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -200,17 +207,28 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
+				}
+
+				// Posting only takes the lock to wake up idle threads, so announce this one before
+				// checking the deques a last time. Either the poster sees it, or its task is found here.
+				thread_data->pool->idle_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = thread_data->pool->_pop_or_steal_task(thread_data);
+				if (!task_to_process) {
 					// There wasn't a task available yet.
 					// Let's wait for the next notification, then recheck.
 					thread_data->cond_var.wait(lock);
-					continue;
 				}
+				thread_data->pool->idle_threads.decrement();
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				if (task_to_process) {
+					break;
+				}
 			}
 		}
 
@@ -219,7 +237,7 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
-void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task) {
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, bool p_pump_task) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
 	// in custom builds.
@@ -227,41 +245,92 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	// Avoid calling pump tasks or low priority tasks from the calling thread.
 	bool process_on_calling_thread = threads.is_empty() && !p_pump_task;
 	if (process_on_calling_thread) {
-		p_lock.temp_unlock();
 		for (uint32_t i = 0; i < p_count; i++) {
 			_process_task(p_tasks[i]);
 		}
-		p_lock.temp_relock();
 		return;
 	}
 
+	ThreadData *caller_pool_thread = _get_caller_thread_data();
+
+	// Tasks go to a deque where threads steal them from without the lock: the local one of
+	// the poster if it's a pool thread (fan-out from within tasks), the injected one otherwise.
+	// Only when threads are idle is the lock taken, to wake them up. Pump tasks keep going
+	// through the shared queue, as waiting threads must be able to skip them.
+	uint32_t handed_off = 0;
+	bool slot_acquired = false; // Whether the first task left already got a low priority slot.
+	if (!p_pump_task && runlevel.load(std::memory_order_acquire) == RUNLEVEL_NORMAL) {
+		for (; handed_off < p_count; handed_off++) {
+			Task *task = p_tasks[handed_off];
+			task->low_priority = !p_high_priority;
+			if (!p_high_priority && !_try_acquire_low_priority_slot()) {
+				break;
+			}
+			if (!_push_stealable_task(caller_pool_thread, task)) {
+				slot_acquired = !p_high_priority;
+				break; // Full, the rest goes to the shared queue.
+			}
+		}
+
+		// Pairs with the idle announcement in the threads waiting for tasks.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (handed_off == p_count && idle_threads.get() == 0) {
+			// Threads busy with other tasks will find these once done.
+			return;
+		}
+	}
+
+	MutexLock lock(task_mutex);
+
 	while (runlevel == RUNLEVEL_EXIT_LANGUAGES) {
-		control_cond_var.wait(p_lock);
+		control_cond_var.wait(lock);
 	}
 
-	uint32_t to_process = 0;
+	uint32_t to_process = handed_off;
 	uint32_t to_promote = 0;
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-
-	for (uint32_t i = 0; i < p_count; i++) {
+	for (uint32_t i = handed_off; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority || (i == handed_off && slot_acquired) || _try_acquire_low_priority_slot()) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
-			if (!p_high_priority) {
-				low_priority_threads_used++;
-			}
 			to_process++;
 		} else {
 			// Too many threads using low priority, must go to queue.
 			low_priority_task_queue.add_last(&p_tasks[i]->task_elem);
+			low_priority_tasks_queued.increment();
 			to_promote++;
 		}
 	}
 
+	if (to_promote) {
+		// A slot may have been released by a thread that didn't see these queued yet.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while (_try_promote_low_priority_task(false)) {
+			to_process++;
+			if (to_promote) {
+				to_promote--;
+			}
+		}
+	}
+
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
+bool WorkerThreadPool::_push_stealable_task(ThreadData *p_caller_pool_thread, Task *p_task) {
+	if (p_caller_pool_thread) {
+		if (!p_caller_pool_thread->local_tasks.push(p_task)) {
+			return false;
+		}
+	} else {
+		MutexLock lock(injected_tasks_mutex);
+		if (!injected_tasks.push(p_task)) {
+			return false;
+		}
+	}
+	stealable_tasks.increment();
+	return true;
+}
+
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
 	uint32_t to_process = p_process_count;
 	uint32_t to_promote = p_promote_count;
@@ -286,9 +355,11 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		Task *current_task = th.current_task.load(std::memory_order_acquire);
+		if (current_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			// Only dereferenced if awaiting, as the task can't complete meanwhile then.
+			if (to_promote && th.awaited_task && current_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -326,16 +397,82 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
-bool WorkerThreadPool::_try_promote_low_priority_task() {
-	if (low_priority_task_queue.first()) {
-		Task *low_prio_task = low_priority_task_queue.first()->self();
-		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
-		low_priority_threads_used++;
-		return true;
-	} else {
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_task(ThreadData *p_thread_data) {
+	if (stealable_tasks.get() <= 0) {
+		return nullptr;
+	}
+
+	// Own tasks first, newest first as they are the most likely to be hot in cache.
+	Task *task = p_thread_data->local_tasks.pop();
+
+	if (!task) {
+		// Then the ones posted from outside the pool, oldest first.
+		task = injected_tasks.steal();
+	}
+
+	if (!task) {
+		// Steal from the other threads, starting at a random one to spread contention.
+		uint32_t thread_count = steal_thread_count.get();
+		uint32_t seed = p_thread_data->steal_seed;
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		p_thread_data->steal_seed = seed;
+
+		for (uint32_t i = 0; i < thread_count && !task; i++) {
+			ThreadData &victim = threads[(seed + i) % thread_count];
+			if (&victim != p_thread_data) {
+				task = victim.local_tasks.steal();
+			}
+		}
+	}
+
+	if (task) {
+		stealable_tasks.decrement();
+	}
+	return task;
+}
+
+bool WorkerThreadPool::_try_acquire_low_priority_slot() {
+	uint32_t used = low_priority_threads_used.load(std::memory_order_relaxed);
+	while (used < max_low_priority_threads) {
+		if (low_priority_threads_used.compare_exchange_weak(used, used + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkerThreadPool::_release_low_priority_slot(const ThreadData *p_current_thread_data, bool p_notify) {
+	low_priority_threads_used.fetch_sub(1, std::memory_order_seq_cst);
+	// Pairs with the recheck in _post_tasks(): either the slot is seen free there, or the queued tasks here.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!low_priority_tasks_queued.get()) {
+		return;
+	}
+
+	MutexLock lock(task_mutex);
+	if (_try_promote_low_priority_task(false) && p_notify) {
+		_notify_threads(p_current_thread_data, 1, 0);
+	}
+}
+
+// Must be called with task_mutex locked.
+bool WorkerThreadPool::_try_promote_low_priority_task(bool p_over_limit) {
+	if (!low_priority_task_queue.first()) {
+		return false;
+	}
+	if (p_over_limit) {
+		low_priority_threads_used.fetch_add(1, std::memory_order_seq_cst);
+	} else if (!_try_acquire_low_priority_slot()) {
 		return false;
 	}
+
+	Task *low_prio_task = low_priority_task_queue.first()->self();
+	low_priority_task_queue.remove(low_priority_task_queue.first());
+	low_priority_tasks_queued.decrement();
+	task_queue.add_last(&low_prio_task->task_elem);
+	return true;
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
@@ -343,22 +480,27 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
-	MutexLock<BinaryMutex> lock(task_mutex);
-
-	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	task->is_pump_task = p_pump_task;
-	tasks.insert(id, task);
+	Task *task = nullptr;
+	TaskID id;
+	{
+		MutexLock data_lock(task_data_mutex);
+
+		// Get a free task
+		task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		task->is_pump_task = p_pump_task;
+		tasks.insert(id, task);
+	}
 
 #ifdef THREADS_ENABLED
 	if (p_pump_task) {
+		MutexLock lock(task_mutex);
 		pump_task_count++;
 		int thread_count = get_thread_count();
 		if (pump_task_count >= thread_count) {
@@ -369,13 +511,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 			threads.resize_initialized(thread_count + 1);
 			threads[thread_count].index = thread_count;
 			threads[thread_count].pool = this;
+			threads[thread_count].steal_seed = thread_count * 0x9E3779B9u + 1;
+			steal_thread_count.set(thread_count + 1);
 			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
-			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
 		}
 	}
 #endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	_post_tasks(&task, 1, p_high_priority, p_pump_task);
 
 	return id;
 }
@@ -389,35 +532,37 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 }
 
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
-	MutexLock task_lock(task_mutex);
+	MutexLock data_lock(task_data_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
 		ERR_FAIL_V_MSG(false, "Invalid Task ID"); // Invalid task
 	}
 
-	return (*taskp)->completed;
+	return (*taskp)->state.get() & Task::STATE_COMPLETED;
 }
 
 Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
-	task_mutex.lock();
+	ThreadData *caller_pool_thread = _get_caller_thread_data();
+	uint32_t waiter = caller_pool_thread ? Task::STATE_WAITING_POOL : Task::STATE_WAITING_USER;
+
+	task_data_mutex.lock();
 	Task **taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
-		task_mutex.unlock();
+		task_data_mutex.unlock();
 		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Invalid Task ID"); // Invalid task
 	}
 	Task *task = *taskp;
 
-	if (task->completed) {
-		if (task->waiting_pool == 0 && task->waiting_user == 0) {
+	if (task->state.get() & Task::STATE_COMPLETED) {
+		if (task->state.get() == Task::STATE_COMPLETED) {
 			tasks.erase(p_task_id);
 			task_allocator.free(task);
 		}
-		task_mutex.unlock();
+		task_data_mutex.unlock();
 		return OK;
 	}
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load(std::memory_order_relaxed)->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -429,37 +574,34 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		// Taking into account there's no feasible solution for every possible case
 		// with the current design, we just simply reject attempts to await on older tasks,
 		// with a specific error code that signals the situation so the caller can handle it.
-		task_mutex.unlock();
+		task_data_mutex.unlock();
 		return ERR_BUSY;
 	}
 
-	if (caller_pool_thread) {
-		task->waiting_pool++;
-	} else {
-		task->waiting_user++;
+	if (task->state.postadd(waiter) & Task::STATE_COMPLETED) {
+		// Completed in the meantime, without counting on this awaiter.
+		if (task->state.sub(waiter) == Task::STATE_COMPLETED) {
+			tasks.erase(p_task_id);
+			task_allocator.free(task);
+		}
+		task_data_mutex.unlock();
+		return OK;
 	}
+	task_data_mutex.unlock();
 
 	if (caller_pool_thread) {
-		task_mutex.unlock();
 		_wait_collaboratively(caller_pool_thread, task);
-		task_mutex.lock();
-		task->waiting_pool--;
-		if (task->waiting_pool == 0 && task->waiting_user == 0) {
-			tasks.erase(p_task_id);
-			task_allocator.free(task);
-		}
 	} else {
-		task_mutex.unlock();
 		task->done_semaphore.wait();
-		task_mutex.lock();
-		task->waiting_user--;
-		if (task->waiting_pool == 0 && task->waiting_user == 0) {
-			tasks.erase(p_task_id);
-			task_allocator.free(task);
-		}
 	}
 
-	task_mutex.unlock();
+	// Completing a task with awaiters happens under task_mutex, so this ensures it's over.
+	MutexLock lock(task_mutex);
+	MutexLock data_lock(task_data_mutex);
+	if (task->state.sub(waiter) == Task::STATE_COMPLETED) {
+		tasks.erase(p_task_id);
+		task_allocator.free(task);
+	}
 	return OK;
 }
 
@@ -489,7 +631,13 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 	while (true) {
 		Task *task_to_process = nullptr;
 		bool relock_unlockables = false;
-		{
+
+		if (p_task != ThreadData::YIELDING && !(p_task->state.get() & Task::STATE_COMPLETED)) {
+			// Most likely the tasks this thread is waiting for, posted to its own deque.
+			task_to_process = _pop_or_steal_task(p_caller_pool_thread);
+		}
+
+		if (!task_to_process) {
 			MutexLock lock(task_mutex);
 
 			bool was_signaled = p_caller_pool_thread->signaled;
@@ -507,7 +655,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					wait_is_over = true;
 				}
 			} else {
-				if (p_task->completed) {
+				if (p_task->state.get() & Task::STATE_COMPLETED) {
 					wait_is_over = true;
 				}
 			}
@@ -516,8 +664,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
-					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || stealable_tasks.get() > 0) ? 1 : 0;
+					uint32_t to_promote = p_caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
 						p_caller_pool_thread->signaled = true;
@@ -528,8 +676,9 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				break;
 			}
 
-			if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
-				if (_try_promote_low_priority_task()) {
+			if (p_caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && low_priority_task_queue.first()) {
+				// This thread's slot is idle while waiting, so the limit doesn't apply.
+				if (_try_promote_low_priority_task(true)) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				}
 			}
@@ -545,16 +694,23 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 			}
 
 			if (!task_to_process) {
-				p_caller_pool_thread->awaited_task = p_task;
-
-				if (this == singleton) {
-					_unlock_unlockable_mutexes();
-				}
-				relock_unlockables = true;
+				// See _thread_function().
+				idle_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = _pop_or_steal_task(p_caller_pool_thread);
+				if (!task_to_process) {
+					p_caller_pool_thread->awaited_task = p_task;
+
+					if (this == singleton) {
+						_unlock_unlockable_mutexes();
+					}
+					relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+					p_caller_pool_thread->cond_var.wait(lock);
 
-				p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_task = nullptr;
+				}
+				idle_threads.decrement();
 			}
 		}
 
@@ -587,7 +743,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && stealable_tasks.get() <= 0) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -631,20 +787,22 @@ void WorkerThreadPool::yield() {
 
 void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	MutexLock task_lock(task_mutex);
+	MutexLock data_lock(task_data_mutex);
 	Task **taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
 		ERR_FAIL_MSG("Invalid Task ID.");
 	}
 	Task *task = *taskp;
-	if (task->pool_thread_index == -1) { // Completed or not started yet.
-		if (!task->completed) {
-			// This avoids a race condition where a task is created and yield-over called before it's processed.
-			task->pending_notify_yield_over = true;
-		}
+	// This avoids a race condition where a task is created and yield-over called before it's processed.
+	// Tasks start without the lock, so the flag is set before checking, see _process_task().
+	task->pending_notify_yield_over.set();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int pool_thread_index = task->pool_thread_index.get();
+	if (pool_thread_index == -1) { // Completed or not started yet.
 		return;
 	}
 
-	ThreadData &td = threads[task->pool_thread_index];
+	ThreadData &td = threads[pool_thread_index];
 	td.yield_is_over = true;
 	td.signaled = true;
 	td.cond_var.notify_one();
@@ -656,7 +814,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = MAX(1u, threads.size());
 	}
 
-	MutexLock<BinaryMutex> lock(task_mutex);
+	task_data_mutex.lock();
 
 	Group *group = group_allocator.alloc();
 	GroupID id = last_task++;
@@ -692,7 +850,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	task_data_mutex.unlock();
+
+	_post_tasks(tasks_posted, p_tasks, p_high_priority, false);
 
 	return id;
 }
@@ -706,7 +866,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 }
 
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
-	MutexLock task_lock(task_mutex);
+	MutexLock data_lock(task_data_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
 	if (!groupp) {
 		ERR_FAIL_V_MSG(0, "Invalid Group ID");
@@ -714,7 +874,7 @@ uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) co
 	return (*groupp)->completed_index.get();
 }
 bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
-	MutexLock task_lock(task_mutex);
+	MutexLock data_lock(task_data_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
 	if (!groupp) {
 		ERR_FAIL_V_MSG(false, "Invalid Group ID");
@@ -724,9 +884,9 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
-	task_mutex.lock();
+	task_data_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
-	task_mutex.unlock();
+	task_data_mutex.unlock();
 	if (!groupp) {
 		ERR_FAIL_MSG("Invalid Group ID.");
 	}
@@ -747,34 +907,218 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
-			MutexLock task_lock(task_mutex);
+			MutexLock data_lock(task_data_mutex);
 			group_allocator.free(group);
 		}
 	}
 
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+	MutexLock data_lock(task_data_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
 	groups.erase(p_group);
 #endif
 }
 
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description) {
+	if (unlikely(running)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(-1, "Can't add nodes to a task graph while it's running.");
+	}
+
+	Node *node = memnew(Node);
+	node->graph = this;
+	node->callable = p_callable;
+	node->native_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->template_userdata = p_template_userdata;
+	node->description = p_description;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_node(Callable(), p_func, p_userdata, nullptr, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_node(const Callable &p_action, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, p_description);
+}
+
+void WorkerThreadPool::TaskGraph::add_dependency(NodeID p_node, NodeID p_predecessor) {
+	ERR_FAIL_COND_MSG(running, "Can't change a task graph while it's running.");
+	ERR_FAIL_INDEX(p_node, (int)nodes.size());
+	ERR_FAIL_INDEX(p_predecessor, (int)nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_predecessor, "A task graph node can't depend on itself.");
+
+	Node *predecessor = nodes[p_predecessor];
+	if (predecessor->successors.has(p_node)) {
+		return;
+	}
+	predecessor->successors.push_back(p_node);
+	nodes[p_node]->predecessor_count++;
+}
+
+void WorkerThreadPool::TaskGraph::_post_node(Node *p_node) {
+	// Read by wait() only after a predecessor completed (or run() returned), so it's safe to set late.
+	p_node->task_id = pool->add_native_task(&TaskGraph::_process_node, p_node, high_priority, p_node->description);
+}
+
+void WorkerThreadPool::TaskGraph::_process_node(void *p_node) {
+	Node *node = (Node *)p_node;
+	TaskGraph *graph = node->graph;
+
+	node->timing.thread_index = graph->pool->get_thread_index();
+	node->timing.start_usec = OS::get_singleton()->get_ticks_usec();
+
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else if (node->template_userdata) {
+		node->template_userdata->callback();
+	} else {
+		node->callable.call();
+	}
+
+	node->timing.end_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Post the continuations this node was the last predecessor of.
+	for (NodeID id : node->successors) {
+		Node *successor = graph->nodes[id];
+		if (successor->pending_predecessors.decrement() == 0) {
+			graph->_post_node(successor);
+		}
+	}
+}
+
+Error WorkerThreadPool::TaskGraph::run(bool p_high_priority) {
+	ERR_FAIL_COND_V_MSG(running, ERR_BUSY, "Task graph is already running, wait() for it first.");
+	if (!pool) {
+		pool = WorkerThreadPool::get_singleton();
+	}
+	ERR_FAIL_NULL_V(pool, ERR_UNCONFIGURED);
+
+	// Topological order (Kahn), which also rejects cycles before anything is posted.
+	order.clear();
+	order.reserve(nodes.size());
+	LocalVector<uint32_t> in_degree;
+	in_degree.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		in_degree[i] = nodes[i]->predecessor_count;
+		if (in_degree[i] == 0) {
+			order.push_back(i);
+		}
+	}
+	for (uint32_t i = 0; i < order.size(); i++) {
+		for (NodeID id : nodes[order[i]]->successors) {
+			if (--in_degree[id] == 0) {
+				order.push_back(id);
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(order.size() != nodes.size(), ERR_CYCLIC_LINK, "Task graph has a dependency cycle.");
+
+	high_priority = p_high_priority;
+	running = true;
+
+	for (Node *node : nodes) {
+		node->pending_predecessors.set(node->predecessor_count);
+		node->task_id = INVALID_TASK_ID;
+		node->timing = NodeTiming();
+	}
+
+	// Collect the roots first, as posting them may already complete other nodes.
+	LocalVector<Node *> roots;
+	for (Node *node : nodes) {
+		if (node->predecessor_count == 0) {
+			roots.push_back(node);
+		}
+	}
+	for (Node *root : roots) {
+		_post_node(root);
+	}
+
+	return OK;
+}
+
+void WorkerThreadPool::TaskGraph::wait() {
+	ERR_FAIL_COND_MSG(!running, "Task graph is not running.");
+
+	// In topological order, every predecessor of a node is done (so the node was posted)
+	// by the time it's waited for. Waiting on the tasks lets pool threads help meanwhile.
+	for (NodeID id : order) {
+		pool->wait_for_task_completion(nodes[id]->task_id);
+	}
+
+	running = false;
+}
+
+const String &WorkerThreadPool::TaskGraph::get_node_description(NodeID p_node) const {
+	CRASH_BAD_INDEX(p_node, (int)nodes.size());
+	return nodes[p_node]->description;
+}
+
+WorkerThreadPool::TaskGraph::NodeTiming WorkerThreadPool::TaskGraph::get_node_timing(NodeID p_node) const {
+	ERR_FAIL_INDEX_V(p_node, (int)nodes.size(), NodeTiming());
+	ERR_FAIL_COND_V_MSG(running, NodeTiming(), "Task graph timings are only available once waited for.");
+	return nodes[p_node]->timing;
+}
+
+uint64_t WorkerThreadPool::TaskGraph::get_elapsed_usec() const {
+	ERR_FAIL_COND_V_MSG(running, 0, "Task graph timings are only available once waited for.");
+	if (nodes.is_empty()) {
+		return 0;
+	}
+
+	uint64_t start = UINT64_MAX;
+	uint64_t end = 0;
+	for (const Node *node : nodes) {
+		start = MIN(start, node->timing.start_usec);
+		end = MAX(end, node->timing.end_usec);
+	}
+	return end > start ? end - start : 0;
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	if (running) {
+		wait();
+	}
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+	nodes.clear();
+	order.clear();
+}
+
+WorkerThreadPool::TaskGraph::TaskGraph(WorkerThreadPool *p_pool) {
+	pool = p_pool;
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	clear();
+}
+
 int WorkerThreadPool::get_thread_index() const {
-	Thread::ID tid = Thread::get_caller_id();
-	return thread_ids.has(tid) ? thread_ids[tid] : -1;
+	const ThreadData *thread_data = _get_caller_thread_data();
+	return thread_data ? (int)thread_data->index : -1;
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
-	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task) {
-		return threads[th_index].current_task->self;
+	const ThreadData *thread_data = _get_caller_thread_data();
+	const Task *current_task = thread_data ? thread_data->current_task.load(std::memory_order_relaxed) : nullptr;
+	if (current_task) {
+		return current_task->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::get_caller_group_id() const {
-	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task && threads[th_index].current_task->group) {
-		return threads[th_index].current_task->group->self;
+	const ThreadData *thread_data = _get_caller_thread_data();
+	const Task *current_task = thread_data ? thread_data->current_task.load(std::memory_order_relaxed) : nullptr;
+	if (current_task && current_task->group) {
+		return current_task->group->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -825,12 +1169,13 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	threads.reserve(5);
 #endif
 	threads.resize(p_thread_count);
+	steal_thread_count.set(threads.size());
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
 		threads[i].pool = this;
+		threads[i].steal_seed = i * 0x9E3779B9u + 1; // Any non-zero seed.
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
-		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
 }
 
@@ -875,7 +1220,7 @@ void WorkerThreadPool::finish() {
 	}
 
 	{
-		MutexLock lock(task_mutex);
+		MutexLock data_lock(task_data_mutex);
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
@@ -40,6 +40,7 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -72,6 +73,14 @@ private:
 	};
 
 	struct Task {
+		// Completion and the count of awaiters share a single atomic, so completing a task
+		// nobody awaits doesn't need any lock.
+		static constexpr uint32_t STATE_COMPLETED = 1u << 31;
+		static constexpr uint32_t STATE_WAITING_POOL = 1u << 16; // Pool threads awaiting, in bits 16-30.
+		static constexpr uint32_t STATE_WAITING_USER = 1; // User threads awaiting, in bits 0-15.
+		static constexpr uint32_t STATE_WAITING_USER_MASK = STATE_WAITING_POOL - 1;
+		static constexpr uint32_t STATE_WAITING_MASK = STATE_COMPLETED - 1;
+
 		TaskID self = -1;
 		Callable callable;
 		void (*native_func)(void *) = nullptr;
@@ -79,22 +88,17 @@ private:
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore; // For user threads awaiting.
-		bool completed : 1;
-		bool pending_notify_yield_over : 1;
-		bool is_pump_task : 1;
+		SafeNumeric<uint32_t> state;
+		SafeFlag pending_notify_yield_over;
+		bool is_pump_task = false;
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
-		uint32_t waiting_pool = 0;
-		uint32_t waiting_user = 0;
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
-		int pool_thread_index = -1;
+		SafeNumeric<int32_t> pool_thread_index{ -1 };
 
 		void free_template_userdata();
 		Task() :
-				completed(false),
-				pending_notify_yield_over(false),
-				is_pump_task(false),
 				task_elem(this) {}
 	};
 
@@ -107,7 +111,8 @@ private:
 	SelfList<Task>::List low_priority_task_queue;
 	SelfList<Task>::List task_queue;
 
-	BinaryMutex task_mutex;
+	BinaryMutex task_mutex; // Scheduling: shared queues, thread states and notifications.
+	BinaryMutex task_data_mutex; // Allocators and ID maps. Taken after task_mutex when both are needed.
 
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
@@ -118,18 +123,20 @@ private:
 		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
-		bool has_pump_task : 1; // Threads can only have one pump task.
-		Task *current_task = nullptr;
+		bool has_pump_task = false; // Threads can only have one pump task. Only accessed by this thread.
+		std::atomic<Task *> current_task = nullptr; // Only written by this thread.
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		uint32_t steal_seed = 0;
+		// High priority tasks posted from this thread. Other threads steal from it.
+		WorkStealingDeque<Task> local_tasks;
 
 		ThreadData() :
 				signaled(false),
 				yield_is_over(false),
 				pre_exited_languages(false),
-				exited_languages(false),
-				has_pump_task(false) {}
+				exited_languages(false) {}
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -138,7 +145,8 @@ private:
 		RUNLEVEL_PRE_EXIT_LANGUAGES, // Block adding new tasks
 		RUNLEVEL_EXIT_LANGUAGES, // All threads detach from scripting threads.
 		RUNLEVEL_EXIT,
-	} runlevel = RUNLEVEL_NORMAL;
+	};
+	std::atomic<Runlevel> runlevel = RUNLEVEL_NORMAL; // Changed under task_mutex, posting peeks at it without.
 	union { // Cleared on every runlevel change.
 		struct {
 			uint32_t num_idle_threads;
@@ -149,7 +157,6 @@ private:
 	} runlevel_data;
 	ConditionVariable control_cond_var;
 
-	HashMap<Thread::ID, int> thread_ids;
 	HashMap<
 			TaskID,
 			Task *,
@@ -165,8 +172,19 @@ private:
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
 
+	// Tasks posted from outside the pool. Posters are serialized by their own mutex, pool threads steal without it.
+	BinaryMutex injected_tasks_mutex;
+	WorkStealingDeque<Task, 1024> injected_tasks;
+
+	// Tasks sitting in the deques. Incremented after pushing, so it may briefly be negative.
+	SafeNumeric<int64_t> stealable_tasks;
+	// Threads sleeping or about to. Posting only takes task_mutex if there are any to wake up.
+	SafeNumeric<uint32_t> idle_threads;
+	SafeNumeric<uint32_t> steal_thread_count; // Grows with the threads spawned for pump tasks.
+
 	uint32_t max_low_priority_threads = 0;
-	uint32_t low_priority_threads_used = 0;
+	std::atomic<uint32_t> low_priority_threads_used = 0;
+	SafeNumeric<uint32_t> low_priority_tasks_queued; // Size of low_priority_task_queue, readable without the lock.
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
 
 	uint64_t last_task = 1;
@@ -174,14 +192,25 @@ private:
 
 	static HashMap<StringName, WorkerThreadPool *> named_pools;
 
+	static thread_local ThreadData *current_thread_data;
+
 	static void _thread_function(void *p_user);
 
+	_FORCE_INLINE_ ThreadData *_get_caller_thread_data() const {
+		return current_thread_data && current_thread_data->pool == this ? current_thread_data : nullptr;
+	}
+
 	void _process_task(Task *task);
+	void _complete_task(Task *p_task);
 
-	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
+	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, bool p_pump_task);
+	bool _push_stealable_task(ThreadData *p_caller_pool_thread, Task *p_task);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
-	bool _try_promote_low_priority_task();
+	bool _try_acquire_low_priority_slot();
+	void _release_low_priority_slot(const ThreadData *p_current_thread_data, bool p_notify);
+	bool _try_promote_low_priority_task(bool p_over_limit);
+	Task *_pop_or_steal_task(ThreadData *p_thread_data);
 
 	static WorkerThreadPool *singleton;
 
@@ -267,6 +296,81 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Dependency graph of tasks. Each node is posted to the pool as soon as all its
+	// predecessors are done, so independent branches run concurrently instead of being
+	// serialized by waits on the calling thread.
+	// Build it with the add_*_node() and add_dependency() methods, then run() and wait().
+	// A graph can be run again once waited for, node timings are available in between.
+	class TaskGraph {
+	public:
+		typedef int32_t NodeID;
+
+		struct NodeTiming {
+			uint64_t start_usec = 0;
+			uint64_t end_usec = 0;
+			int thread_index = -1; // -1 if not run on a pool thread.
+		};
+
+	private:
+		struct Node {
+			TaskGraph *graph = nullptr;
+			void (*native_func)(void *) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			Callable callable;
+			String description;
+
+			LocalVector<NodeID> successors;
+			uint32_t predecessor_count = 0;
+			SafeNumeric<uint32_t> pending_predecessors;
+
+			TaskID task_id = INVALID_TASK_ID;
+			NodeTiming timing;
+		};
+
+		WorkerThreadPool *pool = nullptr;
+		LocalVector<Node *> nodes;
+		LocalVector<NodeID> order; // Topological, computed by run().
+		bool high_priority = true;
+		bool running = false;
+
+		NodeID _add_node(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description);
+		void _post_node(Node *p_node);
+		static void _process_node(void *p_node);
+
+	public:
+		template <typename C, typename M, typename U>
+		NodeID add_template_node(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(Callable(), nullptr, nullptr, ud, p_description);
+		}
+		NodeID add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+		NodeID add_node(const Callable &p_action, const String &p_description = String());
+
+		// `p_node` won't start before `p_predecessor` is done.
+		void add_dependency(NodeID p_node, NodeID p_predecessor);
+		// `p_continuation` starts after `p_node` (and its other predecessors) are done.
+		void add_continuation(NodeID p_node, NodeID p_continuation) { add_dependency(p_continuation, p_node); }
+
+		Error run(bool p_high_priority = true);
+		void wait();
+		bool is_running() const { return running; }
+
+		int get_node_count() const { return nodes.size(); }
+		const String &get_node_description(NodeID p_node) const;
+		NodeTiming get_node_timing(NodeID p_node) const;
+		uint64_t get_elapsed_usec() const; // From the first node start to the last node end.
+
+		void clear();
+
+		TaskGraph(WorkerThreadPool *p_pool = nullptr); // Uses the main pool by default.
+		~TaskGraph();
+	};
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
@@ -0,0 +1,255 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant.h"
+
+thread_local FrameArena::ThreadArena FrameArena::arena;
+
+static SafeNumeric<uint32_t> arena_owner_counter;
+
+static _FORCE_INLINE_ uint64_t _align_arena_size(uint64_t p_bytes) {
+	return (p_bytes + 15) & ~uint64_t(15);
+}
+
+void FrameArena::ThreadArena::release_chunks() {
+	while (chunk) {
+		Chunk *prev = chunk->prev;
+		Memory::free_static(chunk, false);
+		chunk = prev;
+	}
+	offset = 0;
+	used_in_previous_chunks = 0;
+	last = nullptr;
+}
+
+FrameArena::Header *FrameArena::_alloc_header(uint64_t p_bytes) {
+	ThreadArena &a = arena;
+	uint64_t needed = sizeof(Header) + _align_arena_size(p_bytes);
+	if (unlikely(!a.chunk || a.offset + needed > a.chunk->size)) {
+		uint64_t size = MAX(DEFAULT_CHUNK_SIZE, next_power_of_2(needed));
+		if (a.chunk) {
+			size = MAX(size, a.chunk->size * 2);
+			a.used_in_previous_chunks += a.offset;
+		}
+		Chunk *chunk = static_cast<Chunk *>(Memory::alloc_static(sizeof(Chunk) + size, false));
+		CRASH_COND_MSG(!chunk, "Out of memory");
+		chunk->prev = a.chunk;
+		chunk->size = size;
+		a.chunk = chunk;
+		a.offset = 0;
+	}
+
+	Header *header = reinterpret_cast<Header *>(_chunk_data(a.chunk) + a.offset);
+	header->size = p_bytes;
+	header->frame = a.frame;
+	header->owner = a.owner;
+	a.offset += needed;
+	a.last = header;
+	a.live++;
+	return header;
+}
+
+bool FrameArena::_is_arena_pointer(const void *p_ptr) {
+	const uint8_t *ptr = static_cast<const uint8_t *>(p_ptr);
+	for (Chunk *chunk = arena.chunk; chunk; chunk = chunk->prev) {
+		const uint8_t *data = _chunk_data(chunk);
+		if (ptr >= data && ptr < data + chunk->size) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FrameArena::_check_owned(const Header *p_header, const char *p_operation) {
+	const ThreadArena &a = arena;
+	ERR_FAIL_COND_V_MSG(p_header->frame != a.frame || !a.active, false, vformat("Pointer passed to FrameArena::%s() escaped its frame (allocated in frame %d, current frame is %d).", p_operation, p_header->frame, a.frame));
+	return true;
+}
+
+void FrameArena::_activate() {
+	ThreadArena &a = arena;
+	if (a.owner == HEAP_OWNER) {
+		a.owner = arena_owner_counter.increment();
+		if (unlikely(a.owner == HEAP_OWNER)) {
+			a.owner = arena_owner_counter.increment();
+		}
+	}
+	a.active = true;
+}
+
+void FrameArena::_end_frame() {
+	ThreadArena &a = arena;
+
+#ifdef DEBUG_ENABLED
+	a.escaped = a.live;
+	if (a.live > 0) {
+		WARN_PRINT_ONCE(vformat("%d FrameArena allocation(s) were still alive at the end of frame %d. Frame-allocated memory must not be kept across frames.", a.live, a.frame));
+	}
+	// Poison the discarded memory so escaped pointers are caught by the checks above instead of reading stale data.
+	for (Chunk *chunk = a.chunk; chunk; chunk = chunk->prev) {
+		memset(_chunk_data(chunk), 0xdd, chunk == a.chunk ? a.offset : chunk->size);
+	}
+#endif
+
+	// The last frame needed more than one chunk, replace them with a single one big enough for all.
+	// Escaped pointers keep the old chunks alive, so they are still recognized as arena pointers.
+	if (a.chunk && a.chunk->prev && a.live == 0) {
+		uint64_t capacity = get_capacity();
+		a.release_chunks();
+		Chunk *chunk = static_cast<Chunk *>(Memory::alloc_static(sizeof(Chunk) + capacity, false));
+		CRASH_COND_MSG(!chunk, "Out of memory");
+		chunk->prev = nullptr;
+		chunk->size = capacity;
+		a.chunk = chunk;
+	}
+
+	a.offset = 0;
+	a.used_in_previous_chunks = 0;
+	a.last = nullptr;
+	a.live = 0;
+	a.frame++;
+}
+
+FrameArena::Scope::Scope() {
+	if (arena.active) {
+		return;
+	}
+	_activate();
+	owns_frame = true;
+}
+
+FrameArena::Scope::~Scope() {
+	if (owns_frame) {
+		_end_frame();
+		arena.active = false;
+	}
+}
+
+void FrameArena::begin_frame() {
+	if (arena.active) {
+		_end_frame();
+	}
+	_activate();
+}
+
+void FrameArena::disable() {
+	ThreadArena &a = arena;
+	a.release_chunks();
+	a.active = false;
+	a.live = 0;
+	a.escaped = 0;
+	a.frame++;
+}
+
+uint64_t FrameArena::get_capacity() {
+	uint64_t capacity = 0;
+	for (const Chunk *chunk = arena.chunk; chunk; chunk = chunk->prev) {
+		capacity += chunk->size;
+	}
+	return capacity;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	if (unlikely(!is_active())) {
+		Header *header = static_cast<Header *>(Memory::alloc_static(sizeof(Header) + p_bytes, false));
+		ERR_FAIL_NULL_V(header, nullptr);
+		header->size = p_bytes;
+		header->frame = 0;
+		header->owner = HEAP_OWNER;
+		return header + 1;
+	}
+	return _alloc_header(p_bytes) + 1;
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	Header *header = static_cast<Header *>(p_ptr) - 1;
+	if (!_is_arena_pointer(p_ptr)) {
+		CRASH_COND_MSG(header->owner != HEAP_OWNER, "Can't grow a FrameArena allocation from another thread.");
+		header = static_cast<Header *>(Memory::realloc_static(header, sizeof(Header) + p_bytes, false));
+		ERR_FAIL_NULL_V(header, nullptr);
+		header->size = p_bytes;
+		return header + 1;
+	}
+
+	if (unlikely(!_check_owned(header, "realloc"))) {
+		// The old contents may already be reused, there is nothing sane to copy from.
+		CRASH_NOW_MSG("Can't grow a FrameArena allocation from another frame.");
+	}
+
+	ThreadArena &a = arena;
+	if (header == a.last) {
+		// Grow (or shrink) in place when it's the most recent allocation.
+		uint64_t start = reinterpret_cast<uint8_t *>(header) - _chunk_data(a.chunk);
+		uint64_t needed = sizeof(Header) + _align_arena_size(p_bytes);
+		if (start + needed <= a.chunk->size) {
+			header->size = p_bytes;
+			a.offset = start + needed;
+			return p_ptr;
+		}
+	}
+
+	Header *new_header = _alloc_header(p_bytes);
+	memcpy(new_header + 1, p_ptr, MIN(header->size, (uint64_t)p_bytes));
+	a.live--;
+	return new_header + 1;
+}
+
+void FrameArena::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+
+	Header *header = static_cast<Header *>(p_ptr) - 1;
+	if (!_is_arena_pointer(p_ptr)) {
+		ERR_FAIL_COND_MSG(header->owner != HEAP_OWNER, "Pointer passed to FrameArena::free() doesn't belong to the calling thread's arena.");
+		Memory::free_static(header, false);
+		return;
+	}
+
+	if (unlikely(!_check_owned(header, "free"))) {
+		return;
+	}
+
+	ThreadArena &a = arena;
+	a.live--;
+	if (header == a.last) {
+		// Give the space back, so scoped temporaries don't accumulate within a frame.
+		a.offset = reinterpret_cast<uint8_t *>(header) - _chunk_data(a.chunk);
+		a.last = nullptr;
+	}
+}
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Thread-local bump allocator for temporaries that don't outlive the current frame.
+//
+// Each thread owns its own arena, so allocating never takes a lock or touches
+// the global memory counters. A thread opts in by calling begin_frame() at its
+// frame boundary (Main::iteration does it for the main thread). Everything
+// allocated since the previous call is discarded at that point, so pointers
+// must not be kept across frames. On threads without an active frame,
+// allocations fall back to the regular heap, which keeps containers using the
+// arena safe to create anywhere.
+//
+// WorkerThreadPool threads run other tasks while they wait, so a task must not
+// keep the arena enabled across a wait. Those use FrameArena::Scope around work
+// that doesn't yield instead.
+//
+// Freeing the most recent allocation gives its space back, and growing it is
+// done in place when possible. Pointers are told apart by address: anything
+// inside the calling thread's chunks is an arena allocation, anything else
+// must come from the heap fallback. Freeing or growing a pointer from a
+// previous frame or from another thread's arena is reported as an error. In
+// debug builds, discarded memory is poisoned and allocations still alive when
+// the frame ends are counted as escaped.
+class FrameArena {
+public:
+	static constexpr uint64_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+private:
+	static constexpr uint32_t ALIGNMENT = 16;
+	static constexpr uint32_t HEAP_OWNER = 0;
+
+	struct Header {
+		uint64_t size;
+		uint32_t frame;
+		uint32_t owner;
+	};
+	static_assert(sizeof(Header) == ALIGNMENT);
+
+	struct Chunk {
+		Chunk *prev = nullptr;
+		uint64_t size = 0;
+	};
+	static_assert(sizeof(Chunk) == ALIGNMENT);
+
+	struct ThreadArena {
+		Chunk *chunk = nullptr;
+		uint64_t offset = 0;
+		uint64_t used_in_previous_chunks = 0;
+		Header *last = nullptr;
+		uint32_t owner = HEAP_OWNER;
+		uint32_t frame = 0;
+		uint32_t live = 0;
+		uint32_t escaped = 0;
+		bool active = false;
+
+		void release_chunks();
+		~ThreadArena() { release_chunks(); }
+	};
+
+	static thread_local ThreadArena arena;
+
+	static _FORCE_INLINE_ uint8_t *_chunk_data(Chunk *p_chunk) { return reinterpret_cast<uint8_t *>(p_chunk + 1); }
+	static Header *_alloc_header(uint64_t p_bytes);
+	static bool _is_arena_pointer(const void *p_ptr);
+	static bool _check_owned(const Header *p_header, const char *p_operation);
+	static void _activate();
+	static void _end_frame();
+
+public:
+	// Enables the calling thread's arena for as long as it lives, and discards
+	// what was allocated from it on exit. The chunks are kept for the next scope.
+	// If the thread already has an active frame, the scope allocates from it.
+	class Scope {
+		bool owns_frame = false;
+
+	public:
+		Scope();
+		~Scope();
+	};
+
+	// Discards the calling thread's allocations from the previous frame and enables its arena.
+	static void begin_frame();
+	// Frees the calling thread's memory and makes it fall back to the heap again.
+	static void disable();
+
+	static bool is_active() { return arena.active; }
+	static uint32_t get_frame() { return arena.frame; }
+	static uint64_t get_used_bytes() { return arena.used_in_previous_chunks + arena.offset; }
+	static uint64_t get_capacity();
+	// Arena allocations of the current frame that haven't been freed yet.
+	static uint32_t get_live_allocations() { return arena.live; }
+	// Allocations that were still alive when the last frame ended (only tracked in debug builds).
+	static uint32_t get_escaped_allocations() { return arena.escaped; }
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+};
+
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		p_allocation->~T();
+		FrameArena::free(p_allocation);
+	}
+};
+
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArena>;
+
+// Only the elements live in the arena, the bucket arrays are still heap allocated.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>>;
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  small_object_pool.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_pool.h"
+
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+thread_local SmallObjectPool::ThreadCache SmallObjectPool::cache;
+// Trivially destructible, so it can still be read after the cache is gone at thread exit.
+static thread_local bool cache_destroyed = false;
+
+namespace {
+
+struct GlobalSizeClass {
+	SpinLock lock;
+	void *batches = nullptr; // Chained through FreeBlock::next_batch.
+	LocalVector<void *> slabs;
+};
+
+struct GlobalPool {
+	GlobalSizeClass classes[SmallObjectPool::CLASS_COUNT];
+	SafeNumeric<uint64_t> slabs_allocated;
+	SafeNumeric<uint64_t> bytes_reserved;
+	SafeNumeric<uint64_t> batches_fetched;
+	SafeNumeric<uint64_t> batches_returned;
+};
+
+GlobalPool &get_global_pool() {
+	// Never destroyed: containers held by other statics may still be freed during static destruction.
+	alignas(GlobalPool) static uint8_t storage[sizeof(GlobalPool)];
+	static GlobalPool *pool = memnew_placement(storage, GlobalPool);
+	return *pool;
+}
+
+} // namespace
+
+SmallObjectPool::ThreadCache::~ThreadCache() {
+	// Hand everything back, so blocks freed on short-lived threads aren't lost.
+	for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+		while (blocks[i]) {
+			FreeBlock *batch = blocks[i];
+			FreeBlock *tail = batch;
+			for (uint32_t j = 1; j < BATCH_SIZE && tail->next; j++) {
+				tail = tail->next;
+			}
+			blocks[i] = tail->next;
+			tail->next = nullptr;
+			_return_batch(i, batch);
+		}
+		counts[i] = 0;
+	}
+	cache_destroyed = true;
+}
+
+SmallObjectPool::FreeBlock *SmallObjectPool::_fetch_batch(uint32_t p_class) {
+	GlobalPool &pool = get_global_pool();
+	GlobalSizeClass &size_class = pool.classes[p_class];
+
+	size_class.lock.lock();
+	FreeBlock *batch = static_cast<FreeBlock *>(size_class.batches);
+	if (batch) {
+		size_class.batches = batch->next_batch;
+		size_class.lock.unlock();
+		pool.batches_fetched.increment();
+		return batch;
+	}
+	size_class.lock.unlock();
+
+	// Nothing to reuse, carve a new batch out of a fresh slab.
+	const uint32_t block_size = (p_class + 1) * GRANULARITY;
+	uint8_t *slab = static_cast<uint8_t *>(Memory::alloc_static(block_size * BATCH_SIZE, false));
+	CRASH_COND_MSG(!slab, "Out of memory");
+	for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+		FreeBlock *block = reinterpret_cast<FreeBlock *>(slab + i * block_size);
+		block->next = i + 1 < BATCH_SIZE ? reinterpret_cast<FreeBlock *>(slab + (i + 1) * block_size) : nullptr;
+	}
+
+	size_class.lock.lock();
+	size_class.slabs.push_back(slab);
+	size_class.lock.unlock();
+	pool.slabs_allocated.increment();
+	pool.bytes_reserved.add(block_size * BATCH_SIZE);
+	return reinterpret_cast<FreeBlock *>(slab);
+}
+
+void SmallObjectPool::_return_batch(uint32_t p_class, FreeBlock *p_batch) {
+	GlobalPool &pool = get_global_pool();
+	GlobalSizeClass &size_class = pool.classes[p_class];
+
+	size_class.lock.lock();
+	p_batch->next_batch = static_cast<FreeBlock *>(size_class.batches);
+	size_class.batches = p_batch;
+	size_class.lock.unlock();
+	pool.batches_returned.increment();
+}
+
+void *SmallObjectPool::alloc(size_t p_size) {
+	if (unlikely(p_size > MAX_SIZE)) {
+		return Memory::alloc_static(p_size, false);
+	}
+
+	const uint32_t size_class = _get_class(p_size);
+	if (unlikely(cache_destroyed)) {
+		// Past thread exit (e.g. static destructors), bypass the cache.
+		FreeBlock *block = _fetch_batch(size_class);
+		if (block->next) {
+			_return_batch(size_class, block->next);
+		}
+		return block;
+	}
+
+	ThreadCache &c = cache;
+	FreeBlock *block = c.blocks[size_class];
+	if (unlikely(!block)) {
+		block = _fetch_batch(size_class);
+		uint32_t count = 0;
+		for (FreeBlock *b = block; b; b = b->next) {
+			count++;
+		}
+		c.counts[size_class] = count;
+	}
+
+	c.blocks[size_class] = block->next;
+	c.counts[size_class]--;
+	return block;
+}
+
+void SmallObjectPool::free(void *p_ptr, size_t p_size) {
+	if (unlikely(p_size > MAX_SIZE)) {
+		Memory::free_static(p_ptr, false);
+		return;
+	}
+
+	const uint32_t size_class = _get_class(p_size);
+	FreeBlock *block = static_cast<FreeBlock *>(p_ptr);
+	if (unlikely(cache_destroyed)) {
+		// Past thread exit (e.g. static destructors), hand the block straight to the global pool.
+		block->next = nullptr;
+		_return_batch(size_class, block);
+		return;
+	}
+
+	ThreadCache &c = cache;
+	block->next = c.blocks[size_class];
+	c.blocks[size_class] = block;
+	c.counts[size_class]++;
+
+	if (unlikely(c.counts[size_class] > THREAD_CACHE_LIMIT)) {
+		// Give a batch back, so a thread that only frees (e.g. a consumer of objects made elsewhere) doesn't hoard memory.
+		FreeBlock *tail = block;
+		for (uint32_t i = 1; i < BATCH_SIZE; i++) {
+			tail = tail->next;
+		}
+		c.blocks[size_class] = tail->next;
+		c.counts[size_class] -= BATCH_SIZE;
+		tail->next = nullptr;
+		_return_batch(size_class, block);
+	}
+}
+
+SmallObjectPool::Stats SmallObjectPool::get_stats() {
+	GlobalPool &pool = get_global_pool();
+	Stats stats;
+	stats.slabs_allocated = pool.slabs_allocated.get();
+	stats.bytes_reserved = pool.bytes_reserved.get();
+	stats.batches_fetched = pool.batches_fetched.get();
+	stats.batches_returned = pool.batches_returned.get();
+	return stats;
+}
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  small_object_pool.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+
+// Size-class pool for small, frequently created objects (such as the private
+// data of Dictionary and Array and their HashMap elements).
+//
+// Sizes are rounded up to 16-byte classes. Each thread keeps a cache of free
+// blocks per class, so most allocations and frees touch no shared state at
+// all. Caches exchange blocks with a global pool in batches, and the global
+// pool carves new batches out of heap slabs. Blocks can be freed from any
+// thread, and sizes above MAX_SIZE go straight to the heap. Once a thread's
+// cache has been flushed at thread exit, its later allocations and frees (such
+// as those from static destructors) go to the global pool directly.
+//
+// Slabs are never returned to the system: freed blocks are kept for reuse, so
+// the memory held by each size class stays at its high-water mark (the most
+// blocks ever live at once, rounded up to whole batches). Batches mix blocks
+// from many slabs, so releasing a slab would need per-slab tracking on every
+// free. Stats::bytes_reserved reports how much the pool is holding.
+class SmallObjectPool {
+public:
+	static constexpr uint32_t GRANULARITY = 16;
+	static constexpr uint32_t MAX_SIZE = 256;
+	static constexpr uint32_t CLASS_COUNT = MAX_SIZE / GRANULARITY;
+	static constexpr uint32_t BATCH_SIZE = 32;
+	static constexpr uint32_t THREAD_CACHE_LIMIT = BATCH_SIZE * 4;
+
+	struct Stats {
+		uint64_t slabs_allocated = 0; // Heap allocations made by the pool.
+		uint64_t bytes_reserved = 0; // Total size of those slabs, none of it is released.
+		uint64_t batches_fetched = 0; // Thread caches refilled from the global pool.
+		uint64_t batches_returned = 0; // Thread caches overflowing into the global pool.
+	};
+
+private:
+	struct FreeBlock {
+		FreeBlock *next = nullptr;
+		FreeBlock *next_batch = nullptr;
+	};
+
+	struct ThreadCache {
+		FreeBlock *blocks[CLASS_COUNT] = {};
+		uint32_t counts[CLASS_COUNT] = {};
+
+		~ThreadCache();
+	};
+
+	static thread_local ThreadCache cache;
+
+	static _FORCE_INLINE_ uint32_t _get_class(size_t p_size) { return (uint32_t)((p_size + GRANULARITY - 1) / GRANULARITY) - 1; }
+	static FreeBlock *_fetch_batch(uint32_t p_class);
+	static void _return_batch(uint32_t p_class, FreeBlock *p_batch);
+
+public:
+	static void *alloc(size_t p_size);
+	static void free(void *p_ptr, size_t p_size);
+
+	static Stats get_stats();
+};
+
+// HashMap element allocator drawing from SmallObjectPool.
+template <typename T>
+class SmallObjectTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(SmallObjectPool::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		p_allocation->~T();
+		SmallObjectPool::free(p_allocation, sizeof(T));
+	}
+};
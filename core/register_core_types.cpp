@@ -72,6 +72,7 @@
 #include "core/math/random_number_generator.h"
 #include "core/math/triangle_mesh.h"
 #include "core/object/class_db.h"
+#include "core/object/persistence_schema.h"
 #include "core/object/script_backtrace.h"
 #include "core/object/script_language_extension.h"
 #include "core/object/undo_redo.h"
@@ -352,6 +353,8 @@ void register_core_settings() {
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "network/limits/packet_peer_stream/max_buffer_po2", PROPERTY_HINT_RANGE, "8,64,1,or_greater"), (16));
 	GLOBAL_DEF(PropertyInfo(Variant::STRING, "network/tls/certificate_bundle_override", PROPERTY_HINT_FILE, "*.crt"), "");
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/command_queue/lock_free_ring_size_kb", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/resource_loader/prefetch_budget_mb", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 128);
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
 }
@@ -478,6 +481,7 @@ void unregister_core_types() {
 
 	ResourceLoader::finalize();
 
+	PersistenceSchema::cleanup();
 	ClassDB::cleanup_defaults();
 	memdelete(_time);
 	ObjectDB::cleanup();
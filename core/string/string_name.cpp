@@ -39,9 +39,26 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
+	// Buckets are split across independently locked shards, so threads interning
+	// different names rarely wait on each other. A bucket always belongs to the
+	// shard selected by its low bits.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_COUNT - 1;
+	constexpr static uint32_t SHARD_PAGE_SIZE = 256;
+
+	struct alignas(64) Shard {
+		BinaryMutex mutex;
+		PagedAllocator<_Data> allocator;
+
+		Shard() :
+				allocator(SHARD_PAGE_SIZE) {}
+	};
+
 	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	static inline Shard shards[SHARD_COUNT];
+
+	static _FORCE_INLINE_ Shard &get_shard(uint32_t p_idx) { return shards[p_idx & SHARD_MASK]; }
 };
 
 void StringName::setup() {
@@ -53,7 +70,9 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (Table::Shard &shard : Table::shards) {
+		shard.mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -97,20 +116,27 @@ void StringName::cleanup() {
 			}
 
 			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			Table::get_shard(i).allocator.free(d);
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (Table::Shard &shard : Table::shards) {
+		shard.mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
+	// Only the last reference touches the table, and only locks the shard holding it.
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		Table::Shard &shard = Table::get_shard(idx);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -118,14 +144,13 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
 			Table::table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
-		Table::allocator.free(_data);
+		shard.allocator.free(_data);
 	}
 
 	_data = nullptr;
@@ -213,7 +238,8 @@ StringName::StringName(const char *p_name, bool p_static) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Shard &shard = Table::get_shard(idx);
+	MutexLock lock(shard.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -237,7 +263,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = shard.allocator.alloc();
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
@@ -270,7 +296,8 @@ StringName::StringName(const String &p_name, bool p_static) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Shard &shard = Table::get_shard(idx);
+	MutexLock lock(shard.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -293,7 +320,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = shard.allocator.alloc();
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
@@ -33,6 +33,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
@@ -106,6 +107,8 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	// Past this, command_mem is shrunk back after a flush instead of keeping its peak size.
+	static const uint32_t MAX_RETAINED_COMMAND_MEM_SIZE_KB = 1024;
 
 	inline static thread_local bool flushing = false;
 
@@ -115,10 +118,179 @@ class CommandQueueMT {
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
 	uint64_t flush_read_ptr = 0;
 	std::atomic<bool> pending{ false };
 
+	/***** RING *******/
+
+	// Lock-free mode (see set_ring_size()): commands are constructed in place in a fixed
+	// ring by any number of producers and run from there by a single consumer at a time.
+	// Producers reserve space with a CAS and publish each record by storing its size last,
+	// the consumer releases the space it ran through in batches. The mutex is only used
+	// by producers waiting for sync commands.
+	struct RingRecord {
+		std::atomic<uint32_t> size; // Whole record, header included. Zero until published.
+		uint32_t flags;
+		std::atomic<bool> *done; // Set once run, for sync commands.
+	};
+	static_assert(sizeof(RingRecord) == 16);
+
+	enum {
+		RECORD_FLAG_PADDING = 1, // Fills the end of the ring, the next record starts at offset 0.
+	};
+
+	static const uint32_t RING_RELEASE_BATCH = 4096;
+
+	uint8_t *ring = nullptr;
+	uint64_t ring_mask = 0;
+	std::atomic<uint64_t> ring_write{ 0 }; // Next position to reserve (monotonic).
+	std::atomic<uint64_t> ring_read{ 0 }; // Space before this is free for producers.
+	std::atomic<bool> ring_consuming{ false };
+
+	template <typename T, typename... Args>
+	_FORCE_INLINE_ void _push_ring(std::atomic<bool> *p_done, Args &&...p_args) {
+		// Records are 16 bytes aligned, so even the smallest padding fits a header.
+		constexpr uint64_t alloc_size = ((sizeof(T) + 16U - 1U) & ~(16U - 1U)) + sizeof(RingRecord);
+		const uint64_t capacity = ring_mask + 1;
+
+		// Reserve space, padding the end of the ring if the record doesn't fit before it.
+		uint64_t pos = ring_write.load(std::memory_order_relaxed);
+		uint64_t padding;
+		while (true) {
+			uint64_t offset = pos & ring_mask;
+			padding = offset + alloc_size > capacity ? capacity - offset : 0;
+			if (pos + padding + alloc_size - ring_read.load(std::memory_order_acquire) > capacity) {
+				// Full, wait for the consumer to catch up.
+				_wait_for_ring_space();
+				pos = ring_write.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (ring_write.compare_exchange_weak(pos, pos + padding + alloc_size, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+
+		if (padding) {
+			RingRecord *pad = reinterpret_cast<RingRecord *>(&ring[pos & ring_mask]);
+			pad->flags = RECORD_FLAG_PADDING;
+			pad->done = nullptr;
+			pad->size.store(padding, std::memory_order_seq_cst);
+			pos += padding;
+		}
+
+		RingRecord *record = reinterpret_cast<RingRecord *>(&ring[pos & ring_mask]);
+		memnew_placement(record + 1, T(std::forward<Args>(p_args)...));
+		record->flags = 0;
+		record->done = p_done;
+		record->size.store(alloc_size, std::memory_order_seq_cst);
+
+		// Only the first publish after the consumer went idle needs to wake it.
+		if (!pending.exchange(true, std::memory_order_seq_cst)) {
+			WorkerThreadPool::TaskID pump_task = pump_task_id.load(std::memory_order_relaxed);
+			if (pump_task != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(pump_task);
+			}
+		}
+	}
+
+	void _wait_for_ring_space() {
+		// A command pushing more commands than the ring holds while it's being run can't make progress.
+		CRASH_COND_MSG(flushing, "CommandQueueMT ring is full while flushing it. Increase its size.");
+#ifdef THREADS_ENABLED
+		Thread::yield();
+#endif
+	}
+
+	void _flush_ring() {
+		// Safeguard against nested flushes from within commands.
+		if (flushing) {
+			return;
+		}
+
+		bool expected = false;
+		if (!ring_consuming.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+			// Another thread is flushing.
+			sync();
+			return;
+		}
+
+		flushing = true;
+
+		uint64_t read = ring_read.load(std::memory_order_relaxed);
+		uint64_t released = read;
+
+		while (true) {
+			RingRecord *record = reinterpret_cast<RingRecord *>(&ring[read & ring_mask]);
+			uint32_t size = record->size.load(std::memory_order_seq_cst);
+			if (size == 0) {
+				// Caught up. Go idle, then look again in case a producer published in between
+				// and saw the queue still pending (so it didn't wake anybody).
+				pending.store(false, std::memory_order_seq_cst);
+				if (record->size.load(std::memory_order_seq_cst) == 0) {
+					break;
+				}
+				pending.store(true, std::memory_order_relaxed);
+				continue;
+			}
+
+			if (!(record->flags & RECORD_FLAG_PADDING)) {
+				// Commands are run in place, the ring never moves.
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(record + 1);
+				std::atomic<bool> *done = record->done;
+				cmd->call();
+				cmd->~CommandBase();
+
+				if (unlikely(done)) {
+					MutexLock lock(mutex);
+					done->store(true, std::memory_order_release);
+					sync_cond_var.notify_all();
+				}
+			}
+
+			read += size;
+			if (read - released >= RING_RELEASE_BATCH) {
+				_release_ring(released, read);
+				released = read;
+			}
+		}
+
+		_release_ring(released, read);
+
+		flushing = false;
+		ring_consuming.store(false, std::memory_order_release);
+	}
+
+	_FORCE_INLINE_ void _release_ring(uint64_t p_from, uint64_t p_to) {
+		if (p_from == p_to) {
+			return;
+		}
+		// Headers must read as unpublished when producers reuse the space, wherever they land.
+		uint64_t from = p_from & ring_mask;
+		uint64_t to = p_to & ring_mask;
+		if (from < to) {
+			memset(&ring[from], 0, to - from);
+		} else {
+			memset(&ring[from], 0, ring_mask + 1 - from);
+			memset(ring, 0, to);
+		}
+		ring_read.store(p_to, std::memory_order_release);
+	}
+
+	template <typename T, bool NeedsSync, typename... Args>
+	_FORCE_INLINE_ void _push_ring_internal(Args &&...args) {
+		if constexpr (NeedsSync) {
+			std::atomic<bool> done{ false };
+			_push_ring<T>(&done, std::forward<Args>(args)...);
+			MutexLock lock(mutex);
+			while (!done.load(std::memory_order_acquire)) {
+				sync_cond_var.wait(lock);
+			}
+		} else {
+			_push_ring<T>(nullptr, std::forward<Args>(args)...);
+		}
+	}
+
 	template <typename T, typename... Args>
 	_FORCE_INLINE_ void create_command(Args &&...p_args) {
 		// alloc size is size+T+safeguard
@@ -135,11 +307,17 @@ class CommandQueueMT {
 
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
+		if (ring) {
+			_push_ring_internal<T, NeedsSync>(std::forward<Args>(args)...);
+			return;
+		}
+
 		MutexLock mlock(mutex);
 		create_command<T>(std::forward<Args>(args)...);
 
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
+		WorkerThreadPool::TaskID pump_task = pump_task_id.load(std::memory_order_relaxed);
+		if (pump_task != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task);
 		}
 
 		if constexpr (NeedsSync) {
@@ -158,6 +336,11 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
+		if (ring) {
+			_flush_ring();
+			return;
+		}
+
 		// Safeguard against trying to re-lock the binary mutex.
 		if (flushing) {
 			return;
@@ -204,7 +387,13 @@ class CommandQueueMT {
 			flush_read_ptr += size;
 		}
 
-		command_mem.clear();
+		if (unlikely(command_mem.get_capacity() > MAX_RETAINED_COMMAND_MEM_SIZE_KB * 1024)) {
+			// Don't hold on to the memory of a one-off burst.
+			command_mem.reset();
+			command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+		} else {
+			command_mem.clear();
+		}
 		pending.store(false);
 		flush_read_ptr = 0;
 
@@ -265,8 +454,9 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		WorkerThreadPool::TaskID pump_task = pump_task_id.load();
+		ERR_FAIL_COND(pump_task == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task);
 		_flush();
 	}
 
@@ -275,7 +465,37 @@ public:
 		pump_task_id = p_task_id;
 	}
 
+	// Switches to the lock-free ring mode, with a ring of the given size (rounded up to a
+	// power of 2). Zero goes back to the mutex mode. Must be called while the queue is empty
+	// and before other threads use it.
+	void set_ring_size(uint32_t p_size_kb) {
+		ERR_FAIL_COND_MSG(pending.load(), "Can't change the mode of a CommandQueueMT with pending commands.");
+		if (ring) {
+			memfree(ring);
+			ring = nullptr;
+			ring_mask = 0;
+		}
+		ring_write.store(0);
+		ring_read.store(0);
+		if (p_size_kb == 0) {
+			return;
+		}
+
+		uint64_t size = next_power_of_2(MAX(p_size_kb, 4u) * 1024u);
+		ring = (uint8_t *)memalloc(size);
+		memset(ring, 0, size);
+		ring_mask = size - 1;
+	}
+
+	bool is_lock_free() const { return ring != nullptr; }
+
 	CommandQueueMT() {
 		command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
 	}
+
+	~CommandQueueMT() {
+		if (ring) {
+			memfree(ring);
+		}
+	}
 };
@@ -37,6 +37,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, String);
 #include "container_type_validate.h"
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
+#include "core/os/small_object_pool.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
@@ -80,7 +81,8 @@ void Array::_unref() const {
 		if (_p->read_only) {
 			memdelete(_p->read_only);
 		}
-		memdelete(_p);
+		_p->~ArrayPrivate();
+		SmallObjectPool::free(_p, sizeof(ArrayPrivate));
 	}
 	_p = nullptr;
 }
@@ -872,7 +874,7 @@ const void *Array::id() const {
 }
 
 Array::Array(const Array &p_from, uint32_t p_type, const StringName &p_class_name, const Variant &p_script) {
-	_p = memnew(ArrayPrivate);
+	_p = memnew_placement(SmallObjectPool::alloc(sizeof(ArrayPrivate)), ArrayPrivate);
 	_p->refcount.init();
 	set_typed(p_type, p_class_name, p_script);
 	assign(p_from);
@@ -955,13 +957,13 @@ Array::Array(const Array &p_from) {
 }
 
 Array::Array(std::initializer_list<Variant> p_init) {
-	_p = memnew(ArrayPrivate);
+	_p = memnew_placement(SmallObjectPool::alloc(sizeof(ArrayPrivate)), ArrayPrivate);
 	_p->refcount.init();
 	_p->array = Vector<Variant>(p_init);
 }
 
 Array::Array() {
-	_p = memnew(ArrayPrivate);
+	_p = memnew_placement(SmallObjectPool::alloc(sizeof(ArrayPrivate)), ArrayPrivate);
 	_p->refcount.init();
 }
 
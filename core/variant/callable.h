@@ -36,6 +36,7 @@
 class Array;
 class Object;
 class Variant;
+class CallSiteCache;
 class CallableCustom;
 
 // This is an abstraction of things that can be called.
@@ -71,6 +72,8 @@ public:
 	template <typename... VarArgs>
 	Variant call(VarArgs... p_args) const;
 	void callp(const Variant **p_arguments, int p_argcount, Variant &r_return_value, CallError &r_call_error) const;
+	// For call sites invoking the same callable repeatedly, see CallSiteCache.
+	void callp(const Variant **p_arguments, int p_argcount, Variant &r_return_value, CallError &r_call_error, CallSiteCache &r_cache) const;
 	void call_deferredp(const Variant **p_arguments, int p_argcount) const;
 	Variant callv(const Array &p_arguments) const;
 
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/small_object_pool.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
@@ -50,7 +51,9 @@ class Dictionary {
 	void _unref() const;
 
 public:
-	using ConstIterator = HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator;
+	// Elements come from SmallObjectPool, since most dictionaries are small and short-lived.
+	using VariantMap = HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator, SmallObjectTypedAllocator<HashMapElement<Variant, Variant>>>;
+	using ConstIterator = VariantMap::ConstIterator;
 
 	ConstIterator begin() const;
 	ConstIterator end() const;
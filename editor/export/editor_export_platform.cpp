@@ -38,7 +38,7 @@
 #include "core/io/delta_encoding.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PackedData::compress_entry
 #include "core/io/image.h"
 #include "core/io/image_loader.h"
 #include "core/io/resource_uid.h"
@@ -310,12 +310,23 @@ Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_pre
 	sd.ofs = (pd->use_sparse_pck) ? 0 : pd->f->get_position();
 	sd.size = p_data.size();
 	sd.delta = p_delta;
-	Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
+
+	Vector<uint8_t> stored_data = p_data;
+	int compression = GLOBAL_GET("editor/export/pck_compression");
+	if (compression > 0) {
+		Vector<uint8_t> compressed_data = PackedData::compress_entry(p_data, Compression::Mode(compression - 1));
+		if (!compressed_data.is_empty()) {
+			stored_data = compressed_data;
+			sd.compressed = true;
+		}
+	}
+
+	Error err = _encrypt_and_store_data(ftmp, simplified_path, stored_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
 	if (err != OK) {
 		return err;
 	}
 	if (!pd->use_sparse_pck) {
-		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)stored_data.size(), ERR_FILE_CANT_WRITE);
 	}
 
 	if (!pd->use_sparse_pck) {
@@ -1961,7 +1972,8 @@ Dictionary EditorExportPlatform::_save_zip_patch(const Ref<EditorExportPreset> &
 
 bool EditorExportPlatform::_store_header(Ref<FileAccess> p_fd, bool p_enc, bool p_sparse, uint64_t &r_file_base_ofs, uint64_t &r_dir_base_ofs) {
 	p_fd->store_32(PACK_HEADER_MAGIC);
-	p_fd->store_32(PACK_FORMAT_VERSION);
+	// Raised by _update_pack_version() if any entry ends up compressed, so other packs stay readable by older versions.
+	p_fd->store_32(PACK_FORMAT_VERSION_V3);
 	p_fd->store_32(GODOT_VERSION_MAJOR);
 	p_fd->store_32(GODOT_VERSION_MINOR);
 	p_fd->store_32(GODOT_VERSION_PATCH);
@@ -1988,6 +2000,18 @@ bool EditorExportPlatform::_store_header(Ref<FileAccess> p_fd, bool p_enc, bool
 	return true;
 }
 
+void EditorExportPlatform::_update_pack_version(Ref<FileAccess> p_fd, const PackData &p_pack_data, uint64_t p_pck_start) {
+	for (const SavedData &sd : p_pack_data.file_ofs) {
+		if (sd.compressed) {
+			uint64_t pos = p_fd->get_position();
+			p_fd->seek(p_pck_start + 4);
+			p_fd->store_32(PACK_FORMAT_VERSION);
+			p_fd->seek(pos);
+			return;
+		}
+	}
+}
+
 bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, PackData &p_pack_data, const Vector<uint8_t> &p_key, uint64_t p_seed, uint64_t p_file_base) {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = p_fd;
@@ -2051,6 +2075,9 @@ bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, Pa
 		if (p_pack_data.file_ofs[i].delta) {
 			flags |= PACK_FILE_DELTA;
 		}
+		if (p_pack_data.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -2187,6 +2214,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		add_message(EXPORT_MESSAGE_ERROR, TTR("Save PCK"), TTR("Can't create encrypted file."));
 		return ERR_CANT_CREATE;
 	}
+	_update_pack_version(f, pd, pck_start_pos);
 
 	if (p_embed) {
 		// Ensure embedded data ends at a 64-bit multiple.
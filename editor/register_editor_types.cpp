@@ -296,6 +296,7 @@ void register_editor_types() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/import/atlas_max_width", PROPERTY_HINT_RANGE, "128,8192,1,or_greater"), 2048);
 
 	GLOBAL_DEF("editor/export/convert_text_resources_to_binary", true);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/export/pck_compression", PROPERTY_HINT_ENUM, "Disabled,FastLZ,Deflate,Zstandard"), 0);
 
 	GLOBAL_DEF("editor/version_control/plugin_name", "");
 	GLOBAL_DEF("editor/version_control/autoload_on_startup", false);
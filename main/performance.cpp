@@ -33,6 +33,7 @@
 
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
+#include "scene/animation/animation_sample_cache.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio/audio_server.h"
@@ -133,6 +134,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(ANIMATION_SAMPLE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(ANIMATION_SAMPLE_CACHE_MISSES);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -228,6 +231,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("animation/sample_cache_hits"),
+		PNAME("animation/sample_cache_misses"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -452,6 +457,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case ANIMATION_SAMPLE_CACHE_HITS:
+			return AnimationSampleCache::get_frame_stats().hits;
+		case ANIMATION_SAMPLE_CACHE_MISSES:
+			return AnimationSampleCache::get_frame_stats().misses;
 
 		default: {
 		}
@@ -525,7 +534,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -121,6 +121,8 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		ANIMATION_SAMPLE_CACHE_HITS,
+		ANIMATION_SAMPLE_CACHE_MISSES,
 		MONITOR_MAX
 	};
 
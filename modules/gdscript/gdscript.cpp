@@ -50,6 +50,7 @@
 #include "core/config/project_settings.h"
 #include "core/core_constants.h"
 #include "core/io/file_access.h"
+#include "core/object/persistence_schema.h"
 
 #include "scene/resources/packed_scene.h"
 #include "scene/scene_string_names.h"
@@ -742,6 +743,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 	reloading = true;
 
+	// Member declarations may change, drop any compiled persistence schemas.
+	PersistenceSchema::clear_script_cache();
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
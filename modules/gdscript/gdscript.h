@@ -63,6 +63,7 @@ class GDScript : public Script {
 	bool valid = false;
 	bool reloading = false;
 	bool _is_abstract = false;
+	bool thread_safe_process = false;
 
 	struct MemberInfo {
 		int index = 0;
@@ -271,6 +272,7 @@ public:
 
 	bool is_tool() const override { return tool; }
 	bool is_abstract() const override { return _is_abstract; }
+	bool is_process_thread_safe() const override { return thread_safe_process; }
 	Ref<GDScript> get_base() const;
 
 	const HashMap<StringName, MemberInfo> &debug_get_member_indices() const { return member_indices; }
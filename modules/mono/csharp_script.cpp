@@ -52,6 +52,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
 #include "core/io/file_access.h"
+#include "core/object/persistence_schema.h"
 #include "core/os/mutex.h"
 #include "core/os/os.h"
 #include "core/os/thread.h"
@@ -2647,6 +2648,9 @@ Error CSharpScript::reload(bool p_keep_state) {
 	// That's done separately via domain reloading.
 	reload_invalidated = false;
 
+	// Member declarations may have changed, drop any compiled persistence schemas.
+	PersistenceSchema::clear_script_cache();
+
 	String script_path = get_path();
 
 	valid = GDMonoCache::managed_callbacks.ScriptManagerBridge_AddScriptBridge(this, &script_path);
@@ -3581,6 +3581,7 @@ Error EditorExportPlatformAndroid::_generate_sparse_pck_metadata(const Ref<Edito
 		add_message(EXPORT_MESSAGE_ERROR, TTR("Save PCK"), TTR("Can't create encrypted file."));
 		return ERR_CANT_CREATE;
 	}
+	EditorExportPlatform::_update_pack_version(ftmp, p_pack_data, pck_start_pos);
 
 	r_data.resize(ftmp->get_length());
 	ftmp->seek(0);
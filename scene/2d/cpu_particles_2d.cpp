@@ -1239,6 +1239,11 @@ void CPUParticles2D::_update_render_thread() {
 	RS::get_singleton()->multimesh_set_buffer(multimesh, particle_data);
 }
 
+Node *CPUParticles2D::_get_process_thread_scope() const {
+	// Processing only updates this node and its multimesh.
+	return _is_script_process_thread_safe() ? const_cast<CPUParticles2D *>(this) : nullptr;
+}
+
 void CPUParticles2D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE: {
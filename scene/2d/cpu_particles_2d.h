@@ -214,6 +214,7 @@ protected:
 	void _draw_emission_gizmo();
 #endif
 	void _validate_property(PropertyInfo &p_property) const;
+	virtual Node *_get_process_thread_scope() const override;
 
 #ifndef DISABLE_DEPRECATED
 	void _restart_bind_compat_92089();
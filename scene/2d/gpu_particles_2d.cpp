@@ -602,6 +602,11 @@ void GPUParticles2D::convert_from_particles(Node *p_particles) {
 #undef CONVERT_PARAM
 }
 
+Node *GPUParticles2D::_get_process_thread_scope() const {
+	// Processing only updates this node and its particles on the RenderingServer.
+	return _is_script_process_thread_safe() ? const_cast<GPUParticles2D *>(this) : nullptr;
+}
+
 void GPUParticles2D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_DRAW: {
@@ -99,6 +99,7 @@ private:
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &p_property) const;
+	virtual Node *_get_process_thread_scope() const override;
 	void _notification(int p_what);
 #ifdef TOOLS_ENABLED
 	void _draw_emission_gizmo();
@@ -1332,6 +1332,14 @@ void CPUParticles3D::_update_render_thread() {
 	}
 }
 
+Node *CPUParticles3D::_get_process_thread_scope() const {
+	// Processing only updates this node and its multimesh, except for sorting by view depth, which reads the camera.
+	if (draw_order == DRAW_ORDER_VIEW_DEPTH || !_is_script_process_thread_safe()) {
+		return nullptr;
+	}
+	return const_cast<CPUParticles3D *>(this);
+}
+
 void CPUParticles3D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE: {
@@ -506,6 +506,11 @@ NodePath GPUParticles3D::get_sub_emitter() const {
 	return sub_emitter;
 }
 
+Node *GPUParticles3D::_get_process_thread_scope() const {
+	// Processing only updates this node and its particles on the RenderingServer.
+	return _is_script_process_thread_safe() ? const_cast<GPUParticles3D *>(this) : nullptr;
+}
+
 void GPUParticles3D::_notification(int p_what) {
 	switch (p_what) {
 		// Use internal process when emitting and one_shot is on so that when
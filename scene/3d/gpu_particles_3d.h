@@ -107,6 +107,7 @@ protected:
 	static void _bind_methods();
 	void _notification(int p_what);
 	void _validate_property(PropertyInfo &p_property) const;
+	virtual Node *_get_process_thread_scope() const override;
 
 #ifndef DISABLE_DEPRECATED
 	void _restart_bind_compat_92089();
@@ -887,6 +887,35 @@ void Skeleton3D::set_bone_pose_scale(int p_bone, const Vector3 &p_scale) {
 	}
 }
 
+void Skeleton3D::set_bone_poses(Span<BonePoseUpdate> p_updates) {
+	// Same as calling the setters above one by one, but the skeleton is only marked dirty once.
+	const int bone_size = bones.size();
+	Bone *bones_ptr = bones.ptr();
+	for (const BonePoseUpdate &update : p_updates) {
+		ERR_CONTINUE(update.bone < 0 || update.bone >= bone_size);
+		Bone &bone = bones_ptr[update.bone];
+		if (update.components & BONE_POSE_POSITION) {
+			bone.pose_position = update.position;
+		}
+		if (update.components & BONE_POSE_ROTATION) {
+			bone.pose_rotation = update.rotation;
+		}
+		if (update.components & BONE_POSE_SCALE) {
+			bone.pose_scale = update.scale;
+		}
+		bone.pose_cache_dirty = true;
+	}
+	if (p_updates.is_empty() || !is_inside_tree()) {
+		return;
+	}
+	_make_dirty();
+	for (const BonePoseUpdate &update : p_updates) {
+		if (update.bone >= 0 && update.bone < bone_size) {
+			_make_bone_global_pose_subtree_dirty(update.bone);
+		}
+	}
+}
+
 Vector3 Skeleton3D::get_bone_pose_position(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Vector3());
@@ -82,6 +82,21 @@ public:
 		MODIFIER_CALLBACK_MODE_PROCESS_MANUAL,
 	};
 
+	enum BonePoseComponent {
+		BONE_POSE_POSITION = 1,
+		BONE_POSE_ROTATION = 2,
+		BONE_POSE_SCALE = 4,
+	};
+
+	// Pose components written by set_bone_poses(), masked by BonePoseComponent.
+	struct BonePoseUpdate {
+		int bone = -1;
+		uint32_t components = 0;
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+	};
+
 private:
 	friend class SkinReference;
 
@@ -270,6 +285,7 @@ public:
 	void set_bone_pose_position(int p_bone, const Vector3 &p_position);
 	void set_bone_pose_rotation(int p_bone, const Quaternion &p_rotation);
 	void set_bone_pose_scale(int p_bone, const Vector3 &p_scale);
+	void set_bone_poses(Span<BonePoseUpdate> p_updates);
 
 	Transform3D get_bone_global_pose(int p_bone) const;
 	void set_bone_global_pose(int p_bone, const Transform3D &p_pose);
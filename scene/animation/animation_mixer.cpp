@@ -33,9 +33,12 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_sample_cache.h"
 #include "scene/audio/audio_stream_player.h"
 #include "scene/resources/animation.h"
 #include "servers/audio/audio_server.h"
@@ -43,9 +46,11 @@
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/viewport.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -489,6 +494,78 @@ NodePath AnimationMixer::get_root_node() const {
 	return root_node;
 }
 
+void AnimationMixer::set_shared_sampling_enabled(bool p_enabled) {
+	shared_sampling_enabled = p_enabled;
+}
+
+bool AnimationMixer::is_shared_sampling_enabled() const {
+	return shared_sampling_enabled;
+}
+
+void AnimationMixer::set_shared_sampling_time_step(double p_step) {
+	ERR_FAIL_COND(p_step < 0.0);
+	shared_sampling_time_step = p_step;
+}
+
+double AnimationMixer::get_shared_sampling_time_step() const {
+	return shared_sampling_time_step;
+}
+
+void AnimationMixer::set_lod_enabled(bool p_enabled) {
+	lod_enabled = p_enabled;
+}
+
+bool AnimationMixer::is_lod_enabled() const {
+	return lod_enabled;
+}
+
+void AnimationMixer::set_lod_metric(LODMetric p_metric) {
+	lod_metric = p_metric;
+}
+
+AnimationMixer::LODMetric AnimationMixer::get_lod_metric() const {
+	return lod_metric;
+}
+
+void AnimationMixer::set_lod_thresholds(const PackedFloat32Array &p_thresholds) {
+	lod_thresholds = p_thresholds;
+}
+
+PackedFloat32Array AnimationMixer::get_lod_thresholds() const {
+	return lod_thresholds;
+}
+
+void AnimationMixer::set_lod_reference_size(real_t p_size) {
+	ERR_FAIL_COND(p_size <= 0.0);
+	lod_reference_size = p_size;
+}
+
+real_t AnimationMixer::get_lod_reference_size() const {
+	return lod_reference_size;
+}
+
+void AnimationMixer::set_lod_bone_mask(const PackedStringArray &p_mask) {
+	lod_bone_mask = p_mask;
+	_update_lod_mask();
+}
+
+PackedStringArray AnimationMixer::get_lod_bone_mask() const {
+	return lod_bone_mask;
+}
+
+void AnimationMixer::set_lod_bone_mask_level(int p_level) {
+	ERR_FAIL_COND(p_level < 1);
+	lod_bone_mask_level = p_level;
+}
+
+int AnimationMixer::get_lod_bone_mask_level() const {
+	return lod_bone_mask_level;
+}
+
+int AnimationMixer::get_lod_level() const {
+	return lod_level;
+}
+
 void AnimationMixer::set_deterministic(bool p_deterministic) {
 	deterministic = p_deterministic;
 	_clear_caches();
@@ -589,6 +666,7 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	transform_blend_batch.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -647,6 +725,7 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(Ref<Animatio
 
 bool AnimationMixer::_update_caches() {
 	setup_pass++;
+	transform_blend_batch.clear();
 
 	root_motion_cache.loc = Vector3(0, 0, 0);
 	root_motion_cache.rot = Quaternion(0, 0, 0, 1);
@@ -989,6 +1068,9 @@ bool AnimationMixer::_update_caches() {
 
 	track_count = idx;
 
+	_update_parallel_eligibility();
+	_update_lod_mask();
+
 	cache_valid = true;
 
 	return true;
@@ -998,18 +1080,289 @@ bool AnimationMixer::_update_caches() {
 /* -- Blending processor ---------------------- */
 /* -------------------------------------------- */
 
+#ifndef _3D_DISABLED
+// Bone poses of batch processed mixers, applied with one call per run of the same skeleton.
+static ObjectID batched_skeleton_id;
+static LocalVector<Skeleton3D::BonePoseUpdate> batched_bone_poses;
+
+void AnimationMixer::_flush_batched_bone_poses() {
+	if (batched_bone_poses.is_empty()) {
+		return;
+	}
+	Skeleton3D *skeleton = ObjectDB::get_instance<Skeleton3D>(batched_skeleton_id);
+	if (skeleton) {
+		skeleton->set_bone_poses(batched_bone_poses);
+	}
+	batched_bone_poses.clear();
+}
+
+void AnimationMixer::_batch_bone_pose(const TrackCacheTransform *p_track) {
+	if (p_track->skeleton_id != batched_skeleton_id) {
+		_flush_batched_bone_poses();
+		batched_skeleton_id = p_track->skeleton_id;
+	}
+	Skeleton3D::BonePoseUpdate update;
+	update.bone = p_track->bone_idx;
+	if (p_track->loc_used) {
+		update.components |= Skeleton3D::BONE_POSE_POSITION;
+		update.position = p_track->loc;
+	}
+	if (p_track->rot_used) {
+		update.components |= Skeleton3D::BONE_POSE_ROTATION;
+		update.rotation = p_track->rot;
+	}
+	if (p_track->scale_used) {
+		update.components |= Skeleton3D::BONE_POSE_SCALE;
+		update.scale = p_track->scale;
+	}
+	batched_bone_poses.push_back(update);
+}
+#endif // _3D_DISABLED
+
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
+	if (_blend_begin(p_delta)) {
+		_blend_process(p_delta, p_update_only);
+		_blend_end();
+	}
+}
+
+bool AnimationMixer::_blend_begin(double p_delta) {
 	_blend_init();
 	if (cache_valid && _blend_pre_process(p_delta, track_count, track_map)) {
 		_blend_capture(p_delta);
 		_blend_calc_total_weight();
-		_blend_process(p_delta, p_update_only);
-		clear_animation_instances();
-		_blend_apply();
-		_blend_post_process();
-		emit_signal(SNAME("mixer_applied"));
+		return true;
+	}
+	clear_animation_instances();
+	return false;
+}
+
+void AnimationMixer::_blend_end() {
+	clear_animation_instances();
+#ifndef _3D_DISABLED
+	if (lod_divisor > 1 || (lod_has_targets && lod_fraction < 1.0)) {
+		_lod_retarget();
 	} else {
-		clear_animation_instances();
+		lod_has_targets = false;
+	}
+#endif // _3D_DISABLED
+	_blend_apply();
+#ifndef _3D_DISABLED
+	_flush_batched_bone_poses();
+#endif // _3D_DISABLED
+	_blend_post_process();
+	emit_signal(SNAME("mixer_applied"));
+}
+
+/* -------------------------------------------- */
+/* -- Parallel processing --------------------- */
+/* -------------------------------------------- */
+
+LocalVector<ObjectID> AnimationMixer::parallel_queue[2];
+bool AnimationMixer::parallel_flush_queued[2] = {};
+
+void AnimationMixer::TransformBlendBatch::build(const AHashMap<Animation::TypeHash, TrackCache *, HashHasher> &p_track_cache) {
+	clear();
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : p_track_cache) {
+		if (K.value->type != Animation::TYPE_POSITION_3D) {
+			continue; // Rotation and scale tracks share the cache of the position track.
+		}
+		TrackCacheTransform *t = static_cast<TrackCacheTransform *>(K.value);
+		t->batch_index = tracks.size();
+		tracks.push_back(t);
+	}
+	uint32_t count = tracks.size();
+	for (int c = 0; c < CHANNEL_MAX; c++) {
+		value[c].resize(count * 3);
+		init[c].resize(count * 3);
+		sample[c].resize(count * 3);
+		weight[c].resize(count);
+	}
+}
+
+void AnimationMixer::TransformBlendBatch::clear() {
+	tracks.clear();
+	for (int c = 0; c < CHANNEL_MAX; c++) {
+		value[c].clear();
+		init[c].clear();
+		sample[c].clear();
+		weight[c].clear();
+		pending[c] = false;
+	}
+}
+
+void AnimationMixer::TransformBlendBatch::gather() {
+	uint32_t count = tracks.size();
+	for (uint32_t i = 0; i < count; i++) {
+		const TrackCacheTransform *t = tracks[i];
+		const Vector3 *channel_value[CHANNEL_MAX] = { &t->loc, &t->scale };
+		const Vector3 *channel_init[CHANNEL_MAX] = { &t->init_loc, &t->init_scale };
+		for (int c = 0; c < CHANNEL_MAX; c++) {
+			for (int lane = 0; lane < 3; lane++) {
+				value[c][lane * count + i] = (*channel_value[c])[lane];
+				init[c][lane * count + i] = (*channel_init[c])[lane];
+			}
+		}
+	}
+	for (int c = 0; c < CHANNEL_MAX; c++) {
+		// Unsampled tracks must contribute exactly nothing, so their sample is the init value.
+		memcpy(sample[c].ptr(), init[c].ptr(), count * 3 * sizeof(real_t));
+		memset(weight[c].ptr(), 0, count * sizeof(real_t));
+		pending[c] = false;
+	}
+}
+
+void AnimationMixer::TransformBlendBatch::stage(Channel p_channel, int p_index, const Vector3 &p_sample, real_t p_weight) {
+	DEV_ASSERT(p_index >= 0 && p_index < (int)tracks.size());
+	if (weight[p_channel][p_index] != 0) {
+		accumulate(p_channel); // The animation has the same track twice, keep both contributions.
+	}
+	uint32_t count = tracks.size();
+	real_t *s = sample[p_channel].ptr();
+	s[p_index] = p_sample.x;
+	s[count + p_index] = p_sample.y;
+	s[count * 2 + p_index] = p_sample.z;
+	weight[p_channel][p_index] = p_weight;
+	pending[p_channel] = true;
+}
+
+void AnimationMixer::TransformBlendBatch::accumulate(Channel p_channel) {
+	if (!pending[p_channel]) {
+		return;
+	}
+	uint32_t count = tracks.size();
+	real_t *v = value[p_channel].ptr();
+	real_t *s = sample[p_channel].ptr();
+	const real_t *in = init[p_channel].ptr();
+	real_t *w = weight[p_channel].ptr();
+	// Same as `loc += (sample - init_loc) * blend` per track, one lane at a time without branches,
+	// so the compiler can vectorize it.
+	for (uint32_t lane = 0; lane < 3; lane++) {
+		real_t *v_lane = v + lane * count;
+		const real_t *s_lane = s + lane * count;
+		const real_t *in_lane = in + lane * count;
+		for (uint32_t i = 0; i < count; i++) {
+			v_lane[i] += (s_lane[i] - in_lane[i]) * w[i];
+		}
+	}
+	memcpy(s, in, count * 3 * sizeof(real_t));
+	memset(w, 0, count * sizeof(real_t));
+	pending[p_channel] = false;
+}
+
+void AnimationMixer::TransformBlendBatch::scatter() {
+	uint32_t count = tracks.size();
+	const real_t *loc = value[CHANNEL_POSITION].ptr();
+	const real_t *scale = value[CHANNEL_SCALE].ptr();
+	for (uint32_t i = 0; i < count; i++) {
+		TrackCacheTransform *t = tracks[i];
+		t->loc = Vector3(loc[i], loc[count + i], loc[count * 2 + i]);
+		t->scale = Vector3(scale[i], scale[count + i], scale[count * 2 + i]);
+	}
+}
+
+void AnimationMixer::_update_parallel_eligibility() {
+	// Only tracks which blend into the cache without touching other objects can be processed on a worker thread.
+	parallel_eligible = true;
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		switch (K.value->type) {
+			case Animation::TYPE_POSITION_3D:
+			case Animation::TYPE_ROTATION_3D:
+			case Animation::TYPE_SCALE_3D:
+			case Animation::TYPE_BLEND_SHAPE:
+			case Animation::TYPE_BEZIER: {
+			} break;
+			default: {
+				parallel_eligible = false;
+			} break;
+		}
+	}
+	transform_blend_batch.build(track_cache);
+}
+
+bool AnimationMixer::_queue_parallel_process(double p_delta, bool p_physics) {
+	if (!GLOBAL_GET_CACHED(bool, "animation/mixer/parallel_processing") || !Thread::is_main_thread()) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif // TOOLS_ENABLED
+	if (parallel_queued) {
+		return true;
+	}
+	parallel_queued = true;
+	parallel_delta = p_delta;
+	parallel_queue[p_physics].push_back(get_instance_id());
+	if (!parallel_flush_queued[p_physics]) {
+		parallel_flush_queued[p_physics] = true;
+		// Deferred calls are flushed once every node has been processed for this frame.
+		callable_mp_static(&AnimationMixer::_process_parallel_queue).call_deferred(p_physics);
+	}
+	return true;
+}
+
+void AnimationMixer::_parallel_blend_process(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_process(mixer->parallel_delta);
+}
+
+void AnimationMixer::_process_parallel_queue(bool p_physics) {
+	parallel_flush_queued[p_physics] = false;
+	LocalVector<ObjectID> queue = std::move(parallel_queue[p_physics]);
+	parallel_queue[p_physics].clear();
+
+	// Playback and caches may call scripts and touch the scene, so they are updated on the main thread.
+	// Mixers are looked up again after each step, as signals can free them.
+	LocalVector<ObjectID> blended;
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (!mixer) {
+			continue;
+		}
+		mixer->parallel_queued = false;
+		if (!mixer->is_inside_tree() || !mixer->active || !mixer->_blend_begin(mixer->parallel_delta)) {
+			continue;
+		}
+		if (mixer->is_GDVIRTUAL_CALL_post_process_key_value) {
+			if (GDVIRTUAL_IS_OVERRIDDEN_PTR(mixer, _post_process_key_value)) {
+				mixer->_blend_process(mixer->parallel_delta);
+				mixer->_blend_end();
+				continue;
+			}
+			mixer->is_GDVIRTUAL_CALL_post_process_key_value = false;
+		}
+		if (!mixer->parallel_eligible) {
+			mixer->_blend_process(mixer->parallel_delta);
+			mixer->_blend_end();
+			continue;
+		}
+		blended.push_back(id);
+	}
+
+	LocalVector<AnimationMixer *> mixers;
+	for (const ObjectID &id : blended) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (mixer) {
+			mixer->batch_processing = true;
+			mixers.push_back(mixer);
+		}
+	}
+	if (mixers.size() == 1) {
+		_parallel_blend_process(mixers.ptr(), 0);
+	} else if (mixers.size() > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_parallel_blend_process, mixers.ptr(), mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+
+	// Apply all results in one pass.
+	for (const ObjectID &id : blended) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (mixer) {
+			mixer->_blend_end();
+			mixer->batch_processing = false;
+		}
 	}
 }
 
@@ -1187,6 +1540,11 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 #endif // TOOLS_ENABLED
+#ifndef _3D_DISABLED
+	if (batch_processing) {
+		transform_blend_batch.gather();
+	}
+#endif // _3D_DISABLED
 	for (const AnimationInstance &ai : animation_instances) {
 		Ref<Animation> a = ai.animation_data.animation;
 		double time = ai.playback_info.time;
@@ -1210,6 +1568,15 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		real_t a_length = a->get_length();
 		int count = tracks.size();
+		// Root motion always samples the animation itself, it depends on the previous time too.
+		const AnimationSampleCache::Entry *shared_samples = nullptr;
+		if (shared_sampling_enabled) {
+			double sample_time = AnimationSampleCache::quantize_time(time, shared_sampling_time_step);
+			shared_samples = AnimationSampleCache::get_entry(a, sample_time);
+			if (!shared_samples->is_valid_for(a.ptr(), sample_time)) {
+				shared_samples = nullptr; // Sampled for something else, or the animation was edited during this frame.
+			}
+		}
 		for (int i = 0; i < count; i++) {
 			const Animation::Track *animation_track = tracks_ptr[i];
 			if (!animation_track->enabled) {
@@ -1219,6 +1586,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			if (track == nullptr) {
 				continue; // No path, but avoid error spamming.
 			}
+			if (lod_masking && track->lod_masked) {
+				continue;
+			}
 			int blend_idx = track->blend_idx;
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights_count ? track_weights_ptr[blend_idx] * weight : weight;
@@ -1367,12 +1737,16 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = shared_samples ? shared_samples->get_position(i, &loc) : a->try_position_track_interpolate(i, time, &loc);
 						if (err != OK) {
 							continue;
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
-						t->loc += (loc - t->init_loc) * blend;
+						if (batch_processing) {
+							transform_blend_batch.stage(TransformBlendBatch::CHANNEL_POSITION, t->batch_index, loc, blend);
+						} else {
+							t->loc += (loc - t->init_loc) * blend;
+						}
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1455,7 +1829,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = shared_samples ? shared_samples->get_rotation(i, &rot) : a->try_rotation_track_interpolate(i, time, &rot);
 						if (err != OK) {
 							continue;
 						}
@@ -1543,12 +1917,16 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = shared_samples ? shared_samples->get_scale(i, &scale) : a->try_scale_track_interpolate(i, time, &scale);
 						if (err != OK) {
 							continue;
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
-						t->scale += (scale - t->init_scale) * blend;
+						if (batch_processing) {
+							transform_blend_batch.stage(TransformBlendBatch::CHANNEL_SCALE, t->batch_index, scale, blend);
+						} else {
+							t->scale += (scale - t->init_scale) * blend;
+						}
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1559,7 +1937,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = shared_samples ? shared_samples->get_blend_shape(i, &value) : a->try_blend_shape_track_interpolate(i, time, &value);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -1850,7 +2228,18 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				} break;
 			}
 		}
+#ifndef _3D_DISABLED
+		if (batch_processing) {
+			transform_blend_batch.accumulate(TransformBlendBatch::CHANNEL_POSITION);
+			transform_blend_batch.accumulate(TransformBlendBatch::CHANNEL_SCALE);
+		}
+#endif // _3D_DISABLED
+	}
+#ifndef _3D_DISABLED
+	if (batch_processing) {
+		transform_blend_batch.scatter();
 	}
+#endif // _3D_DISABLED
 	is_GDVIRTUAL_CALL_post_process_key_value = true;
 }
 
@@ -1862,6 +2251,9 @@ void AnimationMixer::_blend_apply() {
 		if (!deterministic && is_zero_amount) {
 			continue;
 		}
+		if (lod_masking && track->lod_masked) {
+			continue;
+		}
 		switch (track->type) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -1875,6 +2267,10 @@ void AnimationMixer::_blend_apply() {
 					root_motion_rotation_accumulator = t->rot;
 					root_motion_scale_accumulator = t->scale;
 				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
+					if (batch_processing) {
+						_batch_bone_pose(t);
+						break;
+					}
 					Skeleton3D *t_skeleton = ObjectDB::get_instance<Skeleton3D>(t->skeleton_id);
 					if (!t_skeleton) {
 						return;
@@ -2067,6 +2463,211 @@ void AnimationMixer::clear_caches() {
 	_clear_caches();
 }
 
+/* -------------------------------------------- */
+/* -- Level of detail ------------------------- */
+/* -------------------------------------------- */
+
+SafeNumeric<uint32_t> AnimationMixer::lod_phase_counter;
+
+int AnimationMixer::_compute_lod_level() const {
+#ifndef _3D_DISABLED
+	if (lod_thresholds.is_empty()) {
+		return 0;
+	}
+	const Node3D *root = Object::cast_to<Node3D>(get_node_or_null(root_node));
+	if (!root || !root->is_inside_tree()) {
+		return 0;
+	}
+	const Camera3D *camera = root->get_viewport()->get_camera_3d();
+	if (!camera) {
+		return 0;
+	}
+	real_t distance = camera->get_global_position().distance_to(root->get_global_position());
+	int level = 0;
+	if (lod_metric == LOD_METRIC_DISTANCE) {
+		for (float threshold : lod_thresholds) {
+			if (distance <= threshold) {
+				break;
+			}
+			level++;
+		}
+	} else {
+		// Fraction of the viewport height covered by something of lod_reference_size.
+		real_t view_height = camera->get_projection() == Camera3D::PROJECTION_ORTHOGONAL ? camera->get_size() : 2.0 * distance * Math::tan(Math::deg_to_rad(camera->get_fov()) * 0.5);
+		real_t screen_size = lod_reference_size / MAX(view_height, (real_t)CMP_EPSILON);
+		for (float threshold : lod_thresholds) {
+			if (screen_size >= threshold) {
+				break;
+			}
+			level++;
+		}
+	}
+	return level;
+#else
+	return 0;
+#endif // _3D_DISABLED
+}
+
+void AnimationMixer::_update_lod_mask() {
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		TrackCache *track = K.value;
+		track->lod_masked = false;
+		if (track->type != Animation::TYPE_POSITION_3D && track->type != Animation::TYPE_BLEND_SHAPE) {
+			continue;
+		}
+		String path = String(track->path);
+		for (const String &pattern : lod_bone_mask) {
+			if (path.matchn(pattern)) {
+				track->lod_masked = true;
+				break;
+			}
+		}
+	}
+}
+
+bool AnimationMixer::_lod_skip_frame(double &r_delta) {
+	if (!lod_enabled || !root_motion_track.is_empty()) {
+		// Root motion is consumed every frame, so it can't be throttled.
+		if (lod_divisor != 1 || lod_masking) {
+			lod_level = 0;
+			lod_divisor = 1;
+			lod_step = 1.0;
+			lod_masking = false;
+			lod_frames_until_update = 0;
+			r_delta += lod_accumulated_delta;
+			lod_accumulated_delta = 0.0;
+		}
+		return false;
+	}
+
+	lod_accumulated_delta += r_delta;
+	if (lod_frames_until_update == 0) {
+		lod_level = _compute_lod_level();
+		lod_masking = !lod_bone_mask.is_empty() && lod_level >= lod_bone_mask_level;
+		int divisor = 1 << MIN(lod_level, 8);
+		if (divisor != lod_divisor) {
+			lod_divisor = divisor;
+			lod_step = 1.0 / divisor;
+			// Mixers at the same level start at different frames, so their updates are spread evenly.
+			lod_frames_until_update = lod_phase % divisor;
+		}
+	}
+	if (lod_frames_until_update > 0) {
+		lod_frames_until_update--;
+		_lod_interpolate();
+		return true;
+	}
+
+	// Evaluate with the time of all skipped frames.
+	lod_frames_until_update = lod_divisor - 1;
+	r_delta = lod_accumulated_delta;
+	lod_accumulated_delta = 0.0;
+	return false;
+}
+
+void AnimationMixer::_lod_retarget() {
+	// The blended values become the new target, interpolated towards from the pose currently shown.
+#ifndef _3D_DISABLED
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		TrackCache *track = K.value;
+		bool from_shown = lod_has_targets && track->lod_interpolated;
+		track->lod_interpolated = false;
+		if ((!deterministic && Math::is_zero_approx(track->total_weight)) || (lod_masking && track->lod_masked)) {
+			continue;
+		}
+		switch (track->type) {
+			case Animation::TYPE_POSITION_3D: {
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				if (t->root_motion) {
+					continue;
+				}
+				if (from_shown) {
+					t->lod_from_loc = t->lod_from_loc.lerp(t->lod_to_loc, lod_fraction);
+					t->lod_from_rot = t->lod_from_rot.slerp(t->lod_to_rot, lod_fraction);
+					t->lod_from_scale = t->lod_from_scale.lerp(t->lod_to_scale, lod_fraction);
+				} else {
+					t->lod_from_loc = t->loc;
+					t->lod_from_rot = t->rot;
+					t->lod_from_scale = t->scale;
+				}
+				t->lod_to_loc = t->loc;
+				t->lod_to_rot = t->rot;
+				t->lod_to_scale = t->scale;
+				t->loc = t->lod_from_loc.lerp(t->lod_to_loc, lod_step);
+				t->rot = t->lod_from_rot.slerp(t->lod_to_rot, lod_step);
+				t->scale = t->lod_from_scale.lerp(t->lod_to_scale, lod_step);
+				t->lod_interpolated = true;
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				t->lod_from_value = from_shown ? Math::lerp(t->lod_from_value, t->lod_to_value, (float)lod_fraction) : t->value;
+				t->lod_to_value = t->value;
+				t->value = Math::lerp(t->lod_from_value, t->lod_to_value, (float)lod_step);
+				t->lod_interpolated = true;
+			} break;
+			default: {
+			} break;
+		}
+	}
+#endif // _3D_DISABLED
+	lod_fraction = lod_step;
+	lod_has_targets = true;
+}
+
+void AnimationMixer::_lod_interpolate() {
+	// Moves the tracks of the last update further towards their target on a skipped frame.
+	if (!lod_has_targets || lod_fraction >= 1.0) {
+		return;
+	}
+	lod_fraction = MIN(lod_fraction + lod_step, (real_t)1.0);
+#ifndef _3D_DISABLED
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		TrackCache *track = K.value;
+		if (!track->lod_interpolated) {
+			continue;
+		}
+		switch (track->type) {
+			case Animation::TYPE_POSITION_3D: {
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				t->loc = t->lod_from_loc.lerp(t->lod_to_loc, lod_fraction);
+				t->rot = t->lod_from_rot.slerp(t->lod_to_rot, lod_fraction);
+				t->scale = t->lod_from_scale.lerp(t->lod_to_scale, lod_fraction);
+				if (t->skeleton_id.is_valid()) {
+					if (t->bone_idx >= 0) {
+						_batch_bone_pose(t);
+					}
+					continue;
+				}
+				Node3D *t_node_3d = ObjectDB::get_instance<Node3D>(t->object_id);
+				if (!t_node_3d) {
+					continue;
+				}
+				if (t->loc_used) {
+					t_node_3d->set_position(t->loc);
+				}
+				if (t->rot_used) {
+					t_node_3d->set_rotation(t->rot.get_euler());
+				}
+				if (t->scale_used) {
+					t_node_3d->set_scale(t->scale);
+				}
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				t->value = Math::lerp(t->lod_from_value, t->lod_to_value, (float)lod_fraction);
+				MeshInstance3D *t_mesh_3d = ObjectDB::get_instance<MeshInstance3D>(t->object_id);
+				if (t_mesh_3d) {
+					t_mesh_3d->set_blend_shape_value(t->shape_index, t->value);
+				}
+			} break;
+			default: {
+			} break;
+		}
+	}
+	_flush_batched_bone_poses();
+#endif // _3D_DISABLED
+}
+
 /* -------------------------------------------- */
 /* -- Root motion ----------------------------- */
 /* -------------------------------------------- */
@@ -2355,14 +2956,16 @@ void AnimationMixer::_notification(int p_what) {
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+			double delta = get_process_delta_time();
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE && !_lod_skip_frame(delta) && !_queue_parallel_process(delta, false)) {
+				_process_animation(delta);
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+			double delta = get_physics_process_delta_time();
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS && !_lod_skip_frame(delta) && !_queue_parallel_process(delta, true)) {
+				_process_animation(delta);
 			}
 		} break;
 
@@ -2414,6 +3017,25 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_deterministic", "deterministic"), &AnimationMixer::set_deterministic);
 	ClassDB::bind_method(D_METHOD("is_deterministic"), &AnimationMixer::is_deterministic);
 
+	ClassDB::bind_method(D_METHOD("set_shared_sampling_enabled", "enabled"), &AnimationMixer::set_shared_sampling_enabled);
+	ClassDB::bind_method(D_METHOD("is_shared_sampling_enabled"), &AnimationMixer::is_shared_sampling_enabled);
+	ClassDB::bind_method(D_METHOD("set_shared_sampling_time_step", "time_step"), &AnimationMixer::set_shared_sampling_time_step);
+	ClassDB::bind_method(D_METHOD("get_shared_sampling_time_step"), &AnimationMixer::get_shared_sampling_time_step);
+
+	ClassDB::bind_method(D_METHOD("set_lod_enabled", "enabled"), &AnimationMixer::set_lod_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_enabled"), &AnimationMixer::is_lod_enabled);
+	ClassDB::bind_method(D_METHOD("set_lod_metric", "metric"), &AnimationMixer::set_lod_metric);
+	ClassDB::bind_method(D_METHOD("get_lod_metric"), &AnimationMixer::get_lod_metric);
+	ClassDB::bind_method(D_METHOD("set_lod_thresholds", "thresholds"), &AnimationMixer::set_lod_thresholds);
+	ClassDB::bind_method(D_METHOD("get_lod_thresholds"), &AnimationMixer::get_lod_thresholds);
+	ClassDB::bind_method(D_METHOD("set_lod_reference_size", "size"), &AnimationMixer::set_lod_reference_size);
+	ClassDB::bind_method(D_METHOD("get_lod_reference_size"), &AnimationMixer::get_lod_reference_size);
+	ClassDB::bind_method(D_METHOD("set_lod_bone_mask", "mask"), &AnimationMixer::set_lod_bone_mask);
+	ClassDB::bind_method(D_METHOD("get_lod_bone_mask"), &AnimationMixer::get_lod_bone_mask);
+	ClassDB::bind_method(D_METHOD("set_lod_bone_mask_level", "level"), &AnimationMixer::set_lod_bone_mask_level);
+	ClassDB::bind_method(D_METHOD("get_lod_bone_mask_level"), &AnimationMixer::get_lod_bone_mask_level);
+	ClassDB::bind_method(D_METHOD("get_lod_level"), &AnimationMixer::get_lod_level);
+
 	ClassDB::bind_method(D_METHOD("set_root_node", "path"), &AnimationMixer::set_root_node);
 	ClassDB::bind_method(D_METHOD("get_root_node"), &AnimationMixer::get_root_node);
 
@@ -2464,6 +3086,18 @@ void AnimationMixer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "root_motion_local"), "set_root_motion_local", "is_root_motion_local");
 
+	ADD_GROUP("Shared Sampling", "shared_sampling_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "shared_sampling_enabled"), "set_shared_sampling_enabled", "is_shared_sampling_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "shared_sampling_time_step", PROPERTY_HINT_RANGE, "0,1,0.001,or_greater,suffix:s"), "set_shared_sampling_time_step", "get_shared_sampling_time_step");
+
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_enabled"), "set_lod_enabled", "is_lod_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_metric", PROPERTY_HINT_ENUM, "Distance,Screen Size"), "set_lod_metric", "get_lod_metric");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_thresholds"), "set_lod_thresholds", "get_lod_thresholds");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_reference_size", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater,suffix:m"), "set_lod_reference_size", "get_lod_reference_size");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "lod_bone_mask"), "set_lod_bone_mask", "get_lod_bone_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_bone_mask_level", PROPERTY_HINT_RANGE, "1,8,1,or_greater"), "set_lod_bone_mask_level", "get_lod_bone_mask_level");
+
 	ADD_GROUP("Audio", "audio_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "audio_max_polyphony", PROPERTY_HINT_RANGE, "1,127,1"), "set_audio_max_polyphony", "get_audio_max_polyphony");
 
@@ -2483,6 +3117,9 @@ void AnimationMixer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_DISCRETE_RECESSIVE);
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS);
 
+	BIND_ENUM_CONSTANT(LOD_METRIC_DISTANCE);
+	BIND_ENUM_CONSTANT(LOD_METRIC_SCREEN_SIZE);
+
 	ADD_SIGNAL(MethodInfo(SNAME("animation_list_changed")));
 	ADD_SIGNAL(MethodInfo(SNAME("animation_libraries_updated")));
 	ADD_SIGNAL(MethodInfo(SNAME("animation_finished"), PropertyInfo(Variant::STRING_NAME, "anim_name")));
@@ -2497,6 +3134,7 @@ void AnimationMixer::_bind_methods() {
 
 AnimationMixer::AnimationMixer() {
 	root_node = SceneStringName(path_pp);
+	lod_phase = lod_phase_counter.postincrement();
 }
 
 AnimationMixer::~AnimationMixer() {
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/templates/a_hash_map.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -68,6 +69,11 @@ public:
 		ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS,
 	};
 
+	enum LODMetric {
+		LOD_METRIC_DISTANCE,
+		LOD_METRIC_SCREEN_SIZE,
+	};
+
 	/* ---- Data ---- */
 	struct AnimationLibraryData {
 		StringName name;
@@ -151,6 +157,8 @@ protected:
 		int blend_idx = -1;
 		ObjectID object_id;
 		real_t total_weight = 0.0;
+		bool lod_masked = false; // Matches lod_bone_mask.
+		bool lod_interpolated = false; // Applied by the last update, so it is interpolated until the next one.
 
 		TrackCache() = default;
 		TrackCache(const TrackCache &p_other) :
@@ -177,6 +185,14 @@ protected:
 		Vector3 loc;
 		Quaternion rot;
 		Vector3 scale;
+		int batch_index = -1; // Index in TransformBlendBatch.
+		// Poses interpolated between two updates of a throttled mixer.
+		Vector3 lod_from_loc;
+		Quaternion lod_from_rot;
+		Vector3 lod_from_scale;
+		Vector3 lod_to_loc;
+		Quaternion lod_to_rot;
+		Vector3 lod_to_scale;
 
 		TrackCacheTransform(const TrackCacheTransform &p_other) :
 				TrackCache(p_other),
@@ -210,6 +226,8 @@ protected:
 		float init_value = 0;
 		float value = 0;
 		int shape_index = -1;
+		float lod_from_value = 0;
+		float lod_to_value = 0;
 
 		TrackCacheBlendShape(const TrackCacheBlendShape &p_other) :
 				TrackCache(p_other),
@@ -325,6 +343,79 @@ protected:
 	AHashMap<NodePath, int> track_map;
 	int track_count = 0;
 	bool deterministic = false;
+	bool shared_sampling_enabled = false;
+	double shared_sampling_time_step = 0.0;
+
+	/* ---- Parallel processing ---- */
+	// Position and scale of the transform tracks laid out as structure of arrays, so that
+	// the contribution of an animation instance is accumulated by one flat loop per lane.
+	struct TransformBlendBatch {
+		enum Channel {
+			CHANNEL_POSITION,
+			CHANNEL_SCALE,
+			CHANNEL_MAX,
+		};
+
+		LocalVector<TrackCacheTransform *> tracks;
+		// X, Y and Z lanes of tracks.size() elements each.
+		LocalVector<real_t> value[CHANNEL_MAX];
+		LocalVector<real_t> init[CHANNEL_MAX];
+		LocalVector<real_t> sample[CHANNEL_MAX];
+		// One element per track, zero when the track has no pending sample.
+		LocalVector<real_t> weight[CHANNEL_MAX];
+		bool pending[CHANNEL_MAX] = {};
+
+		void build(const AHashMap<Animation::TypeHash, TrackCache *, HashHasher> &p_track_cache);
+		void clear();
+		void gather();
+		void stage(Channel p_channel, int p_index, const Vector3 &p_sample, real_t p_weight);
+		void accumulate(Channel p_channel);
+		void scatter();
+	};
+
+	static LocalVector<ObjectID> parallel_queue[2]; // Indexed by physics.
+	static bool parallel_flush_queued[2];
+
+	TransformBlendBatch transform_blend_batch;
+	bool parallel_eligible = false;
+	bool parallel_queued = false;
+	bool batch_processing = false;
+	double parallel_delta = 0.0;
+
+	void _update_parallel_eligibility();
+	bool _queue_parallel_process(double p_delta, bool p_physics);
+	static void _process_parallel_queue(bool p_physics);
+	static void _parallel_blend_process(void *p_userdata, uint32_t p_index);
+#ifndef _3D_DISABLED
+	static void _batch_bone_pose(const TrackCacheTransform *p_track);
+	static void _flush_batched_bone_poses();
+#endif // _3D_DISABLED
+
+	/* ---- Level of detail ---- */
+	static SafeNumeric<uint32_t> lod_phase_counter; // Mixers can be constructed on loader threads.
+
+	bool lod_enabled = false;
+	LODMetric lod_metric = LOD_METRIC_DISTANCE;
+	PackedFloat32Array lod_thresholds;
+	real_t lod_reference_size = 2.0;
+	PackedStringArray lod_bone_mask;
+	int lod_bone_mask_level = 1;
+
+	int lod_level = 0;
+	int lod_divisor = 1; // Only every lod_divisor-th frame is evaluated.
+	uint32_t lod_phase = 0; // Staggers the frames evaluated by mixers at the same level.
+	int lod_frames_until_update = 0;
+	double lod_accumulated_delta = 0.0;
+	bool lod_masking = false;
+	bool lod_has_targets = false;
+	real_t lod_fraction = 1.0;
+	real_t lod_step = 1.0;
+
+	int _compute_lod_level() const;
+	void _update_lod_mask();
+	bool _lod_skip_frame(double &r_delta);
+	void _lod_retarget();
+	void _lod_interpolate();
 
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
@@ -364,6 +455,8 @@ protected:
 	GDVIRTUAL5RC(Variant, _post_process_key_value, Ref<Animation>, int, Variant, ObjectID, int);
 
 	void _blend_init();
+	bool _blend_begin(double p_delta);
+	void _blend_end();
 	virtual bool _blend_pre_process(double p_delta, int p_track_count, const AHashMap<NodePath, int> &p_track_map);
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For indeterministic blending.
@@ -420,6 +513,33 @@ public:
 	void set_deterministic(bool p_deterministic);
 	bool is_deterministic() const;
 
+	void set_shared_sampling_enabled(bool p_enabled);
+	bool is_shared_sampling_enabled() const;
+
+	void set_shared_sampling_time_step(double p_step);
+	double get_shared_sampling_time_step() const;
+
+	/* ---- Level of detail ---- */
+	void set_lod_enabled(bool p_enabled);
+	bool is_lod_enabled() const;
+
+	void set_lod_metric(LODMetric p_metric);
+	LODMetric get_lod_metric() const;
+
+	void set_lod_thresholds(const PackedFloat32Array &p_thresholds);
+	PackedFloat32Array get_lod_thresholds() const;
+
+	void set_lod_reference_size(real_t p_size);
+	real_t get_lod_reference_size() const;
+
+	void set_lod_bone_mask(const PackedStringArray &p_mask);
+	PackedStringArray get_lod_bone_mask() const;
+
+	void set_lod_bone_mask_level(int p_level);
+	int get_lod_bone_mask_level() const;
+
+	int get_lod_level() const;
+
 	void set_root_node(const NodePath &p_path);
 	NodePath get_root_node() const;
 
@@ -501,3 +621,4 @@ public:
 VARIANT_ENUM_CAST(AnimationMixer::AnimationCallbackModeProcess);
 VARIANT_ENUM_CAST(AnimationMixer::AnimationCallbackModeMethod);
 VARIANT_ENUM_CAST(AnimationMixer::AnimationCallbackModeDiscrete);
+VARIANT_ENUM_CAST(AnimationMixer::LODMetric);
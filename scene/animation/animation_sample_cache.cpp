@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  animation_sample_cache.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "animation_sample_cache.h"
+
+#include "core/config/engine.h"
+
+BinaryMutex AnimationSampleCache::mutex;
+HashMap<AnimationSampleCache::Key, AnimationSampleCache::Entry *, AnimationSampleCache::Key> AnimationSampleCache::entries;
+uint64_t AnimationSampleCache::frame = 0;
+uint64_t AnimationSampleCache::last_frame = 0;
+AnimationSampleCache::Stats AnimationSampleCache::frame_stats;
+AnimationSampleCache::Stats AnimationSampleCache::last_frame_stats;
+
+void AnimationSampleCache::_begin_frame(uint64_t p_frame) {
+	for (KeyValue<Key, Entry *> &E : entries) {
+		memdelete(E.value);
+	}
+	entries.clear();
+	last_frame = frame;
+	last_frame_stats = frame_stats;
+	frame = p_frame;
+	frame_stats = Stats();
+}
+
+const AnimationSampleCache::Entry *AnimationSampleCache::get_entry(const Ref<Animation> &p_animation, double p_time) {
+	Key key;
+	key.animation = p_animation->get_instance_id();
+	key.time = p_time;
+	uint64_t current_frame = Engine::get_singleton()->get_process_frames();
+	{
+		MutexLock lock(mutex);
+		if (frame != current_frame) {
+			_begin_frame(current_frame);
+		}
+		Entry **found = entries.getptr(key);
+		if (found) {
+			frame_stats.hits++;
+			return *found;
+		}
+		frame_stats.misses++;
+	}
+
+	// Sample outside of the lock, so other mixers aren't held up.
+	Entry *entry = memnew(Entry);
+	entry->animation = key.animation;
+	entry->time = p_time;
+	p_animation->sample_tracks(p_time, entry->samples);
+
+	MutexLock lock(mutex);
+	Entry **found = entries.getptr(key);
+	if (found) {
+		// Another mixer sampled the same entry meanwhile.
+		memdelete(entry);
+		return *found;
+	}
+	entries.insert(key, entry);
+	return entry;
+}
+
+double AnimationSampleCache::quantize_time(double p_time, double p_step) {
+	if (p_step <= 0.0) {
+		return p_time;
+	}
+	return Math::snapped(p_time, p_step);
+}
+
+AnimationSampleCache::Stats AnimationSampleCache::get_frame_stats() {
+	MutexLock lock(mutex);
+	uint64_t previous_frame = Engine::get_singleton()->get_process_frames() - 1;
+	if (frame == previous_frame) {
+		return frame_stats;
+	}
+	if (last_frame == previous_frame) {
+		return last_frame_stats;
+	}
+	return Stats(); // Nothing was sampled in the last frame.
+}
+
+void AnimationSampleCache::clear() {
+	MutexLock lock(mutex);
+	for (KeyValue<Key, Entry *> &E : entries) {
+		memdelete(E.value);
+	}
+	entries.clear();
+	frame_stats = Stats();
+	last_frame_stats = Stats();
+}
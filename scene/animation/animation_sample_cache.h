@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  animation_sample_cache.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/animation.h"
+
+// Frame-scoped cache of sampled position, rotation, scale and blend shape tracks.
+//
+// Mixers which evaluate the same animation at the same time in the same frame
+// (such as a crowd of characters in the same state) share one sampling of all
+// those tracks instead of each decoding the keys again. Entries are sampled
+// without post-processing, so they don't depend on the mixer using them.
+// The cache is emptied whenever a new process frame starts.
+//
+// Lookups are thread-safe, and entries stay valid until the end of the frame.
+class AnimationSampleCache {
+public:
+	struct Entry {
+		ObjectID animation;
+		double time = 0.0;
+		Animation::TrackSamples samples; // Indexed by track, invalid for other track types.
+
+		_FORCE_INLINE_ uint32_t get_track_count() const { return samples.values.size(); }
+		// False if the entry was sampled from another animation or time, or before tracks were added or removed.
+		_FORCE_INLINE_ bool is_valid_for(const Animation *p_animation, double p_time) const {
+			return animation == p_animation->get_instance_id() && time == p_time && get_track_count() == (uint32_t)p_animation->get_track_count();
+		}
+		_FORCE_INLINE_ Error get_position(int p_track, Vector3 *r_position) const {
+			const Quaternion &value = samples.values[p_track];
+			*r_position = Vector3(value.x, value.y, value.z);
+			return samples.valid[p_track] ? OK : ERR_UNAVAILABLE;
+		}
+		_FORCE_INLINE_ Error get_rotation(int p_track, Quaternion *r_rotation) const {
+			*r_rotation = samples.values[p_track];
+			return samples.valid[p_track] ? OK : ERR_UNAVAILABLE;
+		}
+		_FORCE_INLINE_ Error get_scale(int p_track, Vector3 *r_scale) const { return get_position(p_track, r_scale); }
+		_FORCE_INLINE_ Error get_blend_shape(int p_track, float *r_blend) const {
+			*r_blend = samples.values[p_track].x;
+			return samples.valid[p_track] ? OK : ERR_UNAVAILABLE;
+		}
+	};
+
+	struct Stats {
+		uint64_t hits = 0; // Lookups served by a sampling made earlier in the frame.
+		uint64_t misses = 0; // Lookups which had to sample the animation.
+	};
+
+private:
+	struct Key {
+		ObjectID animation;
+		double time = 0.0;
+
+		bool operator==(const Key &p_key) const { return animation == p_key.animation && time == p_key.time; }
+		static uint32_t hash(const Key &p_key) { return hash_murmur3_one_double(p_key.time, hash_murmur3_one_64(p_key.animation)); }
+	};
+
+	static BinaryMutex mutex;
+	static HashMap<Key, Entry *, Key> entries;
+	static uint64_t frame;
+	static uint64_t last_frame;
+	static Stats frame_stats;
+	static Stats last_frame_stats;
+
+	static void _begin_frame(uint64_t p_frame);
+
+public:
+	// Returns the samples of p_animation at p_time, sampling them if no other mixer did in this frame.
+	static const Entry *get_entry(const Ref<Animation> &p_animation, double p_time);
+	// Snaps p_time to multiples of p_step, so mixers at nearly the same time can share the entry.
+	static double quantize_time(double p_time, double p_step);
+
+	// Hits and misses of the last complete frame.
+	static Stats get_frame_stats();
+	static void clear();
+};
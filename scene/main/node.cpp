@@ -224,6 +224,7 @@ void Node::_notification(int p_notification) {
 				_remove_process_group();
 			}
 			data.process_thread_group_owner = nullptr;
+			data.process_thread_group_automatic = false;
 			data.process_owner = nullptr;
 
 			if (data.path_cache) {
@@ -1083,7 +1084,7 @@ void Node::_remove_tree_from_process_thread_group() {
 	}
 
 	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT || K.value->data.process_thread_group_automatic) {
 			continue;
 		}
 
@@ -1096,10 +1097,7 @@ void Node::_remove_tree_from_process_thread_group() {
 }
 
 void Node::_add_tree_to_process_thread_group(Node *p_owner) {
-	if (_is_any_processing()) {
-		_add_to_process_thread_group();
-	}
-
+	// Update the owner first, so nodes are added to the group they now belong to.
 	data.process_thread_group_owner = p_owner;
 	if (p_owner != nullptr) {
 		data.process_group = p_owner->data.process_group;
@@ -1107,14 +1105,62 @@ void Node::_add_tree_to_process_thread_group(Node *p_owner) {
 		data.process_group = &data.tree->default_process_group;
 	}
 
+	if (_is_any_processing()) {
+		_add_to_process_thread_group();
+	}
+
 	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT || K.value->data.process_thread_group_automatic) {
 			continue;
 		}
 
-		K.value->_add_to_process_thread_group();
+		K.value->_add_tree_to_process_thread_group(p_owner);
+	}
+}
+
+void Node::_set_process_thread_group_automatic(bool p_automatic) {
+	// Called by the SceneTree between process passes, only for nodes inheriting their group.
+	ERR_FAIL_COND(!is_inside_tree() || data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT);
+	if (data.process_thread_group_automatic == p_automatic) {
+		return;
+	}
+
+	_remove_tree_from_process_thread_group();
+	if (data.process_thread_group_automatic) {
+		_remove_process_group();
+	}
+
+	data.process_thread_group_automatic = p_automatic;
+
+	if (p_automatic) {
+		data.process_thread_group_owner = this;
+		_add_process_group();
+	} else {
+		data.process_thread_group_owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+	}
+
+	_add_tree_to_process_thread_group(data.process_thread_group_owner);
+}
+
+bool Node::_is_script_process_thread_safe() const {
+	Ref<Script> script = get_script();
+	return script.is_null() || script->is_process_thread_safe();
+}
+
+Node *Node::_get_process_thread_scope() const {
+	// Script processing only; engine classes processing on their own must override this.
+	Ref<Script> script = get_script();
+	if (script.is_valid() && script->is_process_thread_safe() && !data.process_internal && !data.physics_process_internal) {
+		return const_cast<Node *>(this);
 	}
+	return nullptr;
 }
+
+#ifdef DEBUG_ENABLED
+void Node::_report_automatic_thread_group_access() const {
+	data.tree->_reject_automatic_thread_group(current_process_thread_group, this);
+}
+#endif // DEBUG_ENABLED
 bool Node::is_processing_internal() const {
 	return data.process_internal;
 }
@@ -1203,6 +1249,10 @@ void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
 		return;
 	}
 
+	if (data.process_thread_group_automatic) {
+		_set_process_thread_group_automatic(false);
+	}
+
 	_remove_tree_from_process_thread_group();
 	if (data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
 		_remove_process_group();
@@ -235,6 +235,7 @@ private:
 		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
 		Node *process_thread_group_owner = nullptr;
 		int process_thread_group_order = 0;
+		bool process_thread_group_automatic = false; // Owns a sub-thread group created by the SceneTree, see SceneTree::_update_automatic_thread_groups().
 		BitField<ProcessThreadMessages> process_thread_messages = {};
 		void *process_group = nullptr; // to avoid cyclic dependency
 
@@ -367,6 +368,11 @@ private:
 	void _remove_from_process_thread_group();
 	void _remove_tree_from_process_thread_group();
 	void _add_tree_to_process_thread_group(Node *p_owner);
+	void _set_process_thread_group_automatic(bool p_automatic);
+	_FORCE_INLINE_ bool _is_sub_thread_group_owner() const { return data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD || data.process_thread_group_automatic; }
+#ifdef DEBUG_ENABLED
+	void _report_automatic_thread_group_access() const;
+#endif // DEBUG_ENABLED
 
 	static thread_local Node *current_process_thread_group;
 
@@ -414,6 +420,12 @@ protected:
 	bool _is_using_identity_transform() const { return data.use_identity_transform; }
 	int32_t _get_scene_tree_depth() const { return data.depth; }
 
+	// Returns the node whose subtree contains every node touched while processing this one, or null if that's unknown.
+	// Nodes with a known scope may be moved to worker threads automatically by the SceneTree.
+	// By default, this is only known for nodes processed by scripts that declare themselves thread-safe.
+	virtual Node *_get_process_thread_scope() const;
+	bool _is_script_process_thread_safe() const; // True without a script, for classes overriding the above to check their script doesn't add unknown processing.
+
 	//call from SceneTree
 	void _call_input(const Ref<InputEvent> &p_event);
 	void _call_shortcut_input(const Ref<InputEvent> &p_event);
@@ -704,6 +716,11 @@ public:
 			return !data.tree || is_current_thread_safe_for_nodes();
 		} else {
 			// Thread processing.
+#ifdef DEBUG_ENABLED
+			if (unlikely(current_process_thread_group->data.process_thread_group_automatic) && current_process_thread_group != data.process_thread_group_owner && data.tree) {
+				_report_automatic_thread_group_access();
+			}
+#endif // DEBUG_ENABLED
 			return current_process_thread_group == data.process_thread_group_owner;
 		}
 	}
@@ -716,6 +733,12 @@ public:
 			return is_current_thread_safe_for_nodes() || unlikely(!data.tree);
 		} else {
 			// Thread processing.
+#ifdef DEBUG_ENABLED
+			// Nodes in automatic groups were assumed to only read from their own group.
+			if (unlikely(current_process_thread_group->data.process_thread_group_automatic) && current_process_thread_group != data.process_thread_group_owner && data.tree) {
+				_report_automatic_thread_group_access();
+			}
+#endif // DEBUG_ENABLED
 			return true;
 		}
 	}
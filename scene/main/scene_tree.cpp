@@ -1216,6 +1216,10 @@ void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 }
 
 void SceneTree::_process(bool p_physics) {
+	if (automatic_thread_groups && automatic_thread_groups_dirty.is_set() && !node_threading_disabled && !Engine::get_singleton()->is_editor_hint()) {
+		_update_automatic_thread_groups();
+	}
+
 	if (process_groups_dirty) {
 		{
 			// First, remove dirty groups.
@@ -1225,6 +1229,7 @@ void SceneTree::_process(bool p_physics) {
 
 			for (uint32_t i = 0; i < pg_count; i++) {
 				if (pg_ptr[i]->removed) {
+					memdelete(pg_ptr[i]);
 					// Replace removed with last.
 					pg_ptr[i] = pg_ptr[pg_count - 1];
 					// Retry
@@ -1259,16 +1264,16 @@ void SceneTree::_process(bool p_physics) {
 	nodes_removed_on_group_call_lock++;
 
 	int current_order = process_groups[0]->owner ? process_groups[0]->owner->data.process_thread_group_order : 0;
-	bool current_threaded = process_groups[0]->owner ? process_groups[0]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD : false;
+	bool current_threaded = process_groups[0]->owner ? process_groups[0]->owner->_is_sub_thread_group_owner() : false;
 
 	for (uint32_t i = 0; i <= group_count; i++) {
 		int order = i < group_count && process_groups[i]->owner ? process_groups[i]->owner->data.process_thread_group_order : 0;
-		bool threaded = i < group_count && process_groups[i]->owner ? process_groups[i]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD : false;
+		bool threaded = i < group_count && process_groups[i]->owner ? process_groups[i]->owner->_is_sub_thread_group_owner() : false;
 
 		if (i == group_count || current_order != order || current_threaded != threaded) {
 			if (process_count > 0) {
 				// Proceed to process the group.
-				bool using_threads = process_groups[from]->owner && process_groups[from]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD && !node_threading_disabled;
+				bool using_threads = process_groups[from]->owner && process_groups[from]->owner->_is_sub_thread_group_owner() && !node_threading_disabled;
 
 				if (using_threads) {
 					local_process_group_cache.clear();
@@ -1338,14 +1343,18 @@ bool SceneTree::ProcessGroupSort::operator()(const ProcessGroup *p_left, const P
 	int right_order = p_right->owner ? p_right->owner->data.process_thread_group_order : 0;
 
 	if (left_order == right_order) {
-		int left_threaded = p_left->owner != nullptr && p_left->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD ? 0 : 1;
-		int right_threaded = p_right->owner != nullptr && p_right->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD ? 0 : 1;
+		int left_threaded = p_left->owner != nullptr && p_left->owner->_is_sub_thread_group_owner() ? 0 : 1;
+		int right_threaded = p_right->owner != nullptr && p_right->owner->_is_sub_thread_group_owner() ? 0 : 1;
 		return left_threaded < right_threaded;
 	} else {
 		return left_order < right_order;
 	}
 }
 
+bool SceneTree::AutomaticThreadGroupDepthSort::operator()(const Node *p_left, const Node *p_right) const {
+	return p_left->data.depth < p_right->data.depth;
+}
+
 void SceneTree::_remove_process_group(Node *p_node) {
 	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = (ProcessGroup *)p_node->data.process_group;
@@ -1384,6 +1393,8 @@ void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 		bool found = pg->physics_nodes.erase(p_node);
 		ERR_FAIL_COND(!found);
 	}
+
+	_queue_automatic_thread_group_update(p_node);
 }
 
 void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
@@ -1399,8 +1410,276 @@ void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
 		pg->physics_nodes.push_back(p_node);
 		pg->physics_node_order_dirty = true;
 	}
+
+	_queue_automatic_thread_group_update(p_node);
+}
+
+Node *SceneTree::_find_common_ancestor(Node *p_a, Node *p_b) {
+	while (p_a && p_b && p_a != p_b) {
+		if (p_a->data.depth >= p_b->data.depth) {
+			p_a = p_a->data.parent;
+		} else {
+			p_b = p_b->data.parent;
+		}
+	}
+	return p_a == p_b ? p_a : nullptr;
+}
+
+bool SceneTree::_is_in_automatic_thread_group_range(const Node *p_node) {
+	// Nodes in the main thread group or in an automatic group. Explicit groups are left alone.
+	const Node *owner = p_node->data.process_thread_group_owner;
+	return p_node->data.process_thread_group == Node::PROCESS_THREAD_GROUP_INHERIT && (owner == nullptr || owner->data.process_thread_group_automatic);
+}
+
+Node *SceneTree::_get_automatic_thread_group_root(Node *p_node) const {
+	// The root is the lowest node whose subtree contains everything processing p_node may touch.
+	Node *scope = p_node->_get_process_thread_scope();
+	if (!scope || !scope->is_inside_tree() || !_is_in_automatic_thread_group_range(scope)) {
+		return nullptr;
+	}
+	Node *root = _find_common_ancestor(p_node, scope);
+
+	// Signals not connected as deferred run right away on the emitting thread, so their targets must be in the same group.
+	// Any method may be called on them, so they must declare what they touch as well; engine classes don't unless they say so.
+	List<Object::Connection> connections;
+	p_node->get_all_signal_connections(&connections);
+	for (const Object::Connection &connection : connections) {
+		if (connection.flags & Object::CONNECT_DEFERRED) {
+			continue;
+		}
+		Node *target = Object::cast_to<Node>(connection.callable.get_object());
+		if (!target || !target->is_inside_tree() || !_is_in_automatic_thread_group_range(target)) {
+			return nullptr;
+		}
+		Node *target_scope = target->_get_process_thread_scope();
+		if (!target_scope || !target_scope->is_inside_tree() || !_is_in_automatic_thread_group_range(target_scope)) {
+			return nullptr;
+		}
+		root = _find_common_ancestor(root, _find_common_ancestor(target, target_scope));
+	}
+
+	if (!root || Object::cast_to<Viewport>(root) || !_is_in_automatic_thread_group_range(root)) {
+		return nullptr;
+	}
+	return root;
+}
+
+bool SceneTree::_is_automatic_thread_group_candidate(const Node *p_node) {
+	return p_node->_is_any_processing() && _is_in_automatic_thread_group_range(p_node);
+}
+
+void SceneTree::_set_automatic_thread_group_root(const Node *p_node, const Node *p_root) {
+	_clear_automatic_thread_group_root(p_node->get_instance_id());
+	ObjectID root_id = p_root ? p_root->get_instance_id() : ObjectID();
+	automatic_thread_group_roots.insert(p_node->get_instance_id(), root_id);
+	if (p_root) {
+		automatic_thread_group_root_refs[root_id]++;
+	}
 }
 
+void SceneTree::_clear_automatic_thread_group_root(const ObjectID &p_node) {
+	HashMap<ObjectID, ObjectID>::Iterator E = automatic_thread_group_roots.find(p_node);
+	if (!E) {
+		return;
+	}
+	if (E->value.is_valid()) {
+		HashMap<ObjectID, uint32_t>::Iterator R = automatic_thread_group_root_refs.find(E->value);
+		if (R && --R->value == 0) {
+			automatic_thread_group_root_refs.remove(R);
+		}
+	}
+	automatic_thread_group_roots.remove(E);
+}
+
+void SceneTree::_queue_automatic_thread_group_update(const Node *p_node) {
+	// Called with the tree locked, possibly from a thread group.
+	if (!automatic_thread_groups || (automatic_thread_groups_applying && Thread::is_main_thread())) {
+		return;
+	}
+	// Ancestors are kept to find where the node was, in case it leaves the tree before the update.
+	LocalVector<ObjectID> path;
+	for (const Node *n = p_node; n; n = n->data.parent) {
+		path.push_back(n->get_instance_id());
+	}
+	automatic_thread_groups_updates.push_back(std::move(path));
+	automatic_thread_groups_dirty.set();
+}
+
+void SceneTree::_update_automatic_thread_groups() {
+	_THREAD_SAFE_LOCK_
+	LocalVector<LocalVector<ObjectID>> updates = std::move(automatic_thread_groups_updates);
+	automatic_thread_groups_updates.clear();
+	automatic_thread_groups_dirty.clear();
+	_THREAD_SAFE_UNLOCK_
+
+	// Find the subtrees the changes may affect. Nodes are only grouped under their root, and blocking
+	// only reaches their ancestors, so a change can't affect anything past the highest root above it.
+	LocalVector<Node *> subtrees;
+	if (automatic_thread_groups_full_update) {
+		automatic_thread_groups_full_update = false;
+		subtrees.push_back(root);
+	} else {
+		LocalVector<Node *> anchors;
+		for (const LocalVector<ObjectID> &path : updates) {
+			_clear_automatic_thread_group_root(path[0]);
+
+			// The lowest node of the path that is still in place.
+			for (uint32_t i = 0; i < path.size(); i++) {
+				Node *n = ObjectDB::get_instance<Node>(path[i]);
+				if (!n || n->data.tree != this || (i + 1 < path.size() && (!n->data.parent || n->data.parent->get_instance_id() != path[i + 1]))) {
+					continue;
+				}
+				if (i == 0 && _is_automatic_thread_group_candidate(n)) {
+					// Evaluated before finding the subtrees, its root may be above any other.
+					_set_automatic_thread_group_root(n, _get_automatic_thread_group_root(n));
+				}
+				anchors.push_back(n);
+				break;
+			}
+		}
+
+		for (Node *anchor : anchors) {
+			Node *subtree = anchor;
+			for (Node *n = anchor; n; n = n->data.parent) {
+				if (n->data.process_thread_group_automatic || automatic_thread_group_root_refs.has(n->get_instance_id())) {
+					subtree = n;
+				}
+			}
+			subtrees.push_back(subtree);
+		}
+		subtrees.sort_custom<AutomaticThreadGroupDepthSort>();
+	}
+
+	HashSet<Node *> updated;
+	for (Node *subtree : subtrees) {
+		bool nested = false;
+		for (Node *n = subtree; n; n = n->data.parent) {
+			if (updated.has(n)) {
+				nested = true;
+				break;
+			}
+		}
+		if (!nested) {
+			updated.insert(subtree);
+			_update_automatic_thread_group_subtree(subtree);
+		}
+	}
+}
+
+void SceneTree::_update_automatic_thread_group_subtree(Node *p_subtree) {
+	// Explicit thread groups are left alone, along with their subtrees.
+	LocalVector<Node *> nodes;
+	if (_is_in_automatic_thread_group_range(p_subtree)) {
+		nodes.push_back(p_subtree);
+	}
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		for (const KeyValue<StringName, Node *> &K : nodes[i]->data.children) {
+			if (_is_in_automatic_thread_group_range(K.value)) {
+				nodes.push_back(K.value);
+			}
+		}
+	}
+
+	// A node moved to a group owned by one of its ancestors is processed on a worker thread, so the
+	// ancestors of nodes which must stay on the main thread can't own groups. Those are "blocked".
+	HashSet<Node *> blocked;
+	Node *limit = p_subtree->data.parent;
+	auto block = [&blocked, limit](Node *p_node) {
+		for (Node *n = p_node; n != limit && !blocked.has(n); n = n->data.parent) {
+			blocked.insert(n);
+		}
+	};
+
+	HashMap<Node *, Node *> roots;
+	LocalVector<Node *> previous_owners;
+	for (Node *n : nodes) {
+		if (n->data.process_thread_group_automatic) {
+			previous_owners.push_back(n);
+		}
+		if (automatic_thread_groups_rejected.has(n->get_instance_id())) {
+			block(n);
+		}
+		if (!n->_is_any_processing()) {
+			continue;
+		}
+
+		// Roots are cached until the node changes, only new candidates are evaluated.
+		Node *root = nullptr;
+		HashMap<ObjectID, ObjectID>::ConstIterator E = automatic_thread_group_roots.find(n->get_instance_id());
+		if (E && E->value.is_valid()) {
+			root = ObjectDB::get_instance<Node>(E->value);
+		}
+		if (!E || (E->value.is_valid() && !root)) {
+			root = _get_automatic_thread_group_root(n);
+			_set_automatic_thread_group_root(n, root);
+		}
+
+		if (root) {
+			roots.insert(n, root);
+		} else {
+			block(n);
+		}
+	}
+
+	// Nodes whose root got blocked stay on the main thread too, which may block more roots.
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (KeyValue<Node *, Node *> &E : roots) {
+			if (E.value && blocked.has(E.value)) {
+				E.value = nullptr;
+				block(E.key);
+				changed = true;
+			}
+		}
+	}
+
+	// Nested roots are merged into the outermost one.
+	HashSet<Node *> root_set;
+	for (const KeyValue<Node *, Node *> &E : roots) {
+		if (E.value && !blocked.has(E.key)) {
+			root_set.insert(E.value);
+		}
+	}
+	HashSet<Node *> owners;
+	for (Node *root : root_set) {
+		bool nested = false;
+		for (Node *n = root->data.parent; n != limit; n = n->data.parent) {
+			if (root_set.has(n)) {
+				nested = true;
+				break;
+			}
+		}
+		if (!nested) {
+			owners.insert(root);
+		}
+	}
+
+	// Moving nodes between groups doesn't need another update.
+	automatic_thread_groups_applying = true;
+	for (Node *owner : previous_owners) {
+		if (!owners.has(owner)) {
+			owner->_set_process_thread_group_automatic(false);
+		}
+	}
+	for (Node *owner : owners) {
+		owner->_set_process_thread_group_automatic(true);
+	}
+	automatic_thread_groups_applying = false;
+}
+
+#ifdef DEBUG_ENABLED
+void SceneTree::_reject_automatic_thread_group(Node *p_owner, const Node *p_accessed) {
+	_THREAD_SAFE_METHOD_
+	if (automatic_thread_groups_rejected.has(p_owner->get_instance_id())) {
+		return;
+	}
+	automatic_thread_groups_rejected.insert(p_owner->get_instance_id());
+	_queue_automatic_thread_group_update(p_owner);
+	ERR_PRINT(vformat("%s was moved to a worker thread automatically, but processing its thread group accessed %s, which is outside of it. The group will be processed on the main thread from now on.", p_owner->get_description(), p_accessed->get_description()));
+}
+#endif // DEBUG_ENABLED
+
 void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_call_type, const Ref<InputEvent> &p_input, Viewport *p_viewport) {
 	Vector<Node *> nodes_copy;
 	{
@@ -2021,6 +2300,46 @@ void SceneTree::set_disable_node_threading(bool p_disable) {
 	node_threading_disabled = p_disable;
 }
 
+void SceneTree::set_automatic_thread_groups_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "Automatic thread groups can only be toggled from the main thread.");
+	if (automatic_thread_groups == p_enabled) {
+		return;
+	}
+	automatic_thread_groups = p_enabled;
+	if (p_enabled) {
+		// Changes were not tracked while disabled.
+		automatic_thread_groups_full_update = true;
+		automatic_thread_groups_dirty.set();
+		return;
+	}
+
+	automatic_thread_groups_updates.clear();
+	automatic_thread_groups_dirty.clear();
+	automatic_thread_group_roots.clear();
+	automatic_thread_group_root_refs.clear();
+	automatic_thread_groups_applying = true;
+	for (ProcessGroup *pg : process_groups) {
+		if (!pg->removed && pg->owner && pg->owner->data.process_thread_group_automatic) {
+			pg->owner->_set_process_thread_group_automatic(false);
+		}
+	}
+	automatic_thread_groups_applying = false;
+}
+
+bool SceneTree::is_automatic_thread_groups_enabled() const {
+	return automatic_thread_groups;
+}
+
+int SceneTree::get_automatic_thread_group_count() const {
+	int count = 0;
+	for (const ProcessGroup *pg : process_groups) {
+		if (!pg->removed && pg->owner && pg->owner->data.process_thread_group_automatic) {
+			count++;
+		}
+	}
+	return count;
+}
+
 SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
@@ -2063,6 +2382,8 @@ SceneTree::SceneTree() {
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
 
+	automatic_thread_groups = GLOBAL_DEF("application/run/automatic_thread_groups", false);
+
 	// Always disable jitter fix if physics interpolation is enabled -
 	// Jitter fix will interfere with interpolation, and is not necessary
 	// when interpolation is active.
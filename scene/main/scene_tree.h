@@ -119,6 +119,21 @@ private:
 
 	bool node_threading_disabled = false;
 
+	// Nodes known to only touch their own subtree while processing are moved to sub-thread groups automatically.
+	// Changes to processing nodes are queued, and only the subtrees they may affect are evaluated again.
+	bool automatic_thread_groups = false;
+	bool automatic_thread_groups_applying = false;
+	bool automatic_thread_groups_full_update = false;
+	SafeFlag automatic_thread_groups_dirty;
+	LocalVector<LocalVector<ObjectID>> automatic_thread_groups_updates; // Changed nodes, followed by their ancestors at the time.
+	HashMap<ObjectID, ObjectID> automatic_thread_group_roots; // Cached group root of each candidate, null if it must stay on the main thread.
+	HashMap<ObjectID, uint32_t> automatic_thread_group_root_refs; // Number of candidates using each root.
+	HashSet<ObjectID> automatic_thread_groups_rejected; // Group owners whose nodes were caught accessing other groups.
+
+	struct AutomaticThreadGroupDepthSort {
+		_FORCE_INLINE_ bool operator()(const Node *p_left, const Node *p_right) const;
+	};
+
 	struct Group {
 		Vector<Node *> nodes;
 		bool changed = false;
@@ -247,6 +262,19 @@ private:
 	void _remove_node_from_process_group(Node *p_node, Node *p_owner);
 	void _add_node_to_process_group(Node *p_node, Node *p_owner);
 
+	static Node *_find_common_ancestor(Node *p_a, Node *p_b);
+	static bool _is_in_automatic_thread_group_range(const Node *p_node);
+	static bool _is_automatic_thread_group_candidate(const Node *p_node);
+	Node *_get_automatic_thread_group_root(Node *p_node) const;
+	void _set_automatic_thread_group_root(const Node *p_node, const Node *p_root);
+	void _clear_automatic_thread_group_root(const ObjectID &p_node);
+	void _queue_automatic_thread_group_update(const Node *p_node);
+	void _update_automatic_thread_groups();
+	void _update_automatic_thread_group_subtree(Node *p_subtree);
+#ifdef DEBUG_ENABLED
+	void _reject_automatic_thread_group(Node *p_owner, const Node *p_accessed);
+#endif // DEBUG_ENABLED
+
 	void _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	void _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
@@ -454,6 +482,9 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+	void set_automatic_thread_groups_enabled(bool p_enabled);
+	bool is_automatic_thread_groups_enabled() const;
+	int get_automatic_thread_group_count() const;
 	//default texture settings
 
 	void set_physics_interpolation_enabled(bool p_enabled);
@@ -39,6 +39,7 @@
 #include "scene/animation/animation_mixer.h"
 #include "scene/animation/animation_node_extension.h"
 #include "scene/animation/animation_node_state_machine.h"
+#include "scene/animation/animation_sample_cache.h"
 #include "scene/animation/animation_player.h"
 #include "scene/animation/animation_tree.h"
 #include "scene/animation/tween.h"
@@ -1437,6 +1438,8 @@ void unregister_scene_types() {
 
 	SceneDebugger::deinitialize();
 
+	AnimationSampleCache::clear();
+
 	if constexpr (GD_IS_CLASS_ENABLED(TextureLayered)) {
 		ResourceLoader::remove_resource_format_loader(resource_loader_texture_layered);
 		resource_loader_texture_layered.unref();
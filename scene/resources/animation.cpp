@@ -2247,6 +2247,92 @@ bool Animation::track_is_compressed(int p_track) const {
 	}
 }
 
+void Animation::sample_tracks(double p_time, TrackSamples &r_samples) const {
+	uint32_t track_count = tracks.size();
+	r_samples.values.resize(track_count);
+	r_samples.valid.resize(track_count);
+	Quaternion *values = r_samples.values.ptr();
+	uint8_t *valid = r_samples.valid.ptr();
+
+	// Compressed tracks are collected and decoded together below, the others are sampled right away.
+	LocalVector<uint32_t> compressed_vectors;
+	LocalVector<uint32_t> compressed_rotations;
+	LocalVector<uint32_t> compressed_blend_shapes;
+	for (uint32_t i = 0; i < track_count; i++) {
+		const Track *t = tracks[i];
+		valid[i] = 0;
+		if (!t->enabled) {
+			continue;
+		}
+		switch (t->type) {
+			case TYPE_POSITION_3D:
+			case TYPE_SCALE_3D: {
+				if (track_is_compressed(i)) {
+					compressed_vectors.push_back(i);
+					continue;
+				}
+				Vector3 value;
+				Error err = t->type == TYPE_POSITION_3D ? try_position_track_interpolate(i, p_time, &value) : try_scale_track_interpolate(i, p_time, &value);
+				values[i] = Quaternion(value.x, value.y, value.z, 0);
+				valid[i] = err == OK;
+			} break;
+			case TYPE_ROTATION_3D: {
+				if (track_is_compressed(i)) {
+					compressed_rotations.push_back(i);
+					continue;
+				}
+				valid[i] = try_rotation_track_interpolate(i, p_time, &values[i]) == OK;
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				if (track_is_compressed(i)) {
+					compressed_blend_shapes.push_back(i);
+					continue;
+				}
+				float value = 0;
+				valid[i] = try_blend_shape_track_interpolate(i, p_time, &value) == OK;
+				values[i] = Quaternion(value, 0, 0, 0);
+			} break;
+			default: {
+			} break;
+		}
+	}
+
+	if (compressed_vectors.is_empty() && compressed_rotations.is_empty() && compressed_blend_shapes.is_empty()) {
+		return;
+	}
+	ERR_FAIL_COND(!compression.enabled);
+	double time = CLAMP(p_time, 0, length);
+	int32_t page = _find_compressed_page(time);
+	ERR_FAIL_COND(page == -1);
+
+	_decode_compressed_tracks<3>(page, time, compressed_vectors, values);
+	_decode_compressed_tracks<1>(page, time, compressed_blend_shapes, values);
+	for (uint32_t i : compressed_rotations) {
+		Vector3i current;
+		Vector3i next;
+		double time_current;
+		double time_next;
+		_fetch_compressed_in_page<3>(static_cast<const RotationTrack *>(tracks[i])->compressed_track, page, time, current, time_current, next, time_next);
+		if (time_current >= time || time_current == time_next) {
+			values[i] = _uncompress_quaternion(current);
+		} else if (time >= time_next) {
+			values[i] = _uncompress_quaternion(next);
+		} else {
+			double c = (time - time_current) / (time_next - time_current);
+			values[i] = _uncompress_quaternion(current).slerp(_uncompress_quaternion(next), c);
+		}
+	}
+	for (uint32_t i : compressed_vectors) {
+		valid[i] = 1;
+	}
+	for (uint32_t i : compressed_rotations) {
+		valid[i] = 1;
+	}
+	for (uint32_t i : compressed_blend_shapes) {
+		valid[i] = 1;
+	}
+}
+
 void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p_value) {
 	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_track, tracks.size());
 	Track *t = tracks[p_track];
@@ -4852,26 +4938,21 @@ Vector3i Animation::_compress_key(uint32_t p_track, const AABB &p_bounds, int32_
 }
 
 struct AnimationCompressionBufferBitsRead {
-	uint32_t buffer = 0;
-	uint32_t used = 0;
+	uint64_t buffer = 0;
+	uint32_t used = 0; // Bits available in buffer.
 	const uint8_t *src_data = nullptr;
 
 	_FORCE_INLINE_ uint32_t read(uint32_t p_bits) {
-		uint32_t output = 0;
-		uint32_t written = 0;
-		while (p_bits > 0) {
-			if (used == 0) {
-				used = 8;
-				buffer = *src_data;
-				src_data++;
-			}
-			uint32_t to_write = MIN(used, p_bits);
-			output |= (buffer & ((1 << to_write) - 1)) << written;
-			buffer >>= to_write;
-			used -= to_write;
-			p_bits -= to_write;
-			written += to_write;
-		}
+		// Values are at most 16 bits wide, so a read refills at most two bytes.
+		// Bytes are fetched one at a time to never read past the end of the page.
+		while (used < p_bits) {
+			buffer |= uint64_t(*src_data) << used;
+			src_data++;
+			used += 8;
+		}
+		uint32_t output = uint32_t(buffer & ((uint64_t(1) << p_bits) - 1));
+		buffer >>= p_bits;
+		used -= p_bits;
 		return output;
 	}
 };
@@ -5339,26 +5420,44 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 	return true;
 }
 
+int32_t Animation::_find_compressed_page(double p_time) const {
+	// Pages are sorted by time, find the last one starting at or before p_time.
+	int32_t low = 0;
+	int32_t high = int32_t(compression.pages.size()) - 1;
+	int32_t page_index = -1;
+	while (low <= high) {
+		int32_t middle = (low + high) / 2;
+		if (compression.pages[middle].time_offset > p_time) {
+			high = middle - 1;
+		} else {
+			page_index = middle;
+			low = middle + 1;
+		}
+	}
+	return page_index;
+}
+
 template <uint32_t COMPONENTS>
 bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
+
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
+
+	_fetch_compressed_in_page<COMPONENTS>(p_compressed_track, page_index, p_time, r_current_value, r_current_time, r_next_value, r_next_time, key_index);
+	return true;
+}
+
+template <uint32_t COMPONENTS>
+void Animation::_fetch_compressed_in_page(uint32_t p_compressed_track, uint32_t p_page, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
 	if (key_index) {
 		*key_index = 0;
 	}
 
 	double frame_to_sec = 1.0 / double(compression.fps);
-
-	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
-		}
-		page_index = i;
-	}
-
-	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
+	uint32_t page_index = p_page;
 
 	double page_base_time = compression.pages[page_index].time_offset;
 	const uint8_t *page_data = compression.pages[page_index].data.ptr();
@@ -5481,8 +5580,92 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		r_current_value[i] = decode[i];
 		r_next_value[i] = decode_next[i];
 	}
+}
 
-	return true;
+template <uint32_t COMPONENTS>
+void Animation::_decode_compressed_tracks(uint32_t p_page, double p_time, const LocalVector<uint32_t> &p_tracks, Quaternion *r_values) const {
+	// Used for position, scale and blend shape tracks. Rotations aren't interpolated linearly.
+	// Decoding happens in two passes. The first walks the bit-packed keys of each track, which is inherently serial,
+	// and stores the quantized keys around p_time in flat arrays. The second dequantizes and interpolates all tracks
+	// at once with plain loops over those arrays, which the compiler vectorizes (SSE, AVX or NEON, depending on the target).
+	uint32_t count = p_tracks.size();
+	LocalVector<float> from[COMPONENTS];
+	LocalVector<float> delta[COMPONENTS];
+	LocalVector<float> weight;
+	for (uint32_t c = 0; c < COMPONENTS; c++) {
+		from[c].resize(count);
+		delta[c].resize(count);
+	}
+	weight.resize(count);
+
+	for (uint32_t n = 0; n < count; n++) {
+		const Track *track = tracks[p_tracks[n]];
+		int32_t compressed_track = -1;
+		switch (track->type) {
+			case TYPE_POSITION_3D: {
+				compressed_track = static_cast<const PositionTrack *>(track)->compressed_track;
+			} break;
+			case TYPE_SCALE_3D: {
+				compressed_track = static_cast<const ScaleTrack *>(track)->compressed_track;
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				compressed_track = static_cast<const BlendShapeTrack *>(track)->compressed_track;
+			} break;
+			default: {
+				ERR_FAIL_MSG("Only position, scale and blend shape tracks are interpolated linearly.");
+			} break;
+		}
+
+		Vector3i current;
+		Vector3i next;
+		double time_current;
+		double time_next;
+		_fetch_compressed_in_page<COMPONENTS>(compressed_track, p_page, p_time, current, time_current, next, time_next);
+
+		// Same rules as the single track interpolation. Values are computed in single precision and in another
+		// order, so they can differ from it by float rounding, well below the quantization step of the track.
+		float w = 0.0;
+		if (time_current >= p_time || time_current == time_next) {
+			next = current;
+		} else if (p_time >= time_next) {
+			current = next;
+		} else {
+			w = (p_time - time_current) / (time_next - time_current);
+		}
+		for (uint32_t c = 0; c < COMPONENTS; c++) {
+			from[c][n] = current[c];
+			delta[c][n] = float(next[c]) - float(current[c]);
+		}
+		weight[n] = w;
+	}
+
+	const float *weight_ptr = weight.ptr();
+	for (uint32_t c = 0; c < COMPONENTS; c++) {
+		float *from_ptr = from[c].ptr();
+		const float *delta_ptr = delta[c].ptr();
+		for (uint32_t n = 0; n < count; n++) {
+			from_ptr[n] = (from_ptr[n] + delta_ptr[n] * weight_ptr[n]) * (1.0f / 65535.0f);
+		}
+	}
+
+	// Interpolating the quantized keys is the same as interpolating the dequantized ones, as dequantization is linear.
+	for (uint32_t n = 0; n < count; n++) {
+		const Track *track = tracks[p_tracks[n]];
+		Quaternion &value = r_values[p_tracks[n]];
+		switch (track->type) {
+			case TYPE_POSITION_3D:
+			case TYPE_SCALE_3D: {
+				int32_t compressed_track = track->type == TYPE_POSITION_3D ? static_cast<const PositionTrack *>(track)->compressed_track : static_cast<const ScaleTrack *>(track)->compressed_track;
+				const AABB &bounds = compression.bounds[compressed_track];
+				value = Quaternion(bounds.position.x + from[0][n] * bounds.size.x, bounds.position.y + from[1][n] * bounds.size.y, bounds.position.z + from[2][n] * bounds.size.z, 0);
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				value = Quaternion((from[0][n] * 2.0f - 1.0f) * float(Compression::BLEND_SHAPE_RANGE), 0, 0, 0);
+			} break;
+			default: {
+			} break;
+		}
+	}
 }
 
 template <uint32_t COMPONENTS>
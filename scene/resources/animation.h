@@ -358,9 +358,14 @@ private:
 	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
 	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const;
 	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
+	int32_t _find_compressed_page(double p_time) const;
+	template <uint32_t COMPONENTS>
+	void _fetch_compressed_in_page(uint32_t p_compressed_track, uint32_t p_page, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
 	template <uint32_t COMPONENTS>
+	void _decode_compressed_tracks(uint32_t p_page, double p_time, const LocalVector<uint32_t> &p_tracks, Quaternion *r_values) const;
+	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
 	template <uint32_t COMPONENTS>
@@ -446,6 +451,14 @@ public:
 	real_t track_get_key_transition(int p_track, int p_key_idx) const;
 	bool track_is_compressed(int p_track) const;
 
+	// Values of all position, rotation, scale and blend shape tracks at one time, stored contiguously by track index.
+	struct TrackSamples {
+		LocalVector<Quaternion> values; // Position and scale use x, y and z, blend shapes use x.
+		LocalVector<uint8_t> valid; // 0 for other track types, disabled tracks and tracks without keys.
+	};
+	// Samples all those tracks at once. Compressed tracks are decoded together from the page containing p_time.
+	void sample_tracks(double p_time, TrackSamples &r_samples) const;
+
 	int position_track_insert_key(int p_track, double p_time, const Vector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Vector3 *r_position) const;
 	Error try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward = false) const;
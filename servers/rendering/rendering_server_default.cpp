@@ -30,6 +30,7 @@
 
 #include "rendering_server_default.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
 #include "renderer_canvas_cull.h"
@@ -270,6 +271,7 @@ void RenderingServerDefault::init() {
 	if (create_thread) {
 		print_verbose("RenderingServerWrapMT: Starting render thread");
 		DisplayServer::get_singleton()->release_rendering_thread();
+		command_queue.set_ring_size(GLOBAL_GET("threading/command_queue/lock_free_ring_size_kb"));
 		WorkerThreadPool::TaskID tid = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &RenderingServerDefault::_thread_loop), true, "Rendering Server pump task", true);
 		command_queue.set_pump_task_id(tid);
 		command_queue.push(this, &RenderingServerDefault::_assign_mt_ids, tid);
@@ -0,0 +1,1010 @@
+/**************************************************************************/
+/*  packed_snapshot.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_snapshot.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/resources/snapshot.h"
+#include "snapshot_hasher.h"
+
+static const uint8_t PACKED_SNAPSHOT_MAGIC[4] = { 'Z', 'S', 'N', 'P' };
+static const uint8_t PACKED_SNAPSHOT_INDEX_MAGIC[4] = { 'Z', 'S', 'N', 'I' };
+static const uint32_t PACKED_SNAPSHOT_TAIL_SIZE = 8 + 4 + 32 + 4;
+static const uint32_t PACKED_SNAPSHOT_MIN_COMPRESS_SIZE = 256;
+
+struct PackedSnapshot::Builder {
+	Chunk *chunk = nullptr;
+	HashMap<StringName, uint32_t> name_map;
+	HashMap<String, uint32_t> string_map;
+	HashMap<uint32_t, LocalVector<uint32_t>> layout_map; // Field signature hash -> layouts.
+
+	uint32_t intern_name(const StringName &p_name) {
+		HashMap<StringName, uint32_t>::Iterator E = name_map.find(p_name);
+		if (E) {
+			return E->value;
+		}
+		uint32_t idx = chunk->names.size();
+		chunk->names.push_back(p_name);
+		name_map.insert(p_name, idx);
+		return idx;
+	}
+
+	uint32_t intern_string(const String &p_string) {
+		HashMap<String, uint32_t>::Iterator E = string_map.find(p_string);
+		if (E) {
+			return E->value;
+		}
+		uint32_t idx = chunk->strings.size();
+		chunk->strings.push_back(p_string);
+		string_map.insert(p_string, idx);
+		return idx;
+	}
+
+	uint32_t find_or_add_layout(const LocalVector<Field> &p_fields) {
+		uint32_t h = hash_murmur3_one_32(p_fields.size());
+		for (const Field &F : p_fields) {
+			h = hash_murmur3_one_32(F.tag, h);
+			h = hash_murmur3_one_32(F.property, h);
+		}
+		h = hash_fmix32(h);
+
+		LocalVector<uint32_t> &candidates = layout_map[h];
+		for (uint32_t idx : candidates) {
+			const LocalVector<Field> &fields = chunk->layouts[idx].fields;
+			if (fields.size() != p_fields.size()) {
+				continue;
+			}
+			bool equal = true;
+			for (uint32_t i = 0; i < fields.size(); i++) {
+				if (fields[i].tag != p_fields[i].tag || fields[i].property != p_fields[i].property) {
+					equal = false;
+					break;
+				}
+			}
+			if (equal) {
+				return idx;
+			}
+		}
+
+		uint32_t idx = chunk->layouts.size();
+		Layout layout;
+		layout.fields = p_fields;
+		layout.columns.resize(p_fields.size());
+		chunk->layouts.push_back(layout);
+		candidates.push_back(idx);
+		return idx;
+	}
+
+	void add_node(const Dictionary &p_data, const StringName &p_name, uint32_t p_parent, bool p_recursive) {
+		uint32_t record_idx = chunk->records.size();
+		chunk->records.push_back(Record());
+		if (p_parent != NO_INDEX) {
+			chunk->records[p_parent].child_count++;
+		}
+
+		Record record;
+		record.parent = p_parent;
+		record.name = intern_name(p_name);
+
+		LocalVector<Field> fields;
+		LocalVector<const Variant *> values;
+		const Variant *children = nullptr;
+
+		for (const KeyValue<Variant, Variant> &E : p_data) {
+			const String key = E.key;
+			if (key == ".id") {
+				record.id = intern_name(E.value);
+				continue;
+			}
+			if (key == ".scene") {
+				record.scene = intern_string(E.value);
+				continue;
+			}
+			if (key == ".children") {
+				children = &E.value;
+				continue;
+			}
+
+			uint32_t tag = intern_name(E.key);
+			if (E.value.get_type() == Variant::DICTIONARY && !((const Dictionary &)E.value).is_empty()) {
+				const Dictionary &tag_data = E.value;
+				for (const KeyValue<Variant, Variant> &P : tag_data) {
+					Field field;
+					field.tag = tag;
+					field.property = intern_name(P.key);
+					fields.push_back(field);
+					values.push_back(&P.value);
+				}
+			} else {
+				Field field;
+				field.tag = tag;
+				fields.push_back(field);
+				values.push_back(&E.value);
+			}
+		}
+
+		if (!fields.is_empty()) {
+			record.layout = find_or_add_layout(fields);
+			Layout &layout = chunk->layouts[record.layout];
+			record.row = layout.rows++;
+			for (uint32_t i = 0; i < values.size(); i++) {
+				layout.columns[i].values.push_back(*values[i]);
+			}
+		}
+
+		chunk->records[record_idx] = record;
+
+		if (p_recursive && children && children->get_type() == Variant::DICTIONARY) {
+			const Dictionary &children_data = *children;
+			for (const KeyValue<Variant, Variant> &C : children_data) {
+				if (C.value.get_type() == Variant::DICTIONARY) {
+					add_node(C.value, C.key, record_idx, true);
+				}
+			}
+		}
+	}
+
+	void finish_columns() {
+		for (Layout &layout : chunk->layouts) {
+			for (Column &column : layout.columns) {
+				ERR_CONTINUE(column.values.is_empty());
+				Variant::Type type = column.values[0].get_type();
+				bool homogeneous = true;
+				for (const Variant &v : column.values) {
+					if (v.get_type() != type) {
+						homogeneous = false;
+						break;
+					}
+				}
+
+				column.type = type;
+				column.encoding = COLUMN_VARIANT;
+				if (!homogeneous) {
+					column.type = Variant::NIL;
+					continue;
+				}
+
+				switch (type) {
+					case Variant::BOOL: {
+						column.encoding = COLUMN_BOOL;
+					} break;
+					case Variant::INT: {
+						column.encoding = COLUMN_INT;
+					} break;
+					case Variant::FLOAT: {
+						column.encoding = COLUMN_FLOAT;
+					} break;
+					case Variant::STRING:
+					case Variant::STRING_NAME:
+					case Variant::NODE_PATH: {
+						column.encoding = COLUMN_STRING;
+						for (const Variant &v : column.values) {
+							intern_string(v);
+						}
+					} break;
+					default: {
+					} break;
+				}
+			}
+		}
+	}
+};
+
+Ref<PackedSnapshot> PackedSnapshot::create_from_snapshot(const Ref<Snapshot> &p_snapshot) {
+	ERR_FAIL_COND_V(p_snapshot.is_null(), Ref<PackedSnapshot>());
+
+	Ref<PackedSnapshot> packed;
+	packed.instantiate();
+	packed->version = p_snapshot->get_version();
+	packed->checksum = p_snapshot->get_checksum();
+	packed->metadata = p_snapshot->get_metadata();
+	packed->tag_slots = p_snapshot->get_tag_slots();
+	packed->thumbnail = p_snapshot->get_thumbnail();
+	packed->_build_chunks(p_snapshot->get_snapshot());
+	return packed;
+}
+
+void PackedSnapshot::_build_chunks(const Dictionary &p_data) {
+	chunks.clear();
+	subtree_names.clear();
+
+	// Root chunk: the root node alone.
+	chunks.push_back(Chunk());
+	{
+		Builder builder;
+		builder.chunk = &chunks[0];
+		builder.add_node(p_data, StringName(), NO_INDEX, false);
+		builder.finish_columns();
+	}
+
+	// One chunk per top-level subtree.
+	if (p_data.has(".children") && p_data[".children"].get_type() == Variant::DICTIONARY) {
+		const Dictionary children = p_data[".children"];
+		for (const KeyValue<Variant, Variant> &C : children) {
+			if (C.value.get_type() != Variant::DICTIONARY) {
+				continue;
+			}
+			chunks.push_back(Chunk());
+			Chunk &chunk = chunks[chunks.size() - 1];
+			chunk.subtree = C.key;
+			subtree_names.push_back(chunk.subtree);
+
+			Builder builder;
+			builder.chunk = &chunk;
+			builder.add_node(C.value, chunk.subtree, NO_INDEX, true);
+			builder.finish_columns();
+		}
+	}
+}
+
+static Dictionary _chunk_to_dictionary(const PackedSnapshot::Chunk &p_chunk) {
+	const LocalVector<PackedSnapshot::Record> &records = p_chunk.records;
+	if (records.is_empty()) {
+		return Dictionary();
+	}
+
+	LocalVector<Dictionary> nodes;
+	nodes.resize(records.size());
+
+	for (uint32_t i = 0; i < records.size(); i++) {
+		const PackedSnapshot::Record &record = records[i];
+		Dictionary &node = nodes[i];
+
+		if (record.layout != PackedSnapshot::NO_INDEX) {
+			const PackedSnapshot::Layout &layout = p_chunk.layouts[record.layout];
+			for (uint32_t f = 0; f < layout.fields.size(); f++) {
+				const PackedSnapshot::Field &field = layout.fields[f];
+				const Variant &value = layout.columns[f].values[record.row];
+				const StringName &tag = p_chunk.names[field.tag];
+				if (field.property == PackedSnapshot::NO_INDEX) {
+					node[tag] = value;
+				} else {
+					if (!node.has(tag)) {
+						node[tag] = Dictionary();
+					}
+					Dictionary tag_data = node[tag];
+					tag_data[p_chunk.names[field.property]] = value;
+				}
+			}
+		}
+
+		if (record.id != PackedSnapshot::NO_INDEX) {
+			node[".id"] = p_chunk.names[record.id];
+		}
+		if (record.scene != PackedSnapshot::NO_INDEX) {
+			node[".scene"] = p_chunk.strings[record.scene];
+		}
+
+		if (record.parent != PackedSnapshot::NO_INDEX) {
+			Dictionary &parent = nodes[record.parent];
+			if (!parent.has(".children")) {
+				parent[".children"] = Dictionary();
+			}
+			Dictionary children = parent[".children"];
+			children[p_chunk.names[record.name]] = node;
+		}
+	}
+
+	return nodes[0];
+}
+
+Dictionary PackedSnapshot::to_dictionary() const {
+	Dictionary root;
+	for (const Chunk &chunk : chunks) {
+		Dictionary data = _chunk_to_dictionary(chunk);
+		if (chunk.is_root()) {
+			Dictionary children;
+			if (root.has(".children")) {
+				children = root[".children"];
+			}
+			root = data;
+			if (!children.is_empty()) {
+				root[".children"] = children;
+			}
+		} else if (!data.is_empty()) {
+			if (!root.has(".children")) {
+				root[".children"] = Dictionary();
+			}
+			Dictionary children = root[".children"];
+			children[chunk.subtree] = data;
+		}
+	}
+	return root;
+}
+
+Ref<Snapshot> PackedSnapshot::to_snapshot() const {
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(to_dictionary());
+	snapshot->set_version(version);
+	snapshot->set_checksum(checksum);
+	snapshot->set_metadata(metadata);
+	snapshot->set_tag_slots(tag_slots);
+	snapshot->set_thumbnail(thumbnail);
+	return snapshot;
+}
+
+void PackedSnapshot::filter_subtrees(const HashSet<StringName> &p_subtrees) {
+	LocalVector<Chunk> kept;
+	for (Chunk &chunk : chunks) {
+		if (!chunk.is_root() && p_subtrees.has(chunk.subtree)) {
+			kept.push_back(chunk);
+		}
+	}
+	chunks = kept;
+}
+
+// Chunk encoding.
+
+static void _put_u8(LocalVector<uint8_t> &r_buf, uint8_t p_value) {
+	r_buf.push_back(p_value);
+}
+
+static void _put_u32(LocalVector<uint8_t> &r_buf, uint32_t p_value) {
+	uint32_t ofs = r_buf.size();
+	r_buf.resize(ofs + 4);
+	encode_uint32(p_value, &r_buf[ofs]);
+}
+
+static void _put_u64(LocalVector<uint8_t> &r_buf, uint64_t p_value) {
+	uint32_t ofs = r_buf.size();
+	r_buf.resize(ofs + 8);
+	encode_uint64(p_value, &r_buf[ofs]);
+}
+
+static void _put_double(LocalVector<uint8_t> &r_buf, double p_value) {
+	uint32_t ofs = r_buf.size();
+	r_buf.resize(ofs + 8);
+	encode_double(p_value, &r_buf[ofs]);
+}
+
+static void _put_bytes(LocalVector<uint8_t> &r_buf, const uint8_t *p_src, uint32_t p_size) {
+	uint32_t ofs = r_buf.size();
+	r_buf.resize(ofs + p_size);
+	if (p_size) {
+		memcpy(&r_buf[ofs], p_src, p_size);
+	}
+}
+
+static void _put_string(LocalVector<uint8_t> &r_buf, const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	_put_u32(r_buf, utf8.length());
+	_put_bytes(r_buf, (const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+static void _put_variant(LocalVector<uint8_t> &r_buf, const Variant &p_value) {
+	int len = 0;
+	Error err = encode_variant(p_value, nullptr, len, true);
+	ERR_FAIL_COND_MSG(err != OK, "PackedSnapshot: Failed to encode value.");
+	_put_u32(r_buf, len);
+	uint32_t ofs = r_buf.size();
+	r_buf.resize(ofs + len);
+	encode_variant(p_value, &r_buf[ofs], len, true);
+}
+
+void PackedSnapshot::_encode_chunk(const Chunk &p_chunk, LocalVector<uint8_t> &r_body) {
+	HashMap<String, uint32_t> string_map;
+	for (uint32_t i = 0; i < p_chunk.strings.size(); i++) {
+		string_map.insert(p_chunk.strings[i], i);
+	}
+
+	_put_u32(r_body, p_chunk.names.size());
+	for (const StringName &name : p_chunk.names) {
+		_put_string(r_body, name);
+	}
+
+	_put_u32(r_body, p_chunk.strings.size());
+	for (const String &string : p_chunk.strings) {
+		_put_string(r_body, string);
+	}
+
+	_put_u32(r_body, p_chunk.layouts.size());
+	for (const Layout &layout : p_chunk.layouts) {
+		_put_u32(r_body, layout.fields.size());
+		_put_u32(r_body, layout.rows);
+		for (const Field &field : layout.fields) {
+			_put_u32(r_body, field.tag);
+			_put_u32(r_body, field.property);
+		}
+
+		for (const Column &column : layout.columns) {
+			_put_u8(r_body, column.encoding);
+			_put_u8(r_body, column.type);
+			switch (column.encoding) {
+				case COLUMN_BOOL: {
+					for (const Variant &v : column.values) {
+						_put_u8(r_body, bool(v) ? 1 : 0);
+					}
+				} break;
+				case COLUMN_INT: {
+					for (const Variant &v : column.values) {
+						_put_u64(r_body, (uint64_t)int64_t(v));
+					}
+				} break;
+				case COLUMN_FLOAT: {
+					for (const Variant &v : column.values) {
+						_put_double(r_body, double(v));
+					}
+				} break;
+				case COLUMN_STRING: {
+					for (const Variant &v : column.values) {
+						HashMap<String, uint32_t>::Iterator E = string_map.find(v);
+						_put_u32(r_body, E ? E->value : NO_INDEX);
+					}
+				} break;
+				case COLUMN_VARIANT: {
+					for (const Variant &v : column.values) {
+						_put_variant(r_body, v);
+					}
+				} break;
+			}
+		}
+	}
+
+	_put_u32(r_body, p_chunk.records.size());
+	for (const Record &record : p_chunk.records) {
+		_put_u32(r_body, record.parent);
+		_put_u32(r_body, record.name);
+		_put_u32(r_body, record.id);
+		_put_u32(r_body, record.scene);
+		_put_u32(r_body, record.layout);
+		_put_u32(r_body, record.row);
+	}
+}
+
+void PackedSnapshot::_encode_header(LocalVector<uint8_t> &r_body) const {
+	_put_string(r_body, version);
+	_put_variant(r_body, metadata);
+	_put_variant(r_body, tag_slots);
+	_put_variant(r_body, thumbnail);
+}
+
+// Chunk decoding.
+
+namespace {
+struct BodyReader {
+	const uint8_t *ptr = nullptr;
+	uint64_t size = 0;
+	uint64_t pos = 0;
+	bool error = false;
+
+	bool has(uint64_t p_bytes) {
+		if (error || pos + p_bytes > size) {
+			error = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return ptr[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t v = decode_uint32(&ptr[pos]);
+		pos += 4;
+		return v;
+	}
+
+	uint64_t get_u64() {
+		if (!has(8)) {
+			return 0;
+		}
+		uint64_t v = decode_uint64(&ptr[pos]);
+		pos += 8;
+		return v;
+	}
+
+	double get_double() {
+		if (!has(8)) {
+			return 0;
+		}
+		double v = decode_double(&ptr[pos]);
+		pos += 8;
+		return v;
+	}
+
+	void get_bytes(uint8_t *r_dst, uint32_t p_size) {
+		if (!has(p_size)) {
+			return;
+		}
+		memcpy(r_dst, &ptr[pos], p_size);
+		pos += p_size;
+	}
+
+	String get_string() {
+		uint32_t len = get_u32();
+		if (!has(len)) {
+			return String();
+		}
+		String s = String::utf8((const char *)&ptr[pos], len);
+		pos += len;
+		return s;
+	}
+
+	Variant get_variant() {
+		uint32_t len = get_u32();
+		if (!has(len)) {
+			return Variant();
+		}
+		Variant v;
+		if (decode_variant(v, &ptr[pos], len, nullptr, true) != OK) {
+			error = true;
+		}
+		pos += len;
+		return v;
+	}
+};
+} //namespace
+
+Error PackedSnapshot::_decode_chunk(Chunk &r_chunk, const uint8_t *p_body, uint64_t p_size) {
+	BodyReader r;
+	r.ptr = p_body;
+	r.size = p_size;
+
+	uint32_t name_count = r.get_u32();
+	ERR_FAIL_COND_V(!r.has(uint64_t(name_count) * 4), ERR_FILE_CORRUPT);
+	r_chunk.names.resize(name_count);
+	for (uint32_t i = 0; i < name_count; i++) {
+		r_chunk.names[i] = r.get_string();
+	}
+
+	uint32_t string_count = r.get_u32();
+	ERR_FAIL_COND_V(!r.has(uint64_t(string_count) * 4), ERR_FILE_CORRUPT);
+	r_chunk.strings.resize(string_count);
+	for (uint32_t i = 0; i < string_count; i++) {
+		r_chunk.strings[i] = r.get_string();
+	}
+
+	uint32_t layout_count = r.get_u32();
+	ERR_FAIL_COND_V(!r.has(uint64_t(layout_count) * 8), ERR_FILE_CORRUPT);
+	r_chunk.layouts.resize(layout_count);
+	for (Layout &layout : r_chunk.layouts) {
+		uint32_t field_count = r.get_u32();
+		layout.rows = r.get_u32();
+		ERR_FAIL_COND_V(!r.has(uint64_t(field_count) * 8), ERR_FILE_CORRUPT);
+		layout.fields.resize(field_count);
+		for (Field &field : layout.fields) {
+			field.tag = r.get_u32();
+			field.property = r.get_u32();
+			ERR_FAIL_COND_V(field.tag >= name_count, ERR_FILE_CORRUPT);
+			ERR_FAIL_COND_V(field.property != NO_INDEX && field.property >= name_count, ERR_FILE_CORRUPT);
+		}
+
+		layout.columns.resize(field_count);
+		for (Column &column : layout.columns) {
+			column.encoding = (ColumnEncoding)r.get_u8();
+			column.type = (Variant::Type)r.get_u8();
+			ERR_FAIL_COND_V(column.type >= Variant::VARIANT_MAX, ERR_FILE_CORRUPT);
+			ERR_FAIL_COND_V(!r.has(layout.rows), ERR_FILE_CORRUPT);
+			column.values.resize(layout.rows);
+
+			switch (column.encoding) {
+				case COLUMN_BOOL: {
+					for (Variant &v : column.values) {
+						v = r.get_u8() != 0;
+					}
+				} break;
+				case COLUMN_INT: {
+					for (Variant &v : column.values) {
+						v = (int64_t)r.get_u64();
+					}
+				} break;
+				case COLUMN_FLOAT: {
+					for (Variant &v : column.values) {
+						v = r.get_double();
+					}
+				} break;
+				case COLUMN_STRING: {
+					for (Variant &v : column.values) {
+						uint32_t idx = r.get_u32();
+						ERR_FAIL_COND_V(idx >= string_count, ERR_FILE_CORRUPT);
+						if (column.type == Variant::STRING_NAME) {
+							v = StringName(r_chunk.strings[idx]);
+						} else if (column.type == Variant::NODE_PATH) {
+							v = NodePath(r_chunk.strings[idx]);
+						} else {
+							v = r_chunk.strings[idx];
+						}
+					}
+				} break;
+				case COLUMN_VARIANT: {
+					for (Variant &v : column.values) {
+						v = r.get_variant();
+					}
+				} break;
+				default: {
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "PackedSnapshot: Unknown column encoding.");
+				}
+			}
+			ERR_FAIL_COND_V(r.error, ERR_FILE_CORRUPT);
+		}
+	}
+
+	uint32_t record_count = r.get_u32();
+	ERR_FAIL_COND_V(!r.has(uint64_t(record_count) * 24), ERR_FILE_CORRUPT);
+	r_chunk.records.resize(record_count);
+	for (uint32_t i = 0; i < record_count; i++) {
+		Record &record = r_chunk.records[i];
+		record.parent = r.get_u32();
+		record.name = r.get_u32();
+		record.id = r.get_u32();
+		record.scene = r.get_u32();
+		record.layout = r.get_u32();
+		record.row = r.get_u32();
+
+		ERR_FAIL_COND_V(i == 0 && record.parent != NO_INDEX, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(i > 0 && record.parent >= i, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(record.name >= name_count, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(record.id != NO_INDEX && record.id >= name_count, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(record.scene != NO_INDEX && record.scene >= string_count, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(record.layout != NO_INDEX && (record.layout >= layout_count || record.row >= r_chunk.layouts[record.layout].rows), ERR_FILE_CORRUPT);
+
+		if (record.parent != NO_INDEX) {
+			r_chunk.records[record.parent].child_count++;
+		}
+	}
+
+	return r.error ? ERR_FILE_CORRUPT : OK;
+}
+
+Error PackedSnapshot::_decode_header(const uint8_t *p_body, uint64_t p_size) {
+	BodyReader r;
+	r.ptr = p_body;
+	r.size = p_size;
+
+	version = r.get_string();
+	metadata = r.get_variant();
+	tag_slots = r.get_variant();
+	thumbnail = r.get_variant();
+
+	return r.error ? ERR_FILE_CORRUPT : OK;
+}
+
+// File layout.
+
+static Vector<uint8_t> _derive_key(const String &p_key) {
+	// Same derivation as FileAccessEncrypted::open_and_parse_password().
+	Vector<uint8_t> key;
+	if (p_key.is_empty()) {
+		return key;
+	}
+	String cs = p_key.md5_text();
+	key.resize(32);
+	for (int i = 0; i < 32; i++) {
+		key.write[i] = cs[i];
+	}
+	return key;
+}
+
+static void _hash_buffer(const uint8_t *p_data, uint64_t p_size, bool p_sha256, uint8_t r_hash[32]) {
+	if (p_sha256) {
+		CryptoCore::sha256(p_data, p_size, r_hash);
+	} else {
+		memset(r_hash, 0, 32);
+		encode_uint64(SnapshotHasher::xxh64(p_data, p_size), r_hash);
+	}
+}
+
+Error PackedSnapshot::_pack_chunk(const LocalVector<uint8_t> &p_raw, const Vector<uint8_t> &p_key, bool p_compress, bool p_sha256, const uint8_t *p_iv, Vector<uint8_t> &r_stored, IndexEntry &r_entry) {
+	r_entry.raw_size = p_raw.size();
+	r_entry.flags = p_sha256 ? CHUNK_FLAG_SHA256 : 0;
+	_hash_buffer(p_raw.ptr(), p_raw.size(), p_sha256, r_entry.hash);
+
+	uint32_t header = p_key.is_empty() ? 0 : 16; // IV.
+	if (p_compress && p_raw.size() >= PACKED_SNAPSHOT_MIN_COMPRESS_SIZE) {
+		r_stored.resize(header + Compression::get_max_compressed_buffer_size(p_raw.size(), Compression::MODE_ZSTD));
+		int64_t compressed_size = Compression::compress(r_stored.ptrw() + header, p_raw.ptr(), p_raw.size(), Compression::MODE_ZSTD);
+		if (compressed_size > 0 && compressed_size < (int64_t)p_raw.size()) {
+			r_stored.resize(header + compressed_size);
+			r_entry.flags |= CHUNK_FLAG_COMPRESSED;
+		}
+	}
+	if (!(r_entry.flags & CHUNK_FLAG_COMPRESSED)) {
+		r_stored.resize(header + p_raw.size());
+		if (p_raw.size()) {
+			memcpy(r_stored.ptrw() + header, p_raw.ptr(), p_raw.size());
+		}
+	}
+
+	if (!p_key.is_empty()) {
+		uint8_t iv[16];
+		memcpy(iv, p_iv, 16);
+		memcpy(r_stored.ptrw(), p_iv, 16);
+
+		CryptoCore::AESContext ctx;
+		ctx.set_encode_key(p_key.ptr(), 256);
+		ctx.encrypt_cfb(r_stored.size() - 16, iv, r_stored.ptr() + 16, r_stored.ptrw() + 16);
+		r_entry.flags |= CHUNK_FLAG_ENCRYPTED;
+	}
+
+	r_entry.stored_size = r_stored.size();
+	return OK;
+}
+
+struct PackedSnapshot::SaveStage {
+	const SaveContext *context = nullptr;
+	uint32_t index = 0;
+	IndexEntry entry;
+	Vector<uint8_t> stored;
+	uint8_t iv[16] = {};
+	Error error = OK;
+};
+
+struct PackedSnapshot::SaveContext {
+	Vector<uint8_t> key;
+	bool compress = true;
+	bool sha256 = false;
+	LocalVector<SaveStage> stages; // Header first, then one per chunk.
+};
+
+void PackedSnapshot::_pack_stage(SaveStage *p_stage) const {
+	SaveStage &stage = *p_stage;
+	const SaveContext *context = stage.context;
+
+	LocalVector<uint8_t> raw;
+	if (stage.index == 0) {
+		stage.entry.kind = CHUNK_HEADER;
+		_encode_header(raw);
+	} else {
+		const Chunk &chunk = chunks[stage.index - 1];
+		stage.entry.kind = chunk.is_root() ? CHUNK_ROOT : CHUNK_SUBTREE;
+		stage.entry.subtree = chunk.subtree;
+		_encode_chunk(chunk, raw);
+	}
+
+	stage.error = _pack_chunk(raw, context->key, context->compress, context->sha256, stage.iv, stage.stored, stage.entry);
+}
+
+Error PackedSnapshot::_read_chunk(Ref<FileAccess> p_file, const Vector<uint8_t> &p_key, const IndexEntry &p_entry, bool p_verify, Vector<uint8_t> &r_raw, bool &r_hash_valid) {
+	ERR_FAIL_COND_V(p_entry.offset + p_entry.stored_size > p_file->get_length(), ERR_FILE_CORRUPT);
+	p_file->seek(p_entry.offset);
+
+	Vector<uint8_t> data;
+	data.resize(p_entry.stored_size);
+	ERR_FAIL_COND_V(p_file->get_buffer(data.ptrw(), p_entry.stored_size) != p_entry.stored_size, ERR_FILE_CORRUPT);
+
+	if (p_entry.flags & CHUNK_FLAG_ENCRYPTED) {
+		ERR_FAIL_COND_V_MSG(p_key.is_empty(), ERR_FILE_UNRECOGNIZED, "PackedSnapshot: File is encrypted but no key was provided.");
+		ERR_FAIL_COND_V(data.size() < 16, ERR_FILE_CORRUPT);
+		uint8_t iv[16];
+		memcpy(iv, data.ptr(), 16);
+
+		CryptoCore::AESContext ctx;
+		ctx.set_encode_key(p_key.ptr(), 256); // CFB uses the encryption key schedule for both directions.
+		Vector<uint8_t> decrypted;
+		decrypted.resize(data.size() - 16);
+		ctx.decrypt_cfb(decrypted.size(), iv, data.ptr() + 16, decrypted.ptrw());
+		data = decrypted;
+	}
+
+	if (p_entry.flags & CHUNK_FLAG_COMPRESSED) {
+		r_raw.resize(p_entry.raw_size);
+		int64_t size = Compression::decompress(r_raw.ptrw(), p_entry.raw_size, data.ptr(), data.size(), Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V(size != p_entry.raw_size, ERR_FILE_CORRUPT);
+	} else {
+		ERR_FAIL_COND_V(data.size() != p_entry.raw_size, ERR_FILE_CORRUPT);
+		r_raw = data;
+	}
+
+	r_hash_valid = true;
+	if (p_verify) {
+		uint8_t hash[32];
+		_hash_buffer(r_raw.ptr(), r_raw.size(), p_entry.flags & CHUNK_FLAG_SHA256, hash);
+		r_hash_valid = memcmp(hash, p_entry.hash, 32) == 0;
+	}
+
+	return OK;
+}
+
+bool PackedSnapshot::is_packed_file(Ref<FileAccess> p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), false);
+	uint64_t pos = p_file->get_position();
+	uint8_t magic[4] = {};
+	p_file->get_buffer(magic, 4);
+	p_file->seek(pos);
+	return memcmp(magic, PACKED_SNAPSHOT_MAGIC, 4) == 0;
+}
+
+Error PackedSnapshot::save(Ref<FileAccess> p_file, const String &p_key, bool p_compress, bool p_sha256) const {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+
+	SaveContext context;
+	context.key = _derive_key(p_key);
+	context.compress = p_compress;
+	context.sha256 = p_sha256;
+	context.stages.resize(chunks.size() + 1);
+	for (uint32_t i = 0; i < context.stages.size(); i++) {
+		context.stages[i].context = &context;
+		context.stages[i].index = i;
+	}
+
+	if (!context.key.is_empty()) {
+		// The generator is not thread safe, IVs are drawn upfront.
+		CryptoCore::RandomGenerator rng;
+		ERR_FAIL_COND_V(rng.init() != OK, ERR_CANT_CREATE);
+		for (SaveStage &stage : context.stages) {
+			ERR_FAIL_COND_V(rng.get_random_bytes(stage.iv, 16) != OK, ERR_CANT_CREATE);
+		}
+	}
+
+	// Chunks are encoded, compressed and encrypted in parallel, then written in order.
+	// Slot writes already run as pool tasks, so chunks are posted as individual tasks:
+	// waiting on those from a pool thread runs other tasks meanwhile, where waiting on a group blocks.
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	for (uint32_t i = 1; i < context.stages.size(); i++) {
+		tasks.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &PackedSnapshot::_pack_stage, &context.stages[i], false, SNAME("PackedSnapshotSave")));
+	}
+	_pack_stage(&context.stages[0]);
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+
+	p_file->store_buffer(PACKED_SNAPSHOT_MAGIC, 4);
+	p_file->store_32(FORMAT_VERSION);
+	p_file->store_32(p_sha256 ? FILE_FLAG_SHA256 : 0);
+
+	LocalVector<IndexEntry> index;
+	for (SaveStage &stage : context.stages) {
+		ERR_FAIL_COND_V(stage.error != OK, stage.error);
+		stage.entry.offset = p_file->get_position();
+		p_file->store_buffer(stage.stored.ptr(), stage.stored.size());
+		index.push_back(stage.entry);
+	}
+
+	// Footer index.
+	LocalVector<uint8_t> index_data;
+	_put_u32(index_data, index.size());
+	for (const IndexEntry &entry : index) {
+		_put_u8(index_data, entry.kind);
+		_put_string(index_data, entry.subtree);
+		_put_u64(index_data, entry.offset);
+		_put_u32(index_data, entry.stored_size);
+		_put_u32(index_data, entry.raw_size);
+		_put_u32(index_data, entry.flags);
+		_put_bytes(index_data, entry.hash, 32);
+	}
+
+	uint64_t index_offset = p_file->get_position();
+	p_file->store_buffer(index_data.ptr(), index_data.size());
+
+	// The index lists the hash of every chunk, so hashing it covers the whole file.
+	uint8_t index_hash[32];
+	_hash_buffer(index_data.ptr(), index_data.size(), p_sha256, index_hash);
+
+	p_file->store_64(index_offset);
+	p_file->store_32(index_data.size());
+	p_file->store_buffer(index_hash, 32);
+	p_file->store_buffer(PACKED_SNAPSHOT_INDEX_MAGIC, 4);
+
+	return p_file->get_error() == OK || p_file->get_error() == ERR_FILE_EOF ? OK : ERR_FILE_CANT_WRITE;
+}
+
+Error PackedSnapshot::load(Ref<FileAccess> p_file, const String &p_key, bool p_verify_checksum, const HashSet<StringName> *p_subtrees) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+
+	uint8_t magic[4] = {};
+	p_file->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, PACKED_SNAPSHOT_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED, "PackedSnapshot: Not a packed snapshot file.");
+
+	uint32_t format_version = p_file->get_32();
+	ERR_FAIL_COND_V_MSG(format_version != FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, vformat("PackedSnapshot: Unsupported format version %d.", format_version));
+	bool sha256 = p_file->get_32() & FILE_FLAG_SHA256;
+
+	// Footer.
+	uint64_t length = p_file->get_length();
+	ERR_FAIL_COND_V(length < 12 + PACKED_SNAPSHOT_TAIL_SIZE, ERR_FILE_CORRUPT);
+	p_file->seek(length - PACKED_SNAPSHOT_TAIL_SIZE);
+	uint64_t index_offset = p_file->get_64();
+	uint32_t index_size = p_file->get_32();
+	uint8_t index_hash[32];
+	p_file->get_buffer(index_hash, 32);
+	p_file->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, PACKED_SNAPSHOT_INDEX_MAGIC, 4) != 0, ERR_FILE_CORRUPT, "PackedSnapshot: Missing chunk index, the file is truncated.");
+	ERR_FAIL_COND_V(index_offset + index_size > length - PACKED_SNAPSHOT_TAIL_SIZE, ERR_FILE_CORRUPT);
+
+	Vector<uint8_t> index_data;
+	index_data.resize(index_size);
+	p_file->seek(index_offset);
+	ERR_FAIL_COND_V(p_file->get_buffer(index_data.ptrw(), index_size) != index_size, ERR_FILE_CORRUPT);
+
+	uint8_t hash[32];
+	_hash_buffer(index_data.ptr(), index_size, sha256, hash);
+	checksum = String::hex_encode_buffer(index_hash, sha256 ? 32 : 8);
+	checksum_valid = !p_verify_checksum || memcmp(hash, index_hash, 32) == 0;
+
+	BodyReader r;
+	r.ptr = index_data.ptr();
+	r.size = index_size;
+	uint32_t entry_count = r.get_u32();
+	ERR_FAIL_COND_V(!r.has(uint64_t(entry_count) * 57), ERR_FILE_CORRUPT);
+
+	LocalVector<IndexEntry> index;
+	index.resize(entry_count);
+	for (IndexEntry &entry : index) {
+		entry.kind = (ChunkKind)r.get_u8();
+		entry.subtree = r.get_string();
+		entry.offset = r.get_u64();
+		entry.stored_size = r.get_u32();
+		entry.raw_size = r.get_u32();
+		entry.flags = r.get_u32();
+		r.get_bytes(entry.hash, 32);
+	}
+	ERR_FAIL_COND_V(r.error, ERR_FILE_CORRUPT);
+
+	Vector<uint8_t> key = _derive_key(p_key);
+	Vector<uint8_t> raw;
+
+	chunks.clear();
+	subtree_names.clear();
+
+	for (const IndexEntry &entry : index) {
+		if (entry.kind == CHUNK_SUBTREE) {
+			subtree_names.push_back(entry.subtree);
+		}
+
+		bool wanted = entry.kind == CHUNK_HEADER ||
+				(entry.kind == CHUNK_ROOT && !p_subtrees) ||
+				(entry.kind == CHUNK_SUBTREE && (!p_subtrees || p_subtrees->has(entry.subtree)));
+		if (!wanted) {
+			continue;
+		}
+
+		bool hash_valid = true;
+		Error err = _read_chunk(p_file, key, entry, p_verify_checksum, raw, hash_valid);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (!hash_valid) {
+			// Also catches a wrong decryption key. Like a bad index hash, the caller decides whether to reject the file.
+			WARN_VERBOSE(vformat("PackedSnapshot: Chunk hash mismatch (%s).", entry.kind == CHUNK_SUBTREE ? "subtree " + entry.subtree : (entry.kind == CHUNK_ROOT ? String("root") : String("header"))));
+			checksum_valid = false;
+		}
+
+		if (entry.kind == CHUNK_HEADER) {
+			err = _decode_header(raw.ptr(), raw.size());
+		} else {
+			chunks.push_back(Chunk());
+			Chunk &chunk = chunks[chunks.size() - 1];
+			chunk.subtree = entry.subtree;
+			err = _decode_chunk(chunk, raw.ptr(), raw.size());
+		}
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	return OK;
+}
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  packed_snapshot.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/resource.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+
+class Snapshot;
+
+// Columnar on-disk representation used by SaveServer::FORMAT_PACKED.
+//
+// Identifiers (tags, property and node names, persistence IDs) and plain strings
+// (scene paths, string values) are stored once in string tables. Nodes persisting
+// the same set of fields share a layout, whose values are stored as typed columns.
+// Node records reference their parent, names and layout row by index, so the tree
+// can be restored without rebuilding the nested `.children` dictionaries.
+//
+// The file is split into independently compressed (and encrypted) chunks: one for the
+// header, one for the root node and one per top-level subtree. A footer index lists
+// them, so a subset of subtrees can be restored without reading the whole file.
+class PackedSnapshot : public RefCounted {
+	GDSOFTCLASS(PackedSnapshot, RefCounted);
+
+public:
+	static constexpr uint32_t NO_INDEX = UINT32_MAX;
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	enum ColumnEncoding {
+		COLUMN_VARIANT,
+		COLUMN_BOOL,
+		COLUMN_INT,
+		COLUMN_FLOAT,
+		COLUMN_STRING,
+	};
+
+	struct Field {
+		uint32_t tag = NO_INDEX; // Index into `names`.
+		uint32_t property = NO_INDEX; // Index into `names`, NO_INDEX if the tag holds a plain value.
+	};
+
+	struct Column {
+		ColumnEncoding encoding = COLUMN_VARIANT;
+		Variant::Type type = Variant::NIL;
+		LocalVector<Variant> values;
+	};
+
+	struct Layout {
+		LocalVector<Field> fields;
+		LocalVector<Column> columns; // One per field.
+		uint32_t rows = 0;
+	};
+
+	struct Record {
+		uint32_t parent = NO_INDEX; // Parents always precede their children.
+		uint32_t name = NO_INDEX; // Index into `names`.
+		uint32_t id = NO_INDEX; // Index into `names`.
+		uint32_t scene = NO_INDEX; // Index into `strings`.
+		uint32_t layout = NO_INDEX;
+		uint32_t row = 0;
+		uint32_t child_count = 0;
+	};
+
+	// A record without parent is the snapshot root in the root chunk, and a
+	// top-level child of the root (named `subtree`) in subtree chunks.
+	struct Chunk {
+		StringName subtree;
+		LocalVector<StringName> names;
+		LocalVector<String> strings;
+		LocalVector<Layout> layouts;
+		LocalVector<Record> records;
+
+		_FORCE_INLINE_ bool is_root() const { return subtree.is_empty(); }
+	};
+
+private:
+	enum ChunkKind {
+		CHUNK_HEADER,
+		CHUNK_ROOT,
+		CHUNK_SUBTREE,
+	};
+
+	enum ChunkFlags {
+		CHUNK_FLAG_COMPRESSED = 1,
+		CHUNK_FLAG_ENCRYPTED = 2,
+		CHUNK_FLAG_SHA256 = 4, // The hash is SHA-256 rather than XXH64.
+	};
+
+	enum FileFlags {
+		FILE_FLAG_SHA256 = 1, // The index is hashed with SHA-256 rather than XXH64.
+	};
+
+	struct IndexEntry {
+		ChunkKind kind = CHUNK_ROOT;
+		String subtree;
+		uint64_t offset = 0;
+		uint32_t stored_size = 0;
+		uint32_t raw_size = 0;
+		uint32_t flags = 0;
+		uint8_t hash[32] = {}; // XXH64 digests only use the first 8 bytes.
+	};
+
+	String version;
+	String checksum;
+	Dictionary metadata;
+	Dictionary tag_slots;
+	Ref<Resource> thumbnail;
+
+	LocalVector<Chunk> chunks;
+	Vector<String> subtree_names; // All subtrees in the file, loaded or not.
+
+	bool checksum_valid = false;
+
+	struct Builder;
+
+	static void _encode_chunk(const Chunk &p_chunk, LocalVector<uint8_t> &r_body);
+	static Error _decode_chunk(Chunk &r_chunk, const uint8_t *p_body, uint64_t p_size);
+	void _encode_header(LocalVector<uint8_t> &r_body) const;
+	Error _decode_header(const uint8_t *p_body, uint64_t p_size);
+
+	struct SaveContext;
+	struct SaveStage;
+	static Error _pack_chunk(const LocalVector<uint8_t> &p_raw, const Vector<uint8_t> &p_key, bool p_compress, bool p_sha256, const uint8_t *p_iv, Vector<uint8_t> &r_stored, IndexEntry &r_entry);
+	void _pack_stage(SaveStage *p_stage) const;
+	static Error _read_chunk(Ref<FileAccess> p_file, const Vector<uint8_t> &p_key, const IndexEntry &p_entry, bool p_verify, Vector<uint8_t> &r_raw, bool &r_hash_valid);
+
+	void _build_chunks(const Dictionary &p_data);
+
+public:
+	static bool is_packed_file(Ref<FileAccess> p_file);
+
+	static Ref<PackedSnapshot> create_from_snapshot(const Ref<Snapshot> &p_snapshot);
+	Ref<Snapshot> to_snapshot() const;
+	Dictionary to_dictionary() const;
+
+	// Drops the root chunk and every subtree not in `p_subtrees`.
+	void filter_subtrees(const HashSet<StringName> &p_subtrees);
+
+	// Chunks and the index are hashed with XXH64, or with SHA-256 when `p_sha256` is set (strict integrity).
+	Error save(Ref<FileAccess> p_file, const String &p_key = String(), bool p_compress = true, bool p_sha256 = false) const;
+	// When `p_subtrees` is set, only the header and the listed subtree chunks are read.
+	Error load(Ref<FileAccess> p_file, const String &p_key = String(), bool p_verify_checksum = true, const HashSet<StringName> *p_subtrees = nullptr);
+
+	const String &get_version() const { return version; }
+	const String &get_checksum() const { return checksum; }
+	bool is_checksum_valid() const { return checksum_valid; }
+	const Dictionary &get_tag_slots() const { return tag_slots; }
+
+	const LocalVector<Chunk> &get_chunks() const { return chunks; }
+	const Vector<String> &get_subtree_names() const { return subtree_names; }
+};
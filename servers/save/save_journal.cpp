@@ -0,0 +1,227 @@
+/**************************************************************************/
+/*  save_journal.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "save_journal.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/marshalls.h"
+
+static const uint8_t SAVE_JOURNAL_MAGIC[4] = { 'Z', 'S', 'N', 'J' };
+static const uint32_t SAVE_JOURNAL_VERSION = 1;
+static const uint32_t SAVE_JOURNAL_HEADER_SIZE = 8;
+static const uint32_t SAVE_JOURNAL_FRAME_HEADER_SIZE = 4 + 4 + 4;
+
+enum {
+	FRAME_FLAG_ENCRYPTED = 1,
+};
+
+static void _journal_key(const String &p_key, uint8_t r_key[32]) {
+	// Same derivation as FileAccessEncrypted::open_and_parse_password().
+	String cs = p_key.md5_text();
+	for (int i = 0; i < 32; i++) {
+		r_key[i] = cs[i];
+	}
+}
+
+Array SaveJournal::entries_to_array(const LocalVector<Entry> &p_entries) {
+	Array array;
+	for (const Entry &entry : p_entries) {
+		array.push_back(entry.op);
+		array.push_back(entry.path);
+		array.push_back(entry.data);
+	}
+	return array;
+}
+
+void SaveJournal::entries_from_array(const Array &p_array, LocalVector<Entry> &r_entries) {
+	ERR_FAIL_COND(p_array.size() % 3 != 0);
+	for (int i = 0; i < p_array.size(); i += 3) {
+		Entry entry;
+		entry.op = (Operation)(int)p_array[i];
+		entry.path = p_array[i + 1];
+		entry.data = p_array[i + 2];
+		r_entries.push_back(entry);
+	}
+}
+
+Error SaveJournal::append(const String &p_path, const LocalVector<Entry> &p_entries, const String &p_key) {
+	if (p_entries.is_empty()) {
+		return OK;
+	}
+
+	// Encode the frame payload.
+	Array array = entries_to_array(p_entries);
+	int len = 0;
+	Error err = encode_variant(array, nullptr, len, true);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	Vector<uint8_t> payload;
+	uint32_t flags = 0;
+	if (p_key.is_empty()) {
+		payload.resize(len);
+		encode_variant(array, payload.ptrw(), len, true);
+	} else {
+		Vector<uint8_t> plain;
+		plain.resize(len);
+		encode_variant(array, plain.ptrw(), len, true);
+
+		uint8_t key[32];
+		_journal_key(p_key, key);
+		payload.resize(16 + len);
+
+		CryptoCore::RandomGenerator rng;
+		ERR_FAIL_COND_V(rng.init() != OK, ERR_CANT_CREATE);
+		ERR_FAIL_COND_V(rng.get_random_bytes(payload.ptrw(), 16) != OK, ERR_CANT_CREATE);
+
+		uint8_t iv[16];
+		memcpy(iv, payload.ptr(), 16);
+		CryptoCore::AESContext ctx;
+		ctx.set_encode_key(key, 256);
+		ctx.encrypt_cfb(len, iv, plain.ptr(), payload.ptrw() + 16);
+		flags |= FRAME_FLAG_ENCRYPTED;
+	}
+
+	Ref<FileAccess> f;
+	if (FileAccess::exists(p_path)) {
+		f = FileAccess::open(p_path, FileAccess::READ_WRITE);
+	}
+
+	if (f.is_valid()) {
+		uint8_t magic[4] = {};
+		f->get_buffer(magic, 4);
+		uint32_t version = f->get_32();
+		ERR_FAIL_COND_V_MSG(memcmp(magic, SAVE_JOURNAL_MAGIC, 4) != 0 || version != SAVE_JOURNAL_VERSION, ERR_FILE_UNRECOGNIZED, "SaveJournal: Invalid journal file: " + p_path);
+
+		// Skip the valid frames. Replay stops at the first damaged one, so it's truncated
+		// along with everything after it, otherwise the new frame would never be replayed.
+		uint64_t length = f->get_length();
+		uint64_t end = SAVE_JOURNAL_HEADER_SIZE;
+		Vector<uint8_t> frame;
+		while (end + SAVE_JOURNAL_FRAME_HEADER_SIZE <= length) {
+			f->seek(end);
+			uint32_t size = f->get_32();
+			uint32_t hash = f->get_32();
+			f->get_32(); // Flags.
+			if (end + SAVE_JOURNAL_FRAME_HEADER_SIZE + size > length) {
+				break;
+			}
+			frame.resize(size);
+			f->get_buffer(frame.ptrw(), size);
+			if (hash_murmur3_buffer(frame.ptr(), size) != hash) {
+				break;
+			}
+			end += SAVE_JOURNAL_FRAME_HEADER_SIZE + size;
+		}
+		if (end != length) {
+			WARN_PRINT("SaveJournal: Discarding damaged frames at the end of " + p_path);
+			f->resize(end);
+		}
+		f->seek(end);
+	} else {
+		f = FileAccess::open(p_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, "SaveJournal: Cannot open journal for writing: " + p_path);
+		f->store_buffer(SAVE_JOURNAL_MAGIC, 4);
+		f->store_32(SAVE_JOURNAL_VERSION);
+	}
+
+	f->store_32(payload.size());
+	f->store_32(hash_murmur3_buffer(payload.ptr(), payload.size()));
+	f->store_32(flags);
+	f->store_buffer(payload.ptr(), payload.size());
+	f->flush();
+
+	return f->get_error() == OK || f->get_error() == ERR_FILE_EOF ? OK : ERR_FILE_CANT_WRITE;
+}
+
+Error SaveJournal::read(const String &p_path, const String &p_key, LocalVector<Entry> &r_entries) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(memcmp(magic, SAVE_JOURNAL_MAGIC, 4) != 0 || version != SAVE_JOURNAL_VERSION, ERR_FILE_UNRECOGNIZED, "SaveJournal: Invalid journal file: " + p_path);
+
+	uint8_t key[32];
+	if (!p_key.is_empty()) {
+		_journal_key(p_key, key);
+	}
+
+	uint64_t length = f->get_length();
+	uint64_t pos = SAVE_JOURNAL_HEADER_SIZE;
+	Vector<uint8_t> payload;
+	Vector<uint8_t> plain;
+
+	while (pos + SAVE_JOURNAL_FRAME_HEADER_SIZE <= length) {
+		f->seek(pos);
+		uint32_t size = f->get_32();
+		uint32_t hash = f->get_32();
+		uint32_t flags = f->get_32();
+		if (pos + SAVE_JOURNAL_FRAME_HEADER_SIZE + size > length) {
+			WARN_PRINT("SaveJournal: Discarding incomplete frame at the end of " + p_path);
+			break;
+		}
+
+		payload.resize(size);
+		f->get_buffer(payload.ptrw(), size);
+		if (hash_murmur3_buffer(payload.ptr(), size) != hash) {
+			WARN_PRINT("SaveJournal: Discarding damaged frames at the end of " + p_path);
+			break;
+		}
+		pos += SAVE_JOURNAL_FRAME_HEADER_SIZE + size;
+
+		const Vector<uint8_t> *data = &payload;
+		if (flags & FRAME_FLAG_ENCRYPTED) {
+			ERR_FAIL_COND_V_MSG(p_key.is_empty(), ERR_FILE_UNRECOGNIZED, "SaveJournal: Journal is encrypted but no key was provided.");
+			ERR_FAIL_COND_V(size < 16, ERR_FILE_CORRUPT);
+			uint8_t iv[16];
+			memcpy(iv, payload.ptr(), 16);
+			plain.resize(size - 16);
+			CryptoCore::AESContext ctx;
+			ctx.set_encode_key(key, 256); // CFB uses the encryption key schedule for both directions.
+			ctx.decrypt_cfb(plain.size(), iv, payload.ptr() + 16, plain.ptrw());
+			data = &plain;
+		}
+
+		Variant array;
+		Error err = decode_variant(array, data->ptr(), data->size(), nullptr, true);
+		ERR_FAIL_COND_V_MSG(err != OK || array.get_type() != Variant::ARRAY, ERR_FILE_CORRUPT, "SaveJournal: Cannot decode frame (wrong key?) in " + p_path);
+		entries_from_array(array, r_entries);
+	}
+
+	return OK;
+}
+
+uint64_t SaveJournal::get_size(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	return f.is_valid() ? f->get_length() : 0;
+}
@@ -0,0 +1,64 @@
+/**************************************************************************/
+/*  save_journal.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/string/node_path.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+
+// Append-only write-ahead journal holding the amend saves of a slot.
+//
+// Each append writes one frame (size, hash, flags, payload) holding all the entries
+// of an amend, so a frame is either replayed whole or not at all. Replay stops at the
+// first damaged frame, which is how a torn write from a crash shows up.
+// Journals are folded back into the slot by SaveServer once they grow too large.
+class SaveJournal {
+public:
+	enum Operation {
+		OP_PATCH, // Merges `data` into the node at `path`, keeping its children.
+		OP_REMOVE, // Removes the node at `path` and its subtree.
+	};
+
+	struct Entry {
+		Operation op = OP_PATCH;
+		NodePath path;
+		Dictionary data;
+	};
+
+	static Array entries_to_array(const LocalVector<Entry> &p_entries);
+	static void entries_from_array(const Array &p_array, LocalVector<Entry> &r_entries);
+
+	// `p_key` encrypts the frame payloads, an empty key stores them in plain.
+	static Error append(const String &p_path, const LocalVector<Entry> &p_entries, const String &p_key);
+	static Error read(const String &p_path, const String &p_key, LocalVector<Entry> &r_entries);
+	static uint64_t get_size(const String &p_path);
+};
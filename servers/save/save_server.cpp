@@ -33,17 +33,26 @@
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
+#include "core/io/delta_encoding.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/variant/variant_utility.h"
+#include "packed_snapshot.h"
+#include "snapshot_hasher.h"
 #include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/packed_scene.h"
 #include "scene/resources/snapshot.h"
 
+// Ends binary saves, after the checksum of the encoded snapshot.
+static const uint8_t SNAPSHOT_CHECKSUM_MAGIC[4] = { 'Z', 'S', 'N', 'C' };
+
 SaveServer *SaveServer::singleton = nullptr;
 
 SaveServer *SaveServer::get_singleton() {
@@ -57,8 +66,12 @@ void SaveServer::register_settings() {
 	GLOBAL_DEF_BASIC("application/persistence/compression_enabled", true);
 	GLOBAL_DEF_BASIC("application/persistence/backup_enabled", true);
 	GLOBAL_DEF_BASIC("application/persistence/max_backups", 2);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "application/persistence/backup_keyframe_interval", PROPERTY_HINT_RANGE, "1,64,1,or_greater"), 8);
 	GLOBAL_DEF_BASIC("application/persistence/integrity_check_level", 1);
 	GLOBAL_DEF_BASIC("application/persistence/save_path", "user://saves/");
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "application/persistence/capture_budget_usec", PROPERTY_HINT_RANGE, "100,100000,1,or_greater,suffix:µs"), 2000);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "application/persistence/restore_budget_usec", PROPERTY_HINT_RANGE, "100,100000,1,or_greater,suffix:µs"), 4000);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "application/persistence/journal_max_size", PROPERTY_HINT_RANGE, "0,16777216,1,or_greater,suffix:B"), 256 * 1024);
 }
 
 void SaveServer::_bind_methods() {
@@ -71,12 +84,20 @@ void SaveServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("save_snapshot", "root", "slot_name", "async", "tags", "metadata", "thumbnail"), &SaveServer::save_snapshot, DEFVAL(true), DEFVAL(TypedArray<StringName>()), DEFVAL(Dictionary()), DEFVAL(Ref<Resource>()));
 	ClassDB::bind_method(D_METHOD("load_snapshot", "root", "slot_name", "callback", "dynamic_respawn"), &SaveServer::load_snapshot, DEFVAL(Callable()), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_snapshot_batched", "root", "slot_name", "callback", "dynamic_respawn"), &SaveServer::load_snapshot_batched, DEFVAL(Callable()), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_snapshot_subtrees", "root", "slot_name", "subtrees", "callback", "dynamic_respawn"), &SaveServer::load_snapshot_subtrees, DEFVAL(Callable()), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("has_snapshot", "slot_name"), &SaveServer::has_snapshot);
 
 	ClassDB::bind_method(D_METHOD("_finish_load_async", "slot_name", "node_id", "data", "callback", "dynamic_respawn"), &SaveServer::_finish_load_async);
 
+	ClassDB::bind_method(D_METHOD("save_snapshot_sliced", "root", "slot_name", "tags", "metadata", "thumbnail"), &SaveServer::save_snapshot_sliced, DEFVAL(TypedArray<StringName>()), DEFVAL(Dictionary()), DEFVAL(Ref<Resource>()));
+	ClassDB::bind_method(D_METHOD("is_capturing", "slot_name"), &SaveServer::is_capturing);
 	ClassDB::bind_method(D_METHOD("amend_save", "root", "slot_name"), &SaveServer::amend_save);
 
+	ClassDB::bind_method(D_METHOD("get_slot_versions", "slot_name"), &SaveServer::get_slot_versions);
+	ClassDB::bind_method(D_METHOD("load_slot_version", "slot_name", "version"), &SaveServer::load_slot_version);
+	ClassDB::bind_method(D_METHOD("restore_slot_version", "slot_name", "version"), &SaveServer::restore_slot_version);
+
 	ClassDB::bind_method(D_METHOD("register_id", "id", "obj_id"), &SaveServer::register_id);
 	ClassDB::bind_method(D_METHOD("unregister_id", "id"), &SaveServer::unregister_id);
 	ClassDB::bind_method(D_METHOD("get_object_by_id", "id"), &SaveServer::get_object_by_id);
@@ -101,22 +122,30 @@ void SaveServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_backups", "max"), &SaveServer::set_max_backups);
 	ClassDB::bind_method(D_METHOD("get_max_backups"), &SaveServer::get_max_backups);
 
+	ClassDB::bind_method(D_METHOD("set_capture_budget_usec", "usec"), &SaveServer::set_capture_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_capture_budget_usec"), &SaveServer::get_capture_budget_usec);
+	ClassDB::bind_method(D_METHOD("set_restore_budget_usec", "usec"), &SaveServer::set_restore_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_restore_budget_usec"), &SaveServer::get_restore_budget_usec);
+
 	ClassDB::bind_method(D_METHOD("set_integrity_check_level", "level"), &SaveServer::set_integrity_check_level);
 	ClassDB::bind_method(D_METHOD("get_integrity_check_level"), &SaveServer::get_integrity_check_level);
 
 	ClassDB::bind_method(D_METHOD("set_save_path", "path"), &SaveServer::set_save_path);
 	ClassDB::bind_method(D_METHOD("get_save_path"), &SaveServer::get_save_path);
 
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "save_format", PROPERTY_HINT_ENUM, "Text,Binary"), "set_save_format", "get_save_format");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "save_format", PROPERTY_HINT_ENUM, "Text,Binary,Packed"), "set_save_format", "get_save_format");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "encryption_key"), "set_encryption_key", "get_encryption_key");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "backup_enabled"), "set_backup_enabled", "is_backup_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_backups"), "set_max_backups", "get_max_backups");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "capture_budget_usec", PROPERTY_HINT_RANGE, "100,100000,1,or_greater,suffix:µs"), "set_capture_budget_usec", "get_capture_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "restore_budget_usec", PROPERTY_HINT_RANGE, "100,100000,1,or_greater,suffix:µs"), "set_restore_budget_usec", "get_restore_budget_usec");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "integrity_check_level", PROPERTY_HINT_ENUM, "None,Signature,Strict"), "set_integrity_check_level", "get_integrity_check_level");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "save_path"), "set_save_path", "get_save_path");
 
 	BIND_ENUM_CONSTANT(FORMAT_TEXT);
 	BIND_ENUM_CONSTANT(FORMAT_BINARY);
+	BIND_ENUM_CONSTANT(FORMAT_PACKED);
 
 	BIND_ENUM_CONSTANT(INTEGRITY_NONE);
 	BIND_ENUM_CONSTANT(INTEGRITY_SIGNATURE);
@@ -133,6 +162,8 @@ void SaveServer::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("save_corrupted", PropertyInfo(Variant::STRING, "slot_name")));
 	ADD_SIGNAL(MethodInfo("backup_restored", PropertyInfo(Variant::STRING, "slot_name"), PropertyInfo(Variant::STRING, "file_path")));
 	ADD_SIGNAL(MethodInfo("save_successful", PropertyInfo(Variant::STRING, "slot_name")));
+	ADD_SIGNAL(MethodInfo("snapshot_captured", PropertyInfo(Variant::STRING, "slot_name")));
+	ADD_SIGNAL(MethodInfo("load_progress", PropertyInfo(Variant::STRING, "slot_name"), PropertyInfo(Variant::INT, "restored"), PropertyInfo(Variant::INT, "total")));
 }
 
 void SaveServer::_queue_save_task(const String &p_slot_name, Ref<Snapshot> p_snapshot, bool p_async) {
@@ -143,10 +174,11 @@ void SaveServer::_queue_save_task(const String &p_slot_name, Ref<Snapshot> p_sna
 	task.format = current_format;
 	task.encryption_key = encryption_key;
 	task.compression_enabled = compression_enabled;
+	task.checksum_algorithm = _get_checksum_algorithm();
 
 	if (p_async) {
 		MutexLock lock(mutex);
-		queue.push_back(task);
+		_push_task(task);
 		semaphore.post();
 	} else {
 		_save_to_disk(task);
@@ -157,6 +189,13 @@ void SaveServer::save_slot(const String &p_slot_name, const Dictionary &p_data,
 	String slot_name = _sanitize_slot_name(p_slot_name);
 	ERR_FAIL_COND_MSG(slot_name.is_empty(), "Slot name cannot be empty.");
 
+	_save_slot(slot_name, p_data, p_async, p_metadata, p_thumbnail);
+
+	// Update base snapshot for amend saves if full save succeeds
+	_set_base_snapshot(slot_name, p_data); // Always update the base on full save
+}
+
+void SaveServer::_save_slot(const String &p_slot_name, const Dictionary &p_data, bool p_async, const Dictionary &p_metadata, const Ref<Resource> &p_thumbnail) {
 	// Create Snapshot resource with reference counting (no deep copy needed)
 	Ref<Snapshot> snapshot_res;
 	snapshot_res.instantiate();
@@ -168,17 +207,18 @@ void SaveServer::save_slot(const String &p_slot_name, const Dictionary &p_data,
 	String project_version = GLOBAL_GET("application/config/version");
 	snapshot_res->set_version(project_version);
 
-	// Calculate and set checksum
-	snapshot_res->set_checksum(_calculate_checksum(p_data));
+	_queue_save_task(p_slot_name, snapshot_res, p_async);
+}
 
-	// Update base snapshot for amend saves if full save succeeds
+void SaveServer::_set_base_snapshot(const String &p_slot_name, const Dictionary &p_data) {
 	if (base_snapshot.is_null()) {
 		base_snapshot.instantiate();
 	}
-	base_snapshot->set_snapshot(p_data); // Always update the base on full save
-	current_slot_name = slot_name;
+	base_snapshot->set_snapshot(p_data);
+	current_slot_name = p_slot_name;
 
-	_queue_save_task(slot_name, snapshot_res, p_async);
+	// Index records by persistence ID so amends don't depend on node paths.
+	record_index.build(p_data);
 }
 
 Dictionary SaveServer::load_slot(const String &p_slot_name) {
@@ -190,13 +230,19 @@ bool SaveServer::has_slot(const String &p_slot_name) const {
 	String slot_name = _sanitize_slot_name(p_slot_name);
 	String res_path = save_path.path_join(slot_name + ".tres");
 	String data_path = save_path.path_join(slot_name + ".data");
-	return FileAccess::exists(res_path) || FileAccess::exists(data_path);
+	String packed_path = save_path.path_join(slot_name + ".snap");
+	return FileAccess::exists(res_path) || FileAccess::exists(data_path) || FileAccess::exists(packed_path);
 }
 
 void SaveServer::delete_slot(const String &p_slot_name) {
 	String slot_name = _sanitize_slot_name(p_slot_name);
 	String res_path = save_path.path_join(slot_name + ".tres");
 	String data_path = save_path.path_join(slot_name + ".data");
+	String packed_path = save_path.path_join(slot_name + ".snap");
+	String journal_path = _get_journal_path(slot_name);
+	if (FileAccess::exists(journal_path)) {
+		DirAccess::remove_absolute(journal_path);
+	}
 	if (FileAccess::exists(res_path)) {
 		DirAccess::remove_absolute(res_path);
 		DirAccess::remove_absolute(res_path + ".bak");
@@ -205,24 +251,22 @@ void SaveServer::delete_slot(const String &p_slot_name) {
 		DirAccess::remove_absolute(data_path);
 		DirAccess::remove_absolute(data_path + ".bak");
 	}
+	if (FileAccess::exists(packed_path)) {
+		DirAccess::remove_absolute(packed_path);
+		DirAccess::remove_absolute(packed_path + ".bak");
+	}
 }
 
 void SaveServer::delete_snapshot(const String &p_snapshot_name) {
 	String main_slot = _sanitize_slot_name(p_snapshot_name);
-	String path = save_path.path_join(main_slot);
-	String ext = get_save_format() == FORMAT_TEXT ? ".tres" : ".data";
-
-	if (FileAccess::exists(path + ext)) {
-		Ref<Resource> res = ResourceLoader::load(path + ext);
-		Ref<Snapshot> snapshot_res = res;
-
-		if (snapshot_res.is_valid()) {
-			Dictionary tag_slots = snapshot_res->get_tag_slots();
-			Array tags = tag_slots.keys();
-			for (int i = 0; i < tags.size(); i++) {
-				String tagged_slot = tag_slots[tags[i]];
-				delete_slot(tagged_slot);
-			}
+
+	Ref<Snapshot> snapshot_res = _read_snapshot_from_disk(main_slot);
+	if (snapshot_res.is_valid()) {
+		Dictionary tag_slots = snapshot_res->get_tag_slots();
+		Array tags = tag_slots.keys();
+		for (int i = 0; i < tags.size(); i++) {
+			String tagged_slot = tag_slots[tags[i]];
+			delete_slot(tagged_slot);
 		}
 	}
 
@@ -234,14 +278,23 @@ bool SaveServer::save_snapshot(Node *p_root, const String &p_slot_name, bool p_a
 	p_root->propagate_notification(Node::NOTIFICATION_SAVE_PREPARE);
 
 	String main_slot = _sanitize_slot_name(p_slot_name);
-	TypedArray<StringName> tags_to_process = p_tags;
 
-	// 1. If tags are empty, we need to discover ALL tags in the tree
-	Dictionary full_snapshot = _save_node_recursive(p_root, TypedArray<StringName>()); // Get everything
+	// Capture everything, tags are split into satellites when committing
+	Dictionary full_snapshot = _save_node_recursive(p_root, TypedArray<StringName>());
+
+	_commit_snapshot(main_slot, full_snapshot, p_tags, p_metadata, p_thumbnail, p_async);
+
+	p_root->propagate_notification(Node::NOTIFICATION_SAVE_COMPLETED);
+	return true;
+}
+
+void SaveServer::_commit_snapshot(const String &p_main_slot, const Dictionary &p_full_snapshot, const TypedArray<StringName> &p_tags, const Dictionary &p_metadata, const Ref<Resource> &p_thumbnail, bool p_async) {
+	TypedArray<StringName> tags_to_process = p_tags;
 
+	// If tags are empty, we need to discover ALL tags in the tree
 	if (tags_to_process.is_empty()) {
 		// Discover tags from the root level of the snapshot (keys that don't start with '.')
-		Array keys = full_snapshot.keys();
+		Array keys = p_full_snapshot.keys();
 		for (int i = 0; i < keys.size(); i++) {
 			String key = keys[i];
 			if (!key.begins_with(".")) {
@@ -250,13 +303,8 @@ bool SaveServer::save_snapshot(Node *p_root, const String &p_slot_name, bool p_a
 		}
 	}
 
-	// 2. Identify/Load Manifest
-	Ref<Snapshot> manifest;
-	String path = get_save_path().path_join(main_slot);
-	String ext = get_save_format() == FORMAT_TEXT ? ".tres" : ".data";
-	if (FileAccess::exists(path + ext)) {
-		manifest = ResourceLoader::load(path + ext);
-	}
+	// 1. Identify/Load Manifest
+	Ref<Snapshot> manifest = _read_snapshot_from_disk(p_main_slot);
 	if (manifest.is_null()) {
 		manifest.instantiate();
 	}
@@ -264,20 +312,20 @@ bool SaveServer::save_snapshot(Node *p_root, const String &p_slot_name, bool p_a
 	Dictionary tag_slots = manifest->get_tag_slots();
 	bool manifest_changed = false;
 
-	// 3. Process each tag into its own satellite
+	// 2. Process each tag into its own satellite
 	for (int i = 0; i < tags_to_process.size(); i++) {
 		StringName tag = tags_to_process[i];
-		String satellite_slot = (tag == SNAME("general")) ? main_slot : main_slot + "_" + String(tag);
+		String satellite_slot = (tag == SNAME("general")) ? p_main_slot : p_main_slot + "_" + String(tag);
 
-		Dictionary tag_data = _filter_snapshot_by_tag(full_snapshot, tag);
+		Dictionary tag_data = _filter_snapshot_by_tag(p_full_snapshot, tag);
 
 		if (tag == SNAME("general")) {
-			// Main slot also carries the checksum and version
+			// Main slot also carries the version, the checksum is set when it's written.
 			manifest->set_snapshot(tag_data);
 			manifest->set_version(GLOBAL_GET("application/config/version"));
-			manifest->set_checksum(_calculate_checksum(tag_data));
 		} else {
-			save_slot(satellite_slot, tag_data, p_async);
+			// The base snapshot is set once for the whole capture below, not per satellite.
+			_save_slot(_sanitize_slot_name(satellite_slot), tag_data, p_async);
 			if (!tag_slots.has(tag)) {
 				tag_slots[tag] = satellite_slot;
 				manifest_changed = true;
@@ -285,7 +333,7 @@ bool SaveServer::save_snapshot(Node *p_root, const String &p_slot_name, bool p_a
 		}
 	}
 
-	// 4. Update Manifest metadata
+	// 3. Update Manifest metadata
 	if (!p_metadata.is_empty()) {
 		manifest->set_metadata(p_metadata);
 		manifest_changed = true;
@@ -297,13 +345,174 @@ bool SaveServer::save_snapshot(Node *p_root, const String &p_slot_name, bool p_a
 
 	if (manifest_changed || p_tags.is_empty()) {
 		manifest->set_tag_slots(tag_slots);
-		_queue_save_task(main_slot, manifest, p_async);
+		_queue_save_task(p_main_slot, manifest, p_async);
+	}
+
+	// Amends target the main slot, against the whole snapshot (satellites included).
+	_set_base_snapshot(p_main_slot, p_full_snapshot);
+}
+
+bool SaveServer::save_snapshot_sliced(Node *p_root, const String &p_slot_name, const TypedArray<StringName> &p_tags, const Dictionary &p_metadata, Ref<Resource> p_thumbnail) {
+	ERR_FAIL_NULL_V(p_root, false);
+	ERR_FAIL_COND_V_MSG(!p_root->is_inside_tree(), false, "SaveServer: Sliced captures are driven by the SceneTree, the root must be inside it.");
+
+	String main_slot = _sanitize_slot_name(p_slot_name);
+
+	// A newer capture of the same slot supersedes the pending one, which completes without saving.
+	for (List<CaptureJob>::Element *E = capture_jobs.front(); E; E = E->next()) {
+		if (E->get().slot_name == main_slot) {
+			Node *previous_root = ObjectDB::get_instance<Node>(E->get().root_id);
+			capture_jobs.erase(E);
+			if (previous_root) {
+				previous_root->propagate_notification(Node::NOTIFICATION_SAVE_COMPLETED);
+			}
+			break;
+		}
+	}
+
+	p_root->propagate_notification(Node::NOTIFICATION_SAVE_PREPARE);
+
+	CaptureJob job;
+	job.slot_name = main_slot;
+	job.root_id = p_root->get_instance_id();
+	job.tags = p_tags;
+	job.metadata = p_metadata;
+	job.thumbnail = p_thumbnail;
+
+	CaptureJob::Entry root_entry;
+	root_entry.node = job.root_id;
+	root_entry.data = _capture_node(p_root, TypedArray<StringName>());
+	job.result = root_entry.data;
+	job.entries.push_back(root_entry);
+
+	// Listing the nodes is cheap compared to capturing them, so it's done at once.
+	LocalVector<Node *> stack;
+	LocalVector<uint32_t> stack_entries;
+	stack.push_back(p_root);
+	stack_entries.push_back(0);
+	while (!stack.is_empty()) {
+		Node *node = stack[stack.size() - 1];
+		uint32_t parent = stack_entries[stack_entries.size() - 1];
+		stack.resize(stack.size() - 1);
+		stack_entries.resize(stack_entries.size() - 1);
+
+		for (int i = 0; i < node->get_child_count(false); i++) {
+			Node *child = node->get_child(i, false); // Exclude internal nodes
+			if (child->get_save_policy() == Node::SAVE_POLICY_NEVER) {
+				continue;
+			}
+			CaptureJob::Entry entry;
+			entry.node = child->get_instance_id();
+			entry.name = child->get_name();
+			entry.parent = parent;
+			job.entries.push_back(entry);
+			stack.push_back(child);
+			stack_entries.push_back(job.entries.size() - 1);
+		}
+	}
+
+	capture_jobs.push_back(job);
+
+	SceneTree *tree = p_root->get_tree();
+	Callable process = callable_mp(this, &SaveServer::_process_captures);
+	if (!tree->is_connected(SNAME("process_frame"), process)) {
+		tree->connect(SNAME("process_frame"), process);
+	}
+	return true;
+}
+
+bool SaveServer::is_capturing(const String &p_slot_name) const {
+	String slot_name = _sanitize_slot_name(p_slot_name);
+	for (const CaptureJob &job : capture_jobs) {
+		if (job.slot_name == slot_name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SaveServer::_process_captures() {
+	// All pending captures share the frame budget, oldest first.
+	uint64_t deadline = OS::get_singleton()->get_ticks_usec() + capture_budget_usec;
+
+	while (!capture_jobs.is_empty()) {
+		CaptureJob &job = capture_jobs.front()->get();
+		if (!_step_capture(job, deadline)) {
+			return; // Out of budget, resume next frame.
+		}
+
+		_finish_capture(job);
+		capture_jobs.pop_front();
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	Callable process = callable_mp(this, &SaveServer::_process_captures);
+	if (tree && tree->is_connected(SNAME("process_frame"), process)) {
+		tree->disconnect(SNAME("process_frame"), process);
+	}
+}
+
+bool SaveServer::_step_capture(CaptureJob &p_job, uint64_t p_deadline) {
+	// Sliced version of _save_node_recursive(), returns true once every listed node is captured.
+	OS *os = OS::get_singleton();
+	uint32_t visited = 0;
+
+	for (; p_job.next_entry < p_job.entries.size(); p_job.next_entry++) {
+		if ((++visited & 15) == 0 && os->get_ticks_usec() >= p_deadline) {
+			return false;
+		}
+
+		CaptureJob::Entry &entry = p_job.entries[p_job.next_entry];
+		Node *node = ObjectDB::get_instance<Node>(entry.node);
+		if (!node || p_job.entries[entry.parent].skipped) {
+			entry.skipped = true;
+			continue;
+		}
+
+		entry.data = _capture_node(node, TypedArray<StringName>());
 	}
 
-	p_root->propagate_notification(Node::NOTIFICATION_SAVE_COMPLETED);
 	return true;
 }
 
+void SaveServer::_finish_capture(CaptureJob &p_job) {
+	Node *root = ObjectDB::get_instance<Node>(p_job.root_id);
+	if (!root) {
+		WARN_PRINT("SaveServer: Root node freed during sliced capture, discarding snapshot for slot: " + p_job.slot_name);
+		return;
+	}
+
+	// Every node holds the values it had when it was visited. Changes made afterwards are
+	// not captured again, they are left staged for the next amend_save().
+
+	// Assemble the tree. Children come after their parent, so walking backwards finds
+	// which subtrees have anything to save, then walking forwards keeps the child order.
+	LocalVector<bool> kept;
+	kept.resize_initialized(p_job.entries.size());
+	for (uint32_t i = p_job.entries.size() - 1; i > 0; i--) {
+		const CaptureJob::Entry &entry = p_job.entries[i];
+		if (!entry.skipped && (kept[i] || !entry.data.is_empty())) {
+			kept[i] = true;
+			kept[entry.parent] = true;
+		}
+	}
+	for (uint32_t i = 1; i < p_job.entries.size(); i++) {
+		if (!kept[i]) {
+			continue;
+		}
+		CaptureJob::Entry &parent = p_job.entries[p_job.entries[i].parent];
+		if (parent.children.is_empty()) {
+			parent.data[".children"] = parent.children;
+		}
+		parent.children[p_job.entries[i].name] = p_job.entries[i].data;
+	}
+
+	_commit_snapshot(p_job.slot_name, p_job.result, p_job.tags, p_job.metadata, p_job.thumbnail, true);
+
+	root->propagate_notification(Node::NOTIFICATION_SAVE_COMPLETED);
+	emit_signal(SNAME("snapshot_captured"), p_job.slot_name);
+}
+
 void SaveServer::load_snapshot(Node *p_root, const String &p_slot_name, const Callable &p_callback, bool p_dynamic_respawn) {
 	ERR_FAIL_NULL(p_root);
 
@@ -323,6 +532,48 @@ void SaveServer::load_snapshot(Node *p_root, const String &p_slot_name, const Ca
 	semaphore.post();
 }
 
+void SaveServer::load_snapshot_batched(Node *p_root, const String &p_slot_name, const Callable &p_callback, bool p_dynamic_respawn) {
+	ERR_FAIL_NULL(p_root);
+	ERR_FAIL_COND_MSG(!p_root->is_inside_tree(), "SaveServer: Batched loads are driven by the SceneTree, the root must be inside it.");
+
+	String slot_name = _sanitize_slot_name(p_slot_name);
+
+	SaveTask task;
+	task.type = TASK_LOAD;
+	task.slot_name = slot_name;
+	task.target_node_id = p_root->get_instance_id();
+	task.user_callback = p_callback;
+	task.dynamic_respawn = p_dynamic_respawn;
+	task.batched = true;
+
+	{
+		MutexLock lock(mutex);
+		queue.push_back(task);
+	}
+	semaphore.post();
+}
+
+void SaveServer::load_snapshot_subtrees(Node *p_root, const String &p_slot_name, const TypedArray<StringName> &p_subtrees, const Callable &p_callback, bool p_dynamic_respawn) {
+	ERR_FAIL_NULL(p_root);
+	ERR_FAIL_COND_MSG(p_subtrees.is_empty(), "SaveServer: No subtree to load, use load_snapshot() to restore the whole slot.");
+
+	String slot_name = _sanitize_slot_name(p_slot_name);
+
+	SaveTask task;
+	task.type = TASK_LOAD;
+	task.slot_name = slot_name;
+	task.target_node_id = p_root->get_instance_id();
+	task.user_callback = p_callback;
+	task.dynamic_respawn = p_dynamic_respawn;
+	task.subtrees = p_subtrees;
+
+	{
+		MutexLock lock(mutex);
+		queue.push_back(task);
+	}
+	semaphore.post();
+}
+
 void SaveServer::_finish_load_async(const String &p_slot_name, ObjectID p_node_id, const Dictionary &p_data, const Callable &p_callback, bool p_dynamic_respawn) {
 	Object *obj = ObjectDB::get_instance(p_node_id);
 	Node *root = Object::cast_to<Node>(obj);
@@ -330,11 +581,7 @@ void SaveServer::_finish_load_async(const String &p_slot_name, ObjectID p_node_i
 	if (root) {
 		if (!p_data.is_empty()) {
 			// Update base snapshot context for amend saves
-			if (base_snapshot.is_null()) {
-				base_snapshot.instantiate();
-			}
-			base_snapshot->set_snapshot(p_data);
-			current_slot_name = p_slot_name;
+			_set_base_snapshot(p_slot_name, p_data);
 
 			root->propagate_notification(Node::NOTIFICATION_LOAD_STARTED);
 			_load_node_recursive(root, p_data, p_dynamic_respawn);
@@ -349,6 +596,318 @@ void SaveServer::_finish_load_async(const String &p_slot_name, ObjectID p_node_i
 	}
 }
 
+void SaveServer::_finish_load_batched(const String &p_slot_name, ObjectID p_node_id, const Dictionary &p_data, const Callable &p_callback, bool p_dynamic_respawn) {
+	Node *root = ObjectDB::get_instance<Node>(p_node_id);
+	if (!root || !root->is_inside_tree() || p_data.is_empty()) {
+		if (root && p_data.is_empty()) {
+			WARN_PRINT("SaveServer: Async load returned empty data (or file missing).");
+		}
+		if (p_callback.is_valid()) {
+			p_callback.call();
+		}
+		return;
+	}
+
+	// Update base snapshot context for amend saves
+	_set_base_snapshot(p_slot_name, p_data);
+
+	root->propagate_notification(Node::NOTIFICATION_LOAD_STARTED);
+
+	RestoreJob job;
+	job.slot_name = p_slot_name;
+	job.root_id = p_node_id;
+	job.callback = p_callback;
+	job.dynamic_respawn = p_dynamic_respawn;
+
+	// Nodes are only resolved while restoring, which also requests the scenes to spawn.
+	job.total = _count_records(p_data);
+
+	RestoreJob::Frame frame;
+	frame.node = p_node_id;
+	frame.data = p_data;
+	job.stack.push_back(frame);
+	restore_jobs.push_back(job);
+
+	SceneTree *tree = root->get_tree();
+	Callable process = callable_mp(this, &SaveServer::_process_restores);
+	if (!tree->is_connected(SNAME("process_frame"), process)) {
+		tree->connect(SNAME("process_frame"), process);
+	}
+}
+
+void SaveServer::_process_restores() {
+	// All pending restores share the frame budget, oldest first.
+	uint64_t deadline = OS::get_singleton()->get_ticks_usec() + restore_budget_usec;
+
+	while (!restore_jobs.is_empty()) {
+		RestoreJob &job = restore_jobs.front()->get();
+		bool scenes_loaded = _poll_restore_scenes(job);
+
+		Node *root = ObjectDB::get_instance<Node>(job.root_id);
+		if (!root) {
+			if (!scenes_loaded) {
+				return; // Threaded requests are released once fetched.
+			}
+			WARN_PRINT("SaveServer: Root node freed during batched load, discarding the rest of slot: " + job.slot_name);
+			restore_jobs.pop_front();
+			continue;
+		}
+
+		bool done = _step_restore(job, deadline);
+		emit_signal(SNAME("load_progress"), job.slot_name, done ? job.total : MIN(job.restored, job.total), job.total);
+		if (!done || !_poll_restore_scenes(job)) {
+			return; // Out of budget or waiting for a scene, resume next frame.
+		}
+
+		root->propagate_notification(Node::NOTIFICATION_LOAD_COMPLETED);
+		Callable callback = job.callback;
+		restore_jobs.pop_front();
+		if (callback.is_valid()) {
+			callback.call();
+		}
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	Callable process = callable_mp(this, &SaveServer::_process_restores);
+	if (tree && tree->is_connected(SNAME("process_frame"), process)) {
+		tree->disconnect(SNAME("process_frame"), process);
+	}
+}
+
+void SaveServer::_request_restore_scene(RestoreJob &p_job, const String &p_path) {
+	if (p_job.requested_scenes.has(p_path)) {
+		return;
+	}
+	p_job.requested_scenes.insert(p_path);
+	// Failed requests fall back to a regular load when spawning.
+	if (ResourceLoader::load_threaded_request(p_path, "PackedScene") == OK) {
+		p_job.pending_scenes.push_back(p_path);
+	}
+}
+
+bool SaveServer::_poll_restore_scenes(RestoreJob &p_job) {
+	for (uint32_t i = 0; i < p_job.pending_scenes.size();) {
+		const String &path = p_job.pending_scenes[i];
+		ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(path);
+		if (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+			i++;
+			continue;
+		}
+
+		// Loaded or failed, fetching also releases the request. Failures are reported when spawning.
+		Ref<PackedScene> scene = ResourceLoader::load_threaded_get(path);
+		if (scene.is_valid()) {
+			p_job.scenes[path] = scene;
+		}
+		p_job.pending_scenes.remove_at_unordered(i);
+	}
+	return p_job.pending_scenes.is_empty();
+}
+
+bool SaveServer::_step_restore(RestoreJob &p_job, uint64_t p_deadline) {
+	// Iterative version of _load_node_recursive(), returns true once the whole snapshot is restored.
+	OS *os = OS::get_singleton();
+	uint32_t visited = 0;
+
+	while (!p_job.stack.is_empty()) {
+		if ((++visited & 3) == 0 && os->get_ticks_usec() >= p_deadline) {
+			return false;
+		}
+
+		RestoreJob::Frame &frame = p_job.stack[p_job.stack.size() - 1];
+		Node *node = ObjectDB::get_instance<Node>(frame.node);
+		if (!node) {
+			// Freed meanwhile, its records are dropped.
+			p_job.stack.resize(p_job.stack.size() - 1);
+			continue;
+		}
+
+		if (!frame.applied) {
+			frame.applied = true;
+			p_job.restored++;
+
+			// Restore this node
+			node->set_persistent_properties(frame.data);
+
+			if (frame.data.has(".children")) {
+				frame.children = frame.data[".children"];
+				frame.child_names = frame.children.keys();
+
+				// Orphan Cleanup: Remove nodes that exist in the scene but are missing from the snapshot
+				if (p_job.dynamic_respawn) {
+					HashSet<StringName> kept_children;
+					for (const KeyValue<Variant, Variant> &E : frame.children) {
+						kept_children.insert(E.key);
+					}
+					_remove_orphans(node, kept_children);
+				}
+
+				// Resolve children once instead of a node path lookup per record.
+				for (int i = 0; i < node->get_child_count(); i++) {
+					Node *child = node->get_child(i);
+					frame.existing[child->get_name()] = child->get_instance_id();
+				}
+
+				// Scenes of the missing children start loading on threads while the budget
+				// is spent on their siblings.
+				if (p_job.dynamic_respawn) {
+					for (const KeyValue<Variant, Variant> &E : frame.children) {
+						Dictionary child_snapshot = E.value;
+						if (child_snapshot.has(".scene") && !frame.existing.has(StringName(E.key))) {
+							_request_restore_scene(p_job, child_snapshot[".scene"]);
+						}
+					}
+				}
+			}
+			continue;
+		}
+
+		if (frame.next_child >= frame.child_names.size()) {
+			p_job.stack.resize(p_job.stack.size() - 1);
+			continue;
+		}
+
+		StringName child_name = frame.child_names[frame.next_child];
+		Dictionary child_snapshot = frame.children[child_name];
+
+		Node *child = nullptr;
+		HashMap<StringName, ObjectID>::ConstIterator E = frame.existing.find(child_name);
+		if (E) {
+			child = ObjectDB::get_instance<Node>(E->value);
+		}
+
+		if (!child && p_job.dynamic_respawn && p_job.pending_scenes.has(child_snapshot.get(".scene", String()))) {
+			if (!_poll_restore_scenes(p_job) && p_job.pending_scenes.has(child_snapshot[".scene"])) {
+				return false; // Still loading, this child is spawned on a later frame.
+			}
+		}
+		frame.next_child++;
+
+		// Dynamic Instantiation Logic
+		if (!child && child_snapshot.has(".scene") && p_job.dynamic_respawn) {
+			String scene_path = child_snapshot[".scene"];
+			Ref<PackedScene> scene;
+			HashMap<String, Ref<PackedScene>>::Iterator S = p_job.scenes.find(scene_path);
+			if (S) {
+				scene = S->value;
+			} else {
+				scene = ResourceLoader::load(scene_path);
+			}
+
+			if (scene.is_valid()) {
+				Node *instance = scene->instantiate();
+				if (instance) {
+					instance->set_name(child_name);
+					node->add_child(instance, true); // Force readable name
+					child = instance;
+#ifdef DEBUG_ENABLED
+					print_line(vformat("SaveServer: Dynamically spawned node '%s' from '%s'", child_name, scene_path));
+#endif
+				}
+			} else {
+				ERR_PRINT(vformat("SaveServer: Failed to load scene '%s' for dynamic spawn '%s'", scene_path, child_name));
+			}
+		}
+
+		if (child) {
+			RestoreJob::Frame child_frame;
+			child_frame.node = child->get_instance_id();
+			child_frame.data = child_snapshot;
+			p_job.stack.push_back(child_frame); // Invalidates `frame`.
+		} else {
+			// Node missing and no scene path to respawn. Data orphaned.
+			p_job.restored += _count_records(child_snapshot);
+		}
+	}
+
+	return true;
+}
+
+int SaveServer::_count_records(const Dictionary &p_data) {
+	int count = 1;
+	if (!p_data.has(".children")) {
+		return count;
+	}
+
+	Dictionary children_data = p_data[".children"];
+	for (const KeyValue<Variant, Variant> &E : children_data) {
+		count += _count_records(E.value);
+	}
+	return count;
+}
+
+void SaveServer::_finish_load_packed(const String &p_slot_name, ObjectID p_node_id, const Array &p_parts, const Callable &p_callback, bool p_dynamic_respawn, const TypedArray<StringName> &p_subtrees) {
+	Object *obj = ObjectDB::get_instance(p_node_id);
+	Node *root = Object::cast_to<Node>(obj);
+
+	if (root) {
+		// Packed snapshots are applied straight from their columns, without a base snapshot
+		// dictionary. Amends and deletions still find records by ID, so the index follows the slot.
+		if (p_subtrees.is_empty() || current_slot_name != p_slot_name) {
+			base_snapshot.unref();
+			record_index.clear();
+		}
+		current_slot_name = p_slot_name;
+		for (int i = 0; i < p_parts.size(); i++) {
+			Ref<PackedSnapshot> packed = p_parts[i];
+			if (packed.is_valid()) {
+				for (const PackedSnapshot::Chunk &chunk : packed->get_chunks()) {
+					record_index.add_packed_chunk(chunk);
+				}
+			}
+		}
+
+		root->propagate_notification(Node::NOTIFICATION_LOAD_STARTED);
+
+		// Orphan cleanup must consider the children of all parts (manifest and satellites).
+		HashMap<Node *, HashSet<StringName>> kept_children;
+		if (!p_subtrees.is_empty() && p_dynamic_respawn) {
+			// Partial load: only the requested subtrees of the root may be cleaned up.
+			HashSet<StringName> requested;
+			for (int i = 0; i < p_subtrees.size(); i++) {
+				requested.insert(p_subtrees[i]);
+			}
+			HashSet<StringName> &kept = kept_children[root];
+			for (int i = 0; i < root->get_child_count(); i++) {
+				StringName child_name = root->get_child(i)->get_name();
+				if (!requested.has(child_name)) {
+					kept.insert(child_name);
+				}
+			}
+		}
+		for (int i = 0; i < p_parts.size(); i++) {
+			Ref<PackedSnapshot> packed = p_parts[i];
+			if (packed.is_valid()) {
+				_load_packed_snapshot(root, packed, p_dynamic_respawn, kept_children);
+			}
+		}
+
+		if (p_dynamic_respawn) {
+			for (const KeyValue<Node *, HashSet<StringName>> &E : kept_children) {
+				_remove_orphans(E.key, E.value);
+			}
+		}
+
+		root->propagate_notification(Node::NOTIFICATION_LOAD_COMPLETED);
+	}
+
+	if (p_callback.is_valid()) {
+		p_callback.call();
+	}
+}
+
+String SaveServer::_get_format_extension(SaveFormat p_format) {
+	switch (p_format) {
+		case FORMAT_TEXT:
+			return ".tres";
+		case FORMAT_BINARY:
+			return ".data";
+		case FORMAT_PACKED:
+			return ".snap";
+	}
+	return ".data";
+}
+
 Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 #ifdef DEBUG_ENABLED
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
@@ -356,7 +915,7 @@ Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 
 	// Determine extension and format based on settings
 	SaveFormat format = p_task.format;
-	String ext = (format == FORMAT_TEXT) ? ".tres" : ".data";
+	String ext = _get_format_extension(format);
 	String full_path = save_path.path_join(p_task.slot_name + ext);
 	String temp_path = full_path + ".tmp";
 
@@ -373,6 +932,9 @@ Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 	Error err = OK;
 
 	if (format == FORMAT_TEXT) {
+		// Text has no binary encoding to hash as it's written, so the values are walked here instead.
+		snapshot_res->set_checksum(SnapshotHasher::hash_variant(snapshot_res->get_snapshot(), p_task.checksum_algorithm));
+
 		// Write to temp file first
 		err = ResourceSaver::save(snapshot_res, temp_path);
 	} else {
@@ -386,7 +948,10 @@ Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 		bool should_compress = compress && (estimated_size > 4096);
 
 		Ref<FileAccess> f;
-		if (!key.is_empty()) {
+		if (format == FORMAT_PACKED) {
+			// Packed files compress and encrypt each chunk themselves so they stay seekable.
+			f = FileAccess::open(temp_path, FileAccess::WRITE);
+		} else if (!key.is_empty()) {
 			f = FileAccess::open_encrypted_pass(temp_path, FileAccess::WRITE, key);
 		} else if (should_compress) {
 			f = FileAccess::open_compressed(temp_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
@@ -395,7 +960,14 @@ Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 		}
 
 		ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, "Cannot open save file for writing: " + temp_path);
-		f->store_var(snapshot_res, true); // Serialize full Snapshot object
+
+		// Verified by the hashes written along with the encoding, not the snapshot checksum.
+		snapshot_res->set_checksum(String());
+		if (format == FORMAT_PACKED) {
+			err = _write_packed_file(f, snapshot_res, key, compress, p_task.checksum_algorithm);
+		} else {
+			err = _write_binary_file(f, snapshot_res, p_task.checksum_algorithm);
+		}
 		f->close();
 	}
 
@@ -410,6 +982,12 @@ Error SaveServer::_save_to_disk(const SaveTask &p_task) {
 	// This will overwrite the existing file atomically on most filesystems
 	da->rename(temp_path, full_path);
 
+	// The new file supersedes any amend journaled against the previous one.
+	String journal_path = _get_journal_path(p_task.slot_name);
+	if (FileAccess::exists(journal_path)) {
+		da->remove(journal_path);
+	}
+
 	// Notify success
 	call_deferred("emit_signal", "save_successful", p_task.slot_name);
 
@@ -438,32 +1016,18 @@ void SaveServer::_merge_dictionaries_recursive(Dictionary &p_target, const Dicti
 }
 
 Dictionary SaveServer::_load_from_disk(const String &p_slot_name) {
-	Ref<Snapshot> snapshot_res = _read_snapshot_from_disk(p_slot_name);
+	bool verified = false;
+	Ref<Snapshot> snapshot_res = _read_snapshot_from_disk(p_slot_name, &verified);
 
 	// Restore from backup if needed
 	if (snapshot_res.is_null() && backup_enabled) {
 		// 1. Try new timestamped backups
-		String backup_path = _get_latest_backup(p_slot_name);
-		if (!backup_path.is_empty()) {
-			if (backup_path.ends_with(".tres")) {
-				snapshot_res = ResourceLoader::load(backup_path);
-			} else if (backup_path.ends_with(".data")) {
-				String key = GLOBAL_GET("application/persistence/encryption_key");
-				Ref<FileAccess> f;
-				if (!key.is_empty()) {
-					f = FileAccess::open_encrypted_pass(backup_path, FileAccess::READ, key);
-				} else {
-					f = FileAccess::open_compressed(backup_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
-					if (f.is_null()) {
-						f = FileAccess::open(backup_path, FileAccess::READ);
-					}
-				}
-
-				if (f.is_valid()) {
-					Variant v = f->get_var(true);
-					f->close();
-					snapshot_res = v;
-				}
+		PackedStringArray versions = get_slot_versions(p_slot_name);
+		if (!versions.is_empty()) {
+			String backup_path = save_path.path_join("backups").path_join(p_slot_name + "_" + versions[versions.size() - 1]);
+			{
+				MutexLock lock(backup_mutex);
+				snapshot_res = _read_backup(p_slot_name, versions[versions.size() - 1], &verified);
 			}
 
 			if (snapshot_res.is_valid()) {
@@ -475,7 +1039,7 @@ Dictionary SaveServer::_load_from_disk(const String &p_slot_name) {
 
 		// 2. Fallback to legacy backup (.bak)
 		if (snapshot_res.is_null()) {
-			snapshot_res = _read_snapshot_from_disk(p_slot_name + ".bak");
+			snapshot_res = _read_snapshot_from_disk(p_slot_name + ".bak", &verified);
 			if (snapshot_res.is_valid()) {
 				print_line("SaveServer: Main save corrupted or missing, restored from legacy backup: " + p_slot_name + ".bak");
 				call_deferred("emit_signal", "save_corrupted", p_slot_name);
@@ -488,10 +1052,9 @@ Dictionary SaveServer::_load_from_disk(const String &p_slot_name) {
 		return Dictionary();
 	}
 
-	// Integrity validation
-	if (integrity_level >= INTEGRITY_SIGNATURE) {
-		String calculated = _calculate_checksum(snapshot_res->get_snapshot());
-		if (calculated != snapshot_res->get_checksum()) {
+	// Integrity validation (binary and packed files are verified while they are read)
+	if (integrity_level >= INTEGRITY_SIGNATURE && !verified) {
+		if (!_verify_checksum(snapshot_res->get_snapshot(), snapshot_res->get_checksum())) {
 			WARN_PRINT("SaveServer: Integrity check failed (Signature mismatch) for slot: " + p_slot_name);
 			if (integrity_level == INTEGRITY_STRICT) {
 				ERR_PRINT("SaveServer: STRICT level active, rejecting save.");
@@ -504,6 +1067,9 @@ Dictionary SaveServer::_load_from_disk(const String &p_slot_name) {
 	_apply_migrations(snapshot_res);
 
 	Dictionary full_data = snapshot_res->get_snapshot();
+
+	// Amend saves journaled since the slot was last written
+	_replay_journal(p_slot_name, full_data);
 	Dictionary tag_slots = snapshot_res->get_tag_slots();
 
 	// 4. Merge satellite slots if present
@@ -522,10 +1088,166 @@ Dictionary SaveServer::_load_from_disk(const String &p_slot_name) {
 	return full_data;
 }
 
-Ref<Snapshot> SaveServer::_read_snapshot_from_disk(const String &p_slot_name) {
-	// Try text format first (.tres)
-	String res_path = save_path.path_join(p_slot_name);
-	if (!res_path.ends_with(".tres") && !res_path.ends_with(".data") && !res_path.ends_with(".bak")) {
+Ref<FileAccess> SaveServer::_open_binary_for_read(const String &p_path) const {
+	String key = GLOBAL_GET("application/persistence/encryption_key");
+	Ref<FileAccess> f;
+	if (!key.is_empty()) {
+		f = FileAccess::open_encrypted_pass(p_path, FileAccess::READ, key);
+	} else {
+		f = FileAccess::open_compressed(p_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+		if (f.is_null()) {
+			f = FileAccess::open(p_path, FileAccess::READ);
+		}
+	}
+	return f;
+}
+
+Ref<FileAccess> SaveServer::_open_packed_for_read(const String &p_path) const {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_valid() && PackedSnapshot::is_packed_file(f)) {
+		return f;
+	}
+	return Ref<FileAccess>();
+}
+
+Ref<PackedSnapshot> SaveServer::_read_packed_file(Ref<FileAccess> p_file, const HashSet<StringName> *p_subtrees) {
+	String key = GLOBAL_GET("application/persistence/encryption_key");
+	Ref<PackedSnapshot> packed;
+	packed.instantiate();
+	if (packed->load(p_file, key, integrity_level >= INTEGRITY_SIGNATURE, p_subtrees) != OK) {
+		return Ref<PackedSnapshot>();
+	}
+
+	if (!packed->is_checksum_valid()) {
+		WARN_PRINT("SaveServer: Integrity check failed (Signature mismatch) for file: " + p_file->get_path());
+		if (integrity_level == INTEGRITY_STRICT) {
+			ERR_PRINT("SaveServer: STRICT level active, rejecting save.");
+			return Ref<PackedSnapshot>();
+		}
+	}
+
+	return packed;
+}
+
+Error SaveServer::_write_packed_file(Ref<FileAccess> p_file, const Ref<Snapshot> &p_snapshot, const String &p_key, bool p_compress, SnapshotHasher::Algorithm p_algorithm) {
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(p_snapshot);
+	ERR_FAIL_COND_V(packed.is_null(), ERR_INVALID_DATA);
+	// Chunks are hashed as they're packed.
+	return packed->save(p_file, p_key, p_compress, p_algorithm == SnapshotHasher::ALGORITHM_SHA256);
+}
+
+Error SaveServer::_write_binary_file(Ref<FileAccess> p_file, const Ref<Snapshot> &p_snapshot, SnapshotHasher::Algorithm p_algorithm) {
+	// Serialize the full Snapshot object.
+	int len = 0;
+	Error err = encode_variant(p_snapshot, nullptr, len, true);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	encode_variant(p_snapshot, buffer.ptrw(), len, true);
+	p_file->store_32(len);
+
+	// The encoding is hashed block by block as it's stored, so loads can verify it as it's
+	// read (see _read_binary_file()) without walking the decoded snapshot.
+	SnapshotHasher hasher;
+	hasher.start(p_algorithm);
+	const uint8_t *r = buffer.ptr();
+	for (int offset = 0; offset < len;) {
+		int block_size = MIN(len - offset, 65536);
+		hasher.update(r + offset, block_size);
+		p_file->store_buffer(r + offset, block_size);
+		offset += block_size;
+	}
+	p_file->store_pascal_string(hasher.finish());
+	p_file->store_buffer(SNAPSHOT_CHECKSUM_MAGIC, 4);
+
+	return p_file->get_error() == OK || p_file->get_error() == ERR_FILE_EOF ? OK : ERR_FILE_CANT_WRITE;
+}
+
+Ref<Snapshot> SaveServer::_read_binary_file(Ref<FileAccess> p_file, bool *r_verified) {
+	uint32_t len = p_file->get_32();
+	uint64_t length = p_file->get_length();
+	ERR_FAIL_COND_V(4 + uint64_t(len) > length, Ref<Snapshot>());
+
+	// Files written before the checksum trailer end right after the snapshot,
+	// they are verified against their snapshot checksum once loaded instead.
+	String checksum;
+	SnapshotHasher::Algorithm algorithm = SnapshotHasher::ALGORITHM_XXH64;
+	bool has_checksum = false;
+	if (integrity_level >= INTEGRITY_SIGNATURE && 4 + uint64_t(len) + 8 <= length) {
+		p_file->seek(4 + uint64_t(len));
+		checksum = p_file->get_pascal_string();
+		uint8_t magic[4] = {};
+		p_file->get_buffer(magic, 4);
+		has_checksum = memcmp(magic, SNAPSHOT_CHECKSUM_MAGIC, 4) == 0 && SnapshotHasher::parse_algorithm(checksum, algorithm);
+		p_file->seek(4);
+	}
+
+	SnapshotHasher hasher;
+	hasher.start(algorithm);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	uint8_t *w = buffer.ptrw();
+	for (uint32_t offset = 0; offset < len;) {
+		uint32_t block_size = MIN(len - offset, 65536u);
+		ERR_FAIL_COND_V(p_file->get_buffer(w + offset, block_size) != block_size, Ref<Snapshot>());
+		if (has_checksum) {
+			hasher.update(w + offset, block_size);
+		}
+		offset += block_size;
+	}
+
+	if (has_checksum) {
+		if (hasher.finish() != checksum) {
+			WARN_PRINT("SaveServer: Integrity check failed (Signature mismatch) for file: " + p_file->get_path());
+			if (integrity_level == INTEGRITY_STRICT) {
+				ERR_PRINT("SaveServer: STRICT level active, rejecting save.");
+				return Ref<Snapshot>();
+			}
+		}
+		if (r_verified) {
+			*r_verified = true;
+		}
+	}
+
+	Variant v;
+	Error err = decode_variant(v, buffer.ptr(), len, nullptr, true);
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<Snapshot>(), "SaveServer: Cannot decode snapshot file: " + p_file->get_path());
+	return v;
+}
+
+Ref<Snapshot> SaveServer::_read_snapshot_file(const String &p_path, bool *r_verified) {
+	if (p_path.ends_with(".tres")) {
+		return ResourceLoader::load(p_path);
+	}
+
+	Ref<FileAccess> f = _open_packed_for_read(p_path);
+	if (f.is_valid()) {
+		Ref<PackedSnapshot> packed = _read_packed_file(f);
+		if (packed.is_null()) {
+			return Ref<Snapshot>();
+		}
+		if (r_verified) {
+			*r_verified = true;
+		}
+		return packed->to_snapshot();
+	}
+
+	f = _open_binary_for_read(p_path);
+	if (f.is_null()) {
+		return Ref<Snapshot>();
+	}
+
+	Ref<Snapshot> snapshot_res = _read_binary_file(f, r_verified);
+	f->close();
+	return snapshot_res;
+}
+
+Ref<Snapshot> SaveServer::_read_snapshot_from_disk(const String &p_slot_name, bool *r_verified) {
+	// Try text format first (.tres)
+	String res_path = save_path.path_join(p_slot_name);
+	if (!res_path.ends_with(".tres") && !res_path.ends_with(".data") && !res_path.ends_with(".snap") && !res_path.ends_with(".bak")) {
 		res_path += ".tres";
 	}
 
@@ -536,28 +1258,20 @@ Ref<Snapshot> SaveServer::_read_snapshot_from_disk(const String &p_slot_name) {
 		}
 	}
 
-	// Try binary format if not already tried (.data)
-	String data_path = save_path.path_join(p_slot_name);
-	if (!data_path.ends_with(".data") && !data_path.ends_with(".bak")) {
-		data_path += ".data";
-	}
-
-	if (FileAccess::exists(data_path)) {
-		String key = GLOBAL_GET("application/persistence/encryption_key");
-		Ref<FileAccess> f;
-		if (!key.is_empty()) {
-			f = FileAccess::open_encrypted_pass(data_path, FileAccess::READ, key);
-		} else {
-			f = FileAccess::open_compressed(data_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
-			if (f.is_null()) {
-				f = FileAccess::open(data_path, FileAccess::READ);
-			}
+	// Try binary formats if not already tried (.snap, then .data)
+	String base_path = save_path.path_join(p_slot_name);
+	if (base_path.ends_with(".data") || base_path.ends_with(".snap") || base_path.ends_with(".bak")) {
+		if (FileAccess::exists(base_path)) {
+			return _read_snapshot_file(base_path, r_verified);
 		}
+		return Ref<Snapshot>();
+	}
 
-		if (f.is_valid()) {
-			Variant v = f->get_var(true);
-			f->close();
-			Ref<Snapshot> res = v;
+	const char *binary_exts[] = { ".snap", ".data" };
+	for (const char *ext : binary_exts) {
+		String path = base_path + ext;
+		if (FileAccess::exists(path)) {
+			Ref<Snapshot> res = _read_snapshot_file(path, r_verified);
 			if (res.is_valid()) {
 				return res;
 			}
@@ -567,27 +1281,83 @@ Ref<Snapshot> SaveServer::_read_snapshot_from_disk(const String &p_slot_name) {
 	return Ref<Snapshot>();
 }
 
-String SaveServer::_calculate_checksum(const Dictionary &p_data) {
-	// Use MD5 streaming hash to avoid full serialization
-	// For integrity checking (not cryptographic security), MD5 is sufficient and much faster
+Array SaveServer::_load_packed_from_disk(const String &p_slot_name, const HashSet<StringName> *p_subtrees) {
+	// Returns the manifest followed by its satellites when the slot can be applied straight
+	// from the packed columns. Anything else (other formats, pending migrations, damaged parts)
+	// goes through the dictionary path, which also handles backups.
+	Array parts;
+
+	String path = save_path.path_join(p_slot_name + ".snap");
+	if (!FileAccess::exists(path) || FileAccess::exists(_get_journal_path(p_slot_name))) {
+		return Array();
+	}
+
+	String project_version = GLOBAL_GET("application/config/version");
+
+	Ref<FileAccess> f = _open_packed_for_read(path);
+	if (f.is_null()) {
+		return Array();
+	}
+	Ref<PackedSnapshot> manifest = _read_packed_file(f, p_subtrees);
+	if (manifest.is_null() || manifest->get_version() != project_version) {
+		return Array();
+	}
+	parts.push_back(manifest);
+
+	const Dictionary &tag_slots = manifest->get_tag_slots();
+	for (const KeyValue<Variant, Variant> &E : tag_slots) {
+		String satellite_path = save_path.path_join(String(E.value) + ".snap");
+		if (FileAccess::exists(_get_journal_path(E.value))) {
+			return Array();
+		}
+		if (!FileAccess::exists(satellite_path)) {
+			if (has_slot(E.value)) {
+				return Array();
+			}
+			continue;
+		}
+
+		Ref<FileAccess> sf = _open_packed_for_read(satellite_path);
+		if (sf.is_null()) {
+			return Array();
+		}
+		Ref<PackedSnapshot> satellite = _read_packed_file(sf, p_subtrees);
+		if (satellite.is_null() || satellite->get_version() != project_version) {
+			return Array();
+		}
+		parts.push_back(satellite);
+	}
+
+	return parts;
+}
+
+SnapshotHasher::Algorithm SaveServer::_get_checksum_algorithm() const {
+	// Strict checks use a cryptographic hash.
+	return integrity_level == INTEGRITY_STRICT ? SnapshotHasher::ALGORITHM_SHA256 : SnapshotHasher::ALGORITHM_XXH64;
+}
+
+bool SaveServer::_verify_checksum(const Dictionary &p_data, const String &p_checksum) const {
+	SnapshotHasher::Algorithm algorithm;
+	if (SnapshotHasher::parse_algorithm(p_checksum, algorithm)) {
+		return SnapshotHasher::hash_variant(p_data, algorithm) == p_checksum;
+	}
+
+	// Legacy checksum: MD5 over the stringified top-level values.
 	CryptoCore::MD5Context ctx;
 	ctx.start();
 
-	// Hash dictionary keys and values incrementally
-	Array keys = p_data.keys();
-	for (int i = 0; i < keys.size(); i++) {
-		String key_str = String(keys[i]);
-		ctx.update((const unsigned char *)key_str.utf8().get_data(), key_str.utf8().length());
+	for (const KeyValue<Variant, Variant> &E : p_data) {
+		CharString key_str = String(E.key).utf8();
+		ctx.update((const unsigned char *)key_str.get_data(), key_str.length());
 
-		Variant value = p_data[keys[i]];
-		String value_str = value.stringify();
-		ctx.update((const unsigned char *)value_str.utf8().get_data(), value_str.utf8().length());
+		CharString value_str = E.value.stringify().utf8();
+		ctx.update((const unsigned char *)value_str.get_data(), value_str.length());
 	}
 
 	unsigned char hash[16];
 	ctx.finish(hash);
 
-	return String::hex_encode_buffer(hash, 16);
+	return String::hex_encode_buffer(hash, 16) == p_checksum;
 }
 
 void SaveServer::register_migration(const String &p_from, const String &p_to, const Callable &p_callback) {
@@ -674,14 +1444,108 @@ void SaveServer::_process_queue() {
 			queue.pop_front();
 		}
 
-		if (task.type == TASK_SAVE) {
-			_save_to_disk(task);
+		if (task.type == TASK_SAVE || task.type == TASK_AMEND) {
+			_dispatch_write(task);
 		} else if (task.type == TASK_LOAD) {
+			// Loads observe every write queued before them.
+			_wait_for_writes();
+
+			if (task.batched) {
+				// Restored from the dictionary, packed slots included.
+				Dictionary data = _load_from_disk(task.slot_name);
+				callable_mp(this, &SaveServer::_finish_load_batched).call_deferred(task.slot_name, task.target_node_id, data, task.user_callback, task.dynamic_respawn);
+				continue;
+			}
+
+			HashSet<StringName> subtrees;
+			for (int i = 0; i < task.subtrees.size(); i++) {
+				subtrees.insert(task.subtrees[i]);
+			}
+			const HashSet<StringName> *subtrees_ptr = task.subtrees.is_empty() ? nullptr : &subtrees;
+
+			Array packed_parts = _load_packed_from_disk(task.slot_name, subtrees_ptr);
+			if (!packed_parts.is_empty()) {
+				// Dispatch back to main thread
+				callable_mp(this, &SaveServer::_finish_load_packed).call_deferred(task.slot_name, task.target_node_id, packed_parts, task.user_callback, task.dynamic_respawn, task.subtrees);
+				continue;
+			}
+
 			Dictionary data = _load_from_disk(task.slot_name);
+			if (subtrees_ptr && !data.is_empty()) {
+				// Other formats have to be read whole, but only the requested subtrees are applied.
+				Ref<Snapshot> snapshot;
+				snapshot.instantiate();
+				snapshot->set_snapshot(data);
+				Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+				packed->filter_subtrees(subtrees);
+
+				Array parts;
+				parts.push_back(packed);
+				callable_mp(this, &SaveServer::_finish_load_packed).call_deferred(task.slot_name, task.target_node_id, parts, task.user_callback, task.dynamic_respawn, task.subtrees);
+				continue;
+			}
+
 			// Dispatch back to main thread
 			call_deferred("_finish_load_async", task.slot_name, task.target_node_id, data, task.user_callback, task.dynamic_respawn);
 		}
 	}
+
+	_wait_for_writes();
+}
+
+void SaveServer::_push_task(const SaveTask &p_task) {
+	// Coalesce with the pending writes of the same slot, up to the last queued load so loads still
+	// observe the state saved before them. Must be called with `mutex` held.
+	if (p_task.type != TASK_LOAD) {
+		List<SaveTask>::Element *E = queue.back();
+		while (E && E->get().type != TASK_LOAD) {
+			List<SaveTask>::Element *prev = E->prev();
+			SaveTask &pending = E->get();
+			if (pending.slot_name == p_task.slot_name) {
+				if (p_task.type == TASK_SAVE) {
+					// A full save supersedes older saves and amends of the slot.
+					queue.erase(E);
+				} else if (pending.type == TASK_AMEND) {
+					// Consecutive amends are appended as a single journal frame.
+					pending.journal_entries.append_array(p_task.journal_entries);
+					return;
+				} else {
+					break;
+				}
+			}
+			E = prev;
+		}
+	}
+
+	queue.push_back(p_task);
+}
+
+void SaveServer::_dispatch_write(const SaveTask &p_task) {
+	// Writes of different slots run in parallel, writes of the same slot stay in order.
+	HashMap<String, WorkerThreadPool::TaskID>::Iterator E = slot_tasks.find(p_task.slot_name);
+	if (E) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E->value);
+		slot_tasks.remove(E);
+	}
+
+	SaveTask *task = memnew(SaveTask(p_task));
+	slot_tasks[p_task.slot_name] = WorkerThreadPool::get_singleton()->add_template_task(this, &SaveServer::_run_write_task, task, false, SNAME("SaveServerWrite"));
+}
+
+void SaveServer::_run_write_task(SaveTask *p_task) {
+	if (p_task->type == TASK_SAVE) {
+		_save_to_disk(*p_task);
+	} else if (p_task->type == TASK_AMEND) {
+		_append_journal(*p_task);
+	}
+	memdelete(p_task);
+}
+
+void SaveServer::_wait_for_writes() {
+	for (const KeyValue<String, WorkerThreadPool::TaskID> &E : slot_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E.value);
+	}
+	slot_tasks.clear();
 }
 
 void SaveServer::set_save_format(SaveFormat p_format) {
@@ -724,6 +1588,22 @@ bool SaveServer::is_backup_enabled() const {
 	return backup_enabled;
 }
 
+void SaveServer::set_capture_budget_usec(int p_usec) {
+	capture_budget_usec = MAX(1, p_usec);
+}
+
+int SaveServer::get_capture_budget_usec() const {
+	return capture_budget_usec;
+}
+
+void SaveServer::set_restore_budget_usec(int p_usec) {
+	restore_budget_usec = MAX(1, p_usec);
+}
+
+int SaveServer::get_restore_budget_usec() const {
+	return restore_budget_usec;
+}
+
 void SaveServer::set_integrity_check_level(IntegrityCheckLevel p_level) {
 	integrity_level = p_level;
 }
@@ -763,9 +1643,13 @@ void SaveServer::stage_deletion(Node *p_root_context, Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_COND(!p_root_context->is_ancestor_of(p_node) && p_root_context != p_node);
 
-	NodePath rel_path = p_root_context->get_path_to(p_node);
+	// Nodes known by persistence ID are removed from their recorded location, even if moved since.
+	StringName pid = p_node->get_persistence_id();
+	const SnapshotIndex::Record *record = pid.is_empty() ? nullptr : record_index.find(pid);
+	NodePath rel_path = record ? record->path : p_root_context->get_path_to(p_node);
+
 	MutexLock lock(staged_mutex);
-	staged_deletions.insert(rel_path);
+	staged_deletions[rel_path] = pid;
 }
 
 void SaveServer::clear_staged() {
@@ -777,25 +1661,7 @@ void SaveServer::clear_staged() {
 bool SaveServer::_patch_snapshot_data(Dictionary &p_target, const NodePath &p_relative_path, const Dictionary &p_new_data) {
 	Dictionary current = p_target;
 
-	// If path is empty (root node itself changed), handle directly
-	if (p_relative_path.get_name_count() == 0) {
-		// Store children before overwrite
-		Dictionary children;
-		if (current.has(".children")) {
-			children = current[".children"];
-		}
-
-		// Apply new data (overwrite properties)
-		current.merge(p_new_data, true);
-
-		// Restore children map (crucial step!)
-		if (!children.is_empty()) {
-			current[".children"] = children;
-		}
-		return true;
-	}
-
-	// Navigate hierarchy
+	// Navigate hierarchy (an empty path is the root node itself)
 	for (int i = 0; i < p_relative_path.get_name_count(); i++) {
 		StringName segment = p_relative_path.get_name(i);
 
@@ -814,21 +1680,8 @@ bool SaveServer::_patch_snapshot_data(Dictionary &p_target, const NodePath &p_re
 		current = children[segment]; // Reference to inner dictionary
 	}
 
-	// 'current' is now the dictionary of the target node
-	// We need to preserve its children
-	Dictionary children;
-	if (current.has(".children")) {
-		children = current[".children"];
-	}
-
-	// Apply change
-	current.merge(p_new_data, true);
-
-	// Restore children
-	if (!children.is_empty()) {
-		current[".children"] = children;
-	}
-
+	// 'current' is now the dictionary of the target node, apply the change preserving its children
+	SnapshotIndex::merge_record(current, p_new_data);
 	return true;
 }
 
@@ -879,7 +1732,7 @@ bool SaveServer::amend_save(Node *p_root, const String &p_slot_name) {
 	}
 
 	HashMap<StringName, HashSet<ObjectID>> dirty_tags;
-	HashSet<NodePath> deletions;
+	HashMap<NodePath, StringName> deletions;
 
 	{
 		MutexLock lock(staged_mutex);
@@ -897,21 +1750,21 @@ bool SaveServer::amend_save(Node *p_root, const String &p_slot_name) {
 		// We don't clear here yet, we wait to see if we successfully patch
 	}
 
-	bool data_modified = false;
+	// Patches are appended to the journal of each slot instead of rewriting it,
+	// they are replayed on load and folded into the slot once the journal grows too large.
+	HashMap<String, LocalVector<SaveJournal::Entry>> journal;
+	LocalVector<SaveJournal::Entry> base_entries; // The same patches, laid out like the full snapshot.
 
 	// 1. Handle Deletions (Affects the Main Slot/Manifest by default)
-	if (!deletions.is_empty()) {
-		Dictionary patched_main = _load_from_disk(main_slot);
-		bool modified = false;
-		for (const NodePath &path : deletions) {
-			if (_remove_node_from_snapshot(patched_main, path)) {
-				modified = true;
-			}
-		}
-		if (modified) {
-			save_slot(main_slot, patched_main, true);
-			data_modified = true;
+	for (const KeyValue<NodePath, StringName> &E : deletions) {
+		SaveJournal::Entry entry;
+		entry.op = SaveJournal::OP_REMOVE;
+		entry.path = E.key;
+		if (!E.value.is_empty()) {
+			entry.data[".id"] = E.value;
 		}
+		journal[main_slot].push_back(entry);
+		base_entries.push_back(entry);
 	}
 
 	// 2. Intelligent Tag Updates (Satellite patching)
@@ -919,9 +1772,6 @@ bool SaveServer::amend_save(Node *p_root, const String &p_slot_name) {
 		StringName tag = E.key;
 		String target_slot = (tag == SNAME("general")) ? main_slot : main_slot + "_" + String(tag);
 
-		Dictionary satellite_data = _load_from_disk(target_slot);
-		bool satellite_modified = false;
-
 		for (const ObjectID &id : E.value) {
 			Object *obj = ObjectDB::get_instance(id);
 			Node *node = Object::cast_to<Node>(obj);
@@ -934,7 +1784,11 @@ bool SaveServer::amend_save(Node *p_root, const String &p_slot_name) {
 				continue;
 			}
 
-			NodePath rel_path = p_root->get_path_to(node);
+			// Nodes with a persistence ID are addressed by their record, the path is only
+			// a fallback when the ID is not in the slot yet.
+			StringName pid = node->get_persistence_id();
+			const SnapshotIndex::Record *record = pid.is_empty() ? nullptr : record_index.find(pid);
+			NodePath rel_path = record ? record->path : p_root->get_path_to(node);
 
 			// Get ONLY the data for this specific tag
 			TypedArray<StringName> filter_tags;
@@ -947,32 +1801,186 @@ bool SaveServer::amend_save(Node *p_root, const String &p_slot_name) {
 				inner_data = node_tag_data[tag];
 
 				// Add identity markers
-				StringName pid = node->get_persistence_id();
 				if (!pid.is_empty()) {
 					inner_data[".id"] = pid;
 				}
 			}
 
 			if (!inner_data.is_empty()) {
-				if (_patch_snapshot_data(satellite_data, rel_path, inner_data)) {
-					satellite_modified = true;
+				SaveJournal::Entry entry;
+				entry.path = rel_path;
+				entry.data = inner_data;
+				journal[target_slot].push_back(entry);
+
+				// The base snapshot keeps every tag of a node, grouped by tag.
+				SaveJournal::Entry base_entry;
+				base_entry.path = rel_path;
+				Dictionary tag_data = inner_data.duplicate();
+				tag_data.erase(".id");
+				base_entry.data[tag] = tag_data;
+				if (!pid.is_empty()) {
+					base_entry.data[".id"] = pid;
 				}
+				base_entries.push_back(base_entry);
 			}
 		}
+	}
 
-		if (satellite_modified) {
-			save_slot(target_slot, satellite_data, true);
-			data_modified = true;
+	bool data_modified = false;
+	for (const KeyValue<String, LocalVector<SaveJournal::Entry>> &E : journal) {
+		if (E.value.is_empty()) {
+			continue;
 		}
+
+		SaveTask task;
+		task.type = TASK_AMEND;
+		task.slot_name = E.key;
+		task.journal_entries = SaveJournal::entries_to_array(E.value);
+		task.format = current_format;
+		task.encryption_key = encryption_key;
+		task.compression_enabled = compression_enabled;
+		task.checksum_algorithm = _get_checksum_algorithm();
+
+		{
+			MutexLock lock(mutex);
+			_push_task(task);
+		}
+		semaphore.post();
+		data_modified = true;
 	}
 
 	if (data_modified) {
+		_amend_base_snapshot(base_entries);
 		clear_staged();
 	}
 
 	return true;
 }
 
+void SaveServer::_amend_base_snapshot(const LocalVector<SaveJournal::Entry> &p_entries) {
+	// Keep the base in step with the journals, so later amends resolve records
+	// against what was actually saved instead of the last full save.
+	Dictionary data;
+	if (base_snapshot.is_valid()) {
+		data = base_snapshot->get_snapshot();
+	}
+
+	bool rebuild_index = false;
+	for (const SaveJournal::Entry &entry : p_entries) {
+		StringName id = entry.data.get(".id", StringName());
+		if (!id.is_empty()) {
+			// Records share their dictionaries with the base, patching them patches both.
+			bool applied = entry.op == SaveJournal::OP_REMOVE ? record_index.remove(id) : record_index.patch(id, entry.data);
+			if (applied) {
+				continue;
+			}
+		}
+
+		if (base_snapshot.is_null()) {
+			continue; // Packed loads only keep the index, path-only records aren't in it.
+		}
+
+		bool applied = entry.op == SaveJournal::OP_REMOVE ? _remove_node_from_snapshot(data, entry.path) : _patch_snapshot_data(data, entry.path, entry.data);
+		rebuild_index = rebuild_index || applied;
+	}
+
+	if (rebuild_index) {
+		record_index.build(data);
+	}
+}
+
+String SaveServer::_get_journal_path(const String &p_slot_name) const {
+	return save_path.path_join(p_slot_name + ".journal");
+}
+
+void SaveServer::_append_journal(const SaveTask &p_task) {
+	LocalVector<SaveJournal::Entry> entries;
+	SaveJournal::entries_from_array(p_task.journal_entries, entries);
+
+	String journal_path = _get_journal_path(p_task.slot_name);
+	Error err = SaveJournal::append(journal_path, entries, p_task.encryption_key);
+	if (err != OK) {
+		// Keep the amend rather than dropping it: fold it into the slot right away.
+		ERR_PRINT("SaveServer: Cannot append to journal, rewriting slot: " + p_task.slot_name);
+		_compact_journal(p_task, true);
+		return;
+	}
+
+	if (SaveJournal::get_size(journal_path) > journal_max_size) {
+		_compact_journal(p_task, false);
+	} else {
+		call_deferred("emit_signal", "save_successful", p_task.slot_name);
+	}
+}
+
+bool SaveServer::_replay_journal(const String &p_slot_name, Dictionary &r_data) {
+	String journal_path = _get_journal_path(p_slot_name);
+	if (!FileAccess::exists(journal_path)) {
+		return false;
+	}
+
+	String key = GLOBAL_GET("application/persistence/encryption_key");
+	LocalVector<SaveJournal::Entry> entries;
+	SaveJournal::read(journal_path, key, entries);
+
+	_apply_journal_entries(r_data, entries);
+
+	return !entries.is_empty();
+}
+
+void SaveServer::_apply_journal_entries(Dictionary &r_data, const LocalVector<SaveJournal::Entry> &p_entries) {
+	// Entries carrying a persistence ID hit their record through the index, so they still
+	// apply after the node was renamed or moved. Others (and unknown IDs) go by path.
+	SnapshotIndex index;
+	bool indexed = false;
+
+	for (const SaveJournal::Entry &entry : p_entries) {
+		StringName id = entry.data.get(".id", StringName());
+		if (!id.is_empty()) {
+			if (!indexed) {
+				index.build(r_data);
+				indexed = true;
+			}
+			bool applied = entry.op == SaveJournal::OP_REMOVE ? index.remove(id) : index.patch(id, entry.data);
+			if (applied) {
+				continue;
+			}
+		}
+
+		if (entry.op == SaveJournal::OP_REMOVE) {
+			_remove_node_from_snapshot(r_data, entry.path);
+		} else {
+			_patch_snapshot_data(r_data, entry.path, entry.data);
+		}
+	}
+}
+
+Error SaveServer::_compact_journal(const SaveTask &p_task, bool p_apply_task) {
+	// Folds the journal (and the amend of the task, when it could not be appended) into the slot.
+	Ref<Snapshot> snapshot_res = _read_snapshot_from_disk(p_task.slot_name);
+	if (snapshot_res.is_null()) {
+		snapshot_res.instantiate();
+		snapshot_res->set_version(GLOBAL_GET("application/config/version"));
+	}
+	_apply_migrations(snapshot_res);
+
+	Dictionary data = snapshot_res->get_snapshot();
+	_replay_journal(p_task.slot_name, data);
+
+	if (p_apply_task) {
+		LocalVector<SaveJournal::Entry> entries;
+		SaveJournal::entries_from_array(p_task.journal_entries, entries);
+		_apply_journal_entries(data, entries);
+	}
+
+	snapshot_res->set_snapshot(data);
+
+	SaveTask task = p_task;
+	task.type = TASK_SAVE;
+	task.snapshot = snapshot_res;
+	return _save_to_disk(task);
+}
+
 SaveServer::SaveServer() {
 	singleton = this;
 	exit_thread.clear();
@@ -980,9 +1988,13 @@ SaveServer::SaveServer() {
 	// Load configuration
 	backup_enabled = GLOBAL_GET("application/persistence/backup_enabled");
 	max_backups = GLOBAL_GET("application/persistence/max_backups");
+	backup_keyframe_interval = MAX(1, (int)GLOBAL_GET("application/persistence/backup_keyframe_interval"));
 	int integrity_val = GLOBAL_GET("application/persistence/integrity_check_level");
 	integrity_level = (IntegrityCheckLevel)integrity_val;
 	save_path = GLOBAL_GET("application/persistence/save_path");
+	journal_max_size = (int64_t)GLOBAL_GET("application/persistence/journal_max_size");
+	capture_budget_usec = MAX(1, (int)GLOBAL_GET("application/persistence/capture_budget_usec"));
+	restore_budget_usec = MAX(1, (int)GLOBAL_GET("application/persistence/restore_budget_usec"));
 
 	// Auto-generate project-specific encryption key if empty (Editor-only)
 	if (Engine::get_singleton()->is_editor_hint()) {
@@ -1030,6 +2042,8 @@ SaveServer::~SaveServer() {
 			// Only process saves, ignore loads during shutdown
 			if (task.type == TASK_SAVE) {
 				_save_to_disk(task);
+			} else if (task.type == TASK_AMEND) {
+				_append_journal(task);
 			}
 		}
 	}
@@ -1037,6 +2051,7 @@ SaveServer::~SaveServer() {
 	id_registry.clear();
 	staged_objects.clear();
 	base_snapshot.unref();
+	record_index.clear();
 
 	singleton = nullptr;
 }
@@ -1088,6 +2103,27 @@ Dictionary SaveServer::_save_node_recursive(Node *p_node, const TypedArray<Strin
 	}
 
 	// Save this node
+	Dictionary snapshot = _capture_node(p_node, p_tags);
+
+	// Recursively save children
+	Dictionary children_snapshots;
+	int child_count = p_node->get_child_count(false); // Exclude internal nodes
+	for (int i = 0; i < child_count; i++) {
+		Node *child = p_node->get_child(i, false);
+		Dictionary child_data = _save_node_recursive(child, p_tags);
+		if (!child_data.is_empty()) {
+			children_snapshots[child->get_name()] = child_data;
+		}
+	}
+
+	if (!children_snapshots.is_empty()) {
+		snapshot[".children"] = children_snapshots;
+	}
+
+	return snapshot;
+}
+
+Dictionary SaveServer::_capture_node(Node *p_node, const TypedArray<StringName> &p_tags) {
 	Dictionary snapshot = p_node->get_persistent_properties(p_tags);
 
 	// Add ID if present, or auto-generate for dynamic instances
@@ -1108,21 +2144,6 @@ Dictionary SaveServer::_save_node_recursive(Node *p_node, const TypedArray<Strin
 		snapshot[".scene"] = p_node->get_scene_file_path();
 	}
 
-	// Recursively save children
-	Dictionary children_snapshots;
-	int child_count = p_node->get_child_count(false); // Exclude internal nodes
-	for (int i = 0; i < child_count; i++) {
-		Node *child = p_node->get_child(i, false);
-		Dictionary child_data = _save_node_recursive(child, p_tags);
-		if (!child_data.is_empty()) {
-			children_snapshots[child->get_name()] = child_data;
-		}
-	}
-
-	if (!children_snapshots.is_empty()) {
-		snapshot[".children"] = children_snapshots;
-	}
-
 	return snapshot;
 }
 
@@ -1140,30 +2161,11 @@ void SaveServer::_load_node_recursive(Node *p_node, const Dictionary &p_data, bo
 
 		// Orphan Cleanup: Remove nodes that exist in the scene but are missing from the snapshot
 		if (p_dynamic_respawn) {
-			List<Node *> to_remove;
-			for (int i = 0; i < p_node->get_child_count(); i++) {
-				Node *child = p_node->get_child(i);
-				StringName child_name = child->get_name();
-
-				// If the node is persistent but not in the save, it was destroyed/removed
-				if (!children_data.has(child_name)) {
-					// Check if node is persistent-enabled (has ID, explicit save policy ALWAYS, or has persistent properties)
-					bool is_persistent = !child->get_persistence_id().is_empty() ||
-							child->get_save_policy() == Node::SAVE_POLICY_ALWAYS ||
-							!child->get_persistent_properties().is_empty();
-
-					if (is_persistent) {
-						to_remove.push_back(child);
-					}
-				}
-			}
-
-			for (Node *child : to_remove) {
-#ifdef DEBUG_ENABLED
-				print_line(vformat("SaveServer: Orphan Cleanup - Removing destroyed node '%s'", child->get_name()));
-#endif
-				child->queue_free();
+			HashSet<StringName> kept_children;
+			for (const KeyValue<Variant, Variant> &E : children_data) {
+				kept_children.insert(E.key);
 			}
+			_remove_orphans(p_node, kept_children);
 		}
 
 		Array child_names = children_data.keys();
@@ -1205,6 +2207,119 @@ void SaveServer::_load_node_recursive(Node *p_node, const Dictionary &p_data, bo
 	}
 }
 
+void SaveServer::_remove_orphans(Node *p_node, const HashSet<StringName> &p_kept_children) {
+	List<Node *> to_remove;
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		Node *child = p_node->get_child(i);
+		StringName child_name = child->get_name();
+
+		// If the node is persistent but not in the save, it was destroyed/removed
+		if (!p_kept_children.has(child_name)) {
+			// Check if node is persistent-enabled (has ID, explicit save policy ALWAYS, or has persistent properties)
+			bool is_persistent = !child->get_persistence_id().is_empty() ||
+					child->get_save_policy() == Node::SAVE_POLICY_ALWAYS ||
+					!child->get_persistent_properties().is_empty();
+
+			if (is_persistent) {
+				to_remove.push_back(child);
+			}
+		}
+	}
+
+	for (Node *child : to_remove) {
+#ifdef DEBUG_ENABLED
+		print_line(vformat("SaveServer: Orphan Cleanup - Removing destroyed node '%s'", child->get_name()));
+#endif
+		child->queue_free();
+	}
+}
+
+static Node *_find_or_spawn_packed_child(Node *p_parent, const StringName &p_name, const String *p_scene_path, bool p_dynamic_respawn) {
+	// Attempt to find child by name
+	Node *node = p_parent->get_node_or_null(NodePath(p_name));
+
+	// Dynamic Instantiation Logic
+	if (!node && p_scene_path && p_dynamic_respawn) {
+		Ref<PackedScene> scene = ResourceLoader::load(*p_scene_path);
+
+		if (scene.is_valid()) {
+			Node *instance = scene->instantiate();
+			if (instance) {
+				instance->set_name(p_name);
+				p_parent->add_child(instance, true); // Force readable name
+				node = instance;
+#ifdef DEBUG_ENABLED
+				print_line(vformat("SaveServer: Dynamically spawned node '%s' from '%s'", p_name, *p_scene_path));
+#endif
+			}
+		} else {
+			ERR_PRINT(vformat("SaveServer: Failed to load scene '%s' for dynamic spawn '%s'", *p_scene_path, p_name));
+		}
+	}
+
+	return node;
+}
+
+void SaveServer::_load_packed_snapshot(Node *p_root, const Ref<PackedSnapshot> &p_packed, bool p_dynamic_respawn, HashMap<Node *, HashSet<StringName>> &r_kept_children) {
+	LocalVector<Node *> nodes;
+	LocalVector<StringName> tags;
+	LocalVector<StringName> properties;
+	LocalVector<const Variant *> values;
+
+	for (const PackedSnapshot::Chunk &chunk : p_packed->get_chunks()) {
+		const LocalVector<PackedSnapshot::Record> &records = chunk.records;
+		const LocalVector<PackedSnapshot::Layout> &layouts = chunk.layouts;
+		const LocalVector<StringName> &names = chunk.names;
+		const LocalVector<String> &strings = chunk.strings;
+
+		// Records are stored parents first, so a single forward pass resolves every node.
+		nodes.resize(records.size());
+
+		for (uint32_t i = 0; i < records.size(); i++) {
+			const PackedSnapshot::Record &record = records[i];
+			Node *node = nullptr;
+
+			// The parentless record is the root itself, or a direct child of it in subtree chunks.
+			Node *parent = p_root;
+			if (record.parent != PackedSnapshot::NO_INDEX) {
+				parent = nodes[record.parent];
+			} else if (chunk.is_root()) {
+				parent = nullptr;
+				node = p_root;
+			}
+
+			if (parent) {
+				const StringName &child_name = names[record.name];
+				if (p_dynamic_respawn) {
+					r_kept_children[parent].insert(child_name);
+				}
+				const String *scene_path = record.scene != PackedSnapshot::NO_INDEX ? &strings[record.scene] : nullptr;
+				node = _find_or_spawn_packed_child(parent, child_name, scene_path, p_dynamic_respawn);
+			}
+
+			nodes[i] = node;
+			if (!node) {
+				continue;
+			}
+
+			tags.clear();
+			properties.clear();
+			values.clear();
+			if (record.layout != PackedSnapshot::NO_INDEX) {
+				const PackedSnapshot::Layout &layout = layouts[record.layout];
+				for (uint32_t f = 0; f < layout.fields.size(); f++) {
+					const PackedSnapshot::Field &field = layout.fields[f];
+					tags.push_back(names[field.tag]);
+					properties.push_back(field.property == PackedSnapshot::NO_INDEX ? StringName() : names[field.property]);
+					values.push_back(&layout.columns[f].values[record.row]);
+				}
+			}
+
+			node->set_persistent_values(tags.ptr(), properties.ptr(), values.ptr(), values.size());
+		}
+	}
+}
+
 void SaveServer::_create_backup(const String &p_slot_name) {
 	if (!backup_enabled) {
 		return;
@@ -1215,7 +2330,10 @@ void SaveServer::_create_backup(const String &p_slot_name) {
 	String src_path = "";
 	String ext = "";
 
-	if (FileAccess::exists(base_path + ".data")) {
+	if (FileAccess::exists(base_path + ".snap")) {
+		src_path = base_path + ".snap";
+		ext = ".snap";
+	} else if (FileAccess::exists(base_path + ".data")) {
 		src_path = base_path + ".data";
 		ext = ".data";
 	} else if (FileAccess::exists(base_path + ".tres")) {
@@ -1225,6 +2343,8 @@ void SaveServer::_create_backup(const String &p_slot_name) {
 		return; // Nothing to backup
 	}
 
+	MutexLock lock(backup_mutex);
+
 	// Create backups directory
 	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_USERDATA);
 	String backup_dir = save_path.path_join("backups");
@@ -1237,25 +2357,96 @@ void SaveServer::_create_backup(const String &p_slot_name) {
 	String timestamp = Time::get_singleton()->get_datetime_string_from_system().replace(":", "-");
 	String dest_path = backup_dir.path_join(p_slot_name + "_" + timestamp + ext);
 
-	// Copy the file
-	da->copy(src_path, dest_path);
+	// Files that can't be decoded are still kept whole, they just don't start a delta chain.
+	Vector<uint8_t> data;
+	if (_read_backup_contents(src_path, ext, data) != OK) {
+		data.clear();
+	}
+
+	LocalVector<BackupVersion> versions;
+	_list_backups(p_slot_name, versions);
+
+	// Saved twice within a second: the newest backup is replaced, nothing depends on it.
+	if (!versions.is_empty() && versions[versions.size() - 1].id == timestamp) {
+		da->remove(backup_dir.path_join(versions[versions.size() - 1].file));
+		versions.remove_at(versions.size() - 1);
+		backup_cache.erase(p_slot_name);
+	}
+
+	// Store a delta against the previous backup, unless a keyframe is due.
+	Vector<uint8_t> delta;
+	if (!data.is_empty() && !versions.is_empty() && versions[versions.size() - 1].ext == ext) {
+		uint32_t since_keyframe = 0;
+		for (int64_t i = versions.size() - 1; i >= 0 && versions[i].delta; i--) {
+			since_keyframe++;
+		}
+
+		if ((int)since_keyframe + 1 < backup_keyframe_interval) {
+			const BackupVersion &previous = versions[versions.size() - 1];
+			Vector<uint8_t> previous_data;
+			HashMap<String, Pair<String, Vector<uint8_t>>>::Iterator E = backup_cache.find(p_slot_name);
+			if (E && E->value.first == previous.id) {
+				previous_data = E->value.second;
+			} else {
+				_reconstruct_backup(versions, versions.size() - 1, previous_data);
+			}
+
+			if (!previous_data.is_empty() && DeltaEncoding::encode_delta(previous_data, data, delta, 9) == OK) {
+				// Versions that changed this much are kept whole, so they don't lengthen the chain for nothing.
+				if (delta.size() > data.size() / 2) {
+					delta.clear();
+				}
+			} else {
+				delta.clear();
+			}
+		}
+	}
+
+	Error err = OK;
+	if (!delta.is_empty()) {
+		// The delta is compressed already, it only needs encrypting like the slot it describes.
+		String key = GLOBAL_GET("application/persistence/encryption_key");
+		Ref<FileAccess> f;
+		if (!key.is_empty()) {
+			f = FileAccess::open_encrypted_pass(dest_path + ".delta", FileAccess::WRITE, key);
+		} else {
+			f = FileAccess::open(dest_path + ".delta", FileAccess::WRITE, &err);
+		}
+		if (f.is_valid()) {
+			f->store_buffer(delta.ptr(), delta.size());
+			f->close();
+		} else if (err == OK) {
+			err = ERR_FILE_CANT_OPEN;
+		}
+	} else {
+		err = da->copy(src_path, dest_path);
+	}
+	ERR_FAIL_COND_MSG(err != OK, "SaveServer: Cannot create backup: " + dest_path);
+
+	if (data.is_empty()) {
+		backup_cache.erase(p_slot_name);
+	} else {
+		backup_cache[p_slot_name] = Pair<String, Vector<uint8_t>>(timestamp, data);
+	}
 
 	// Cleanup old backups
 	_prune_backups(p_slot_name);
 }
 
-void SaveServer::_prune_backups(const String &p_slot_name) {
+void SaveServer::_list_backups(const String &p_slot_name, LocalVector<BackupVersion> &r_versions) const {
 	String backup_dir = save_path.path_join("backups");
 	Ref<DirAccess> da = DirAccess::open(backup_dir);
 	if (da.is_null()) {
 		return;
 	}
 
+	// Satellites share the prefix of their main slot, the timestamp tells them apart.
+	String prefix = p_slot_name + "_";
 	List<String> backups;
 	da->list_dir_begin();
 	String f = da->get_next();
 	while (!f.is_empty()) {
-		if (!da->current_is_dir() && f.begins_with(p_slot_name + "_")) {
+		if (!da->current_is_dir() && f.begins_with(prefix) && f.length() > prefix.length() && is_digit(f[prefix.length()])) {
 			backups.push_back(f);
 		}
 		f = da->get_next();
@@ -1264,11 +2455,177 @@ void SaveServer::_prune_backups(const String &p_slot_name) {
 
 	backups.sort(); // Datetime string sort works correctly
 
+	for (const String &file : backups) {
+		BackupVersion version;
+		version.file = file;
+		String name = file;
+		if (name.ends_with(".delta")) {
+			version.delta = true;
+			name = name.trim_suffix(".delta");
+		}
+		version.ext = "." + name.get_extension();
+		version.id = name.substr(prefix.length()).get_basename();
+		r_versions.push_back(version);
+	}
+}
+
+Error SaveServer::_read_backup_contents(const String &p_path, const String &p_ext, Vector<uint8_t> &r_data) {
+	// Text slots are diffed as they are. Binary slots are diffed after decryption and decompression,
+	// packed slots over the binary encoding of their snapshot, as their chunks are compressed one by one.
+	if (p_ext == ".tres") {
+		r_data = FileAccess::get_file_as_bytes(p_path);
+		return r_data.is_empty() ? ERR_FILE_CANT_READ : OK;
+	}
+
+	if (p_ext == ".snap") {
+		Ref<Snapshot> snapshot_res = _read_snapshot_file(p_path);
+		ERR_FAIL_COND_V(snapshot_res.is_null(), ERR_FILE_CORRUPT);
+		int len = 0;
+		Error err = encode_variant(snapshot_res, nullptr, len, true);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_data.resize(len);
+		return encode_variant(snapshot_res, r_data.ptrw(), len, true);
+	}
+
+	Ref<FileAccess> f = _open_binary_for_read(p_path);
+	ERR_FAIL_COND_V(f.is_null(), ERR_FILE_CANT_OPEN);
+	r_data.resize(f->get_length());
+	ERR_FAIL_COND_V(f->get_buffer(r_data.ptrw(), r_data.size()) != (uint64_t)r_data.size(), ERR_FILE_CANT_READ);
+	return OK;
+}
+
+Error SaveServer::_write_backup_contents(const String &p_path, const String &p_ext, const Vector<uint8_t> &p_data) const {
+	// Inverse of _read_backup_contents(), written with the current key and compression settings.
+	String key = GLOBAL_GET("application/persistence/encryption_key");
+	Error err = OK;
+
+	if (p_ext == ".snap") {
+		Variant v;
+		err = decode_variant(v, p_data.ptr(), p_data.size(), nullptr, true);
+		ERR_FAIL_COND_V(err != OK, err);
+		Ref<Snapshot> snapshot_res = v;
+		ERR_FAIL_COND_V(snapshot_res.is_null(), ERR_FILE_CORRUPT);
+
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V(f.is_null(), err);
+		err = _write_packed_file(f, snapshot_res, key, compression_enabled, _get_checksum_algorithm());
+		f->close();
+		return err;
+	}
+
+	Ref<FileAccess> f;
+	if (p_ext == ".tres") {
+		f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	} else if (!key.is_empty()) {
+		f = FileAccess::open_encrypted_pass(p_path, FileAccess::WRITE, key);
+	} else if (compression_enabled && p_data.size() > 4096) {
+		f = FileAccess::open_compressed(p_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+	} else {
+		f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	}
+	ERR_FAIL_COND_V(f.is_null(), err != OK ? err : ERR_FILE_CANT_OPEN);
+	f->store_buffer(p_data.ptr(), p_data.size());
+	f->close();
+	return OK;
+}
+
+Error SaveServer::_reconstruct_backup(const LocalVector<BackupVersion> &p_versions, uint32_t p_index, Vector<uint8_t> &r_data) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_index, p_versions.size(), ERR_INVALID_PARAMETER);
+	String backup_dir = save_path.path_join("backups");
+	String key = GLOBAL_GET("application/persistence/encryption_key");
+
+	// Walk back to the keyframe, then apply the deltas forward.
+	int64_t keyframe = p_index;
+	while (keyframe >= 0 && p_versions[keyframe].delta) {
+		keyframe--;
+	}
+	ERR_FAIL_COND_V_MSG(keyframe < 0, ERR_FILE_CORRUPT, "SaveServer: Backup delta chain has no keyframe for version: " + p_versions[p_index].id);
+
+	Error err = _read_backup_contents(backup_dir.path_join(p_versions[keyframe].file), p_versions[keyframe].ext, r_data);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	for (uint32_t i = keyframe + 1; i <= p_index; i++) {
+		String delta_path = backup_dir.path_join(p_versions[i].file);
+		Vector<uint8_t> delta;
+		if (key.is_empty()) {
+			delta = FileAccess::get_file_as_bytes(delta_path);
+		} else {
+			Ref<FileAccess> f = FileAccess::open_encrypted_pass(delta_path, FileAccess::READ, key);
+			ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, "SaveServer: Cannot open backup delta: " + p_versions[i].file);
+			delta = f->get_buffer(f->get_length());
+		}
+		Vector<uint8_t> next;
+		err = DeltaEncoding::decode_delta(r_data, delta, next);
+		ERR_FAIL_COND_V_MSG(err != OK, err, "SaveServer: Cannot apply backup delta: " + p_versions[i].file);
+		r_data = next;
+	}
+
+	return OK;
+}
+
+Ref<Snapshot> SaveServer::_read_backup(const String &p_slot_name, const String &p_version, bool *r_verified) {
+	LocalVector<BackupVersion> versions;
+	_list_backups(p_slot_name, versions);
+
+	for (uint32_t i = 0; i < versions.size(); i++) {
+		if (versions[i].id != p_version) {
+			continue;
+		}
+
+		String backup_dir = save_path.path_join("backups");
+		if (!versions[i].delta) {
+			return _read_snapshot_file(backup_dir.path_join(versions[i].file), r_verified);
+		}
+
+		Vector<uint8_t> data;
+		if (_reconstruct_backup(versions, i, data) != OK) {
+			return Ref<Snapshot>();
+		}
+
+		// Snapshot readers work on paths, so the version is rebuilt into a scratch file.
+		String temp_path = backup_dir.path_join(p_slot_name + ".restore" + versions[i].ext);
+		if (_write_backup_contents(temp_path, versions[i].ext, data) != OK) {
+			return Ref<Snapshot>();
+		}
+
+		Ref<Snapshot> snapshot_res = _read_snapshot_file(temp_path, r_verified);
+		DirAccess::remove_absolute(temp_path);
+		return snapshot_res;
+	}
+
+	return Ref<Snapshot>();
+}
+
+void SaveServer::_prune_backups(const String &p_slot_name) {
+	String backup_dir = save_path.path_join("backups");
+	Ref<DirAccess> da = DirAccess::open(backup_dir);
+	if (da.is_null()) {
+		return;
+	}
+
+	LocalVector<BackupVersion> versions;
+	_list_backups(p_slot_name, versions);
+
 	// Keep only max_backups most recent
-	while (backups.size() > max_backups) {
-		String to_delete = backup_dir.path_join(backups.front()->get());
-		da->remove(to_delete);
-		backups.pop_front();
+	uint32_t to_remove = versions.size() > (uint32_t)max_backups ? versions.size() - max_backups : 0;
+	if (to_remove == 0) {
+		return;
+	}
+
+	// The oldest kept version becomes a keyframe once the versions it depends on are gone.
+	if (to_remove < versions.size() && versions[to_remove].delta) {
+		Vector<uint8_t> data;
+		if (_reconstruct_backup(versions, to_remove, data) == OK) {
+			const BackupVersion &version = versions[to_remove];
+			String keyframe_path = backup_dir.path_join(p_slot_name + "_" + version.id + version.ext);
+			if (_write_backup_contents(keyframe_path, version.ext, data) == OK) {
+				da->remove(backup_dir.path_join(version.file));
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < to_remove; i++) {
+		da->remove(backup_dir.path_join(versions[i].file));
 	}
 }
 
@@ -1311,28 +2668,79 @@ int SaveServer::get_max_backups() const {
 	return max_backups;
 }
 
-String SaveServer::_get_latest_backup(const String &p_slot_name) {
-	String backup_dir = save_path.path_join("backups");
-	Ref<DirAccess> da = DirAccess::open(backup_dir);
-	if (da.is_null()) {
-		return "";
+PackedStringArray SaveServer::get_slot_versions(const String &p_slot_name) const {
+	LocalVector<BackupVersion> versions;
+	_list_backups(_sanitize_slot_name(p_slot_name), versions);
+
+	PackedStringArray ids;
+	for (const BackupVersion &version : versions) {
+		ids.push_back(version.id);
 	}
+	return ids;
+}
 
-	List<String> backups;
-	da->list_dir_begin();
-	String f = da->get_next();
-	while (!f.is_empty()) {
-		if (!da->current_is_dir() && f.begins_with(p_slot_name + "_")) {
-			backups.push_back(f);
+Dictionary SaveServer::load_slot_version(const String &p_slot_name, const String &p_version) {
+	String slot_name = _sanitize_slot_name(p_slot_name);
+
+	bool verified = false;
+	Ref<Snapshot> snapshot_res;
+	{
+		MutexLock lock(backup_mutex);
+		snapshot_res = _read_backup(slot_name, p_version, &verified);
+	}
+	ERR_FAIL_COND_V_MSG(snapshot_res.is_null(), Dictionary(), vformat("SaveServer: Version '%s' of slot '%s' not found or unreadable.", p_version, slot_name));
+
+	if (integrity_level >= INTEGRITY_SIGNATURE && !verified) {
+		if (!_verify_checksum(snapshot_res->get_snapshot(), snapshot_res->get_checksum())) {
+			WARN_PRINT(vformat("SaveServer: Integrity check failed (Signature mismatch) for version '%s' of slot: %s", p_version, slot_name));
+			if (integrity_level == INTEGRITY_STRICT) {
+				ERR_PRINT("SaveServer: STRICT level active, rejecting save.");
+				return Dictionary();
+			}
 		}
-		f = da->get_next();
 	}
-	da->list_dir_end();
 
-	if (backups.is_empty()) {
-		return "";
+	_apply_migrations(snapshot_res);
+	return snapshot_res->get_snapshot();
+}
+
+Error SaveServer::restore_slot_version(const String &p_slot_name, const String &p_version) {
+	String slot_name = _sanitize_slot_name(p_slot_name);
+
+	Vector<uint8_t> data;
+	String ext;
+	{
+		MutexLock lock(backup_mutex);
+		LocalVector<BackupVersion> versions;
+		_list_backups(slot_name, versions);
+		for (uint32_t i = 0; i < versions.size(); i++) {
+			if (versions[i].id == p_version) {
+				Error err = _reconstruct_backup(versions, i, data);
+				ERR_FAIL_COND_V(err != OK, err);
+				ext = versions[i].ext;
+				break;
+			}
+		}
 	}
+	ERR_FAIL_COND_V_MSG(ext.is_empty(), ERR_DOES_NOT_EXIST, vformat("SaveServer: Version '%s' of slot '%s' not found.", p_version, slot_name));
 
-	backups.sort();
-	return backup_dir.path_join(backups.back()->get());
+	// The current state is backed up too, so restoring can be undone.
+	_create_backup(slot_name);
+
+	String full_path = save_path.path_join(slot_name + ext);
+	String temp_path = full_path + ".tmp";
+	Error err = _write_backup_contents(temp_path, ext, data);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot write restored save file: " + temp_path);
+
+	// Other formats and the amend journal describe the replaced state.
+	const char *exts[] = { ".tres", ".data", ".snap", ".journal" };
+	for (const char *other : exts) {
+		String other_path = save_path.path_join(slot_name + other);
+		if (other != ext && FileAccess::exists(other_path)) {
+			DirAccess::remove_absolute(other_path);
+		}
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	return da->rename(temp_path, full_path);
 }
@@ -30,16 +30,25 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/variant/dictionary.h"
 #include "core/variant/typed_array.h"
+#include "save_journal.h"
+#include "snapshot_hasher.h"
+#include "snapshot_index.h"
 
 class Node;
+class PackedScene;
+class PackedSnapshot;
 class Snapshot;
 
 class SaveServer : public Object {
@@ -48,7 +57,8 @@ class SaveServer : public Object {
 public:
 	enum SaveFormat {
 		FORMAT_TEXT,
-		FORMAT_BINARY
+		FORMAT_BINARY,
+		FORMAT_PACKED
 	};
 
 	enum SaveResult {
@@ -70,7 +80,8 @@ public:
 private:
 	enum TaskType {
 		TASK_SAVE,
-		TASK_LOAD
+		TASK_LOAD,
+		TASK_AMEND
 	};
 
 	struct SaveTask {
@@ -82,11 +93,17 @@ private:
 		SaveFormat format;
 		String encryption_key;
 		bool compression_enabled;
+		SnapshotHasher::Algorithm checksum_algorithm = SnapshotHasher::ALGORITHM_XXH64;
 
 		// For Async Load
 		ObjectID target_node_id;
 		Callable user_callback;
 		bool dynamic_respawn = false;
+		TypedArray<StringName> subtrees; // Top-level children to restore, empty restores everything.
+		bool batched = false; // Restore across frames, see load_snapshot_batched().
+
+		// For Amend (flattened SaveJournal entries)
+		Array journal_entries;
 	};
 
 	static SaveServer *singleton;
@@ -99,6 +116,9 @@ private:
 	List<SaveTask> queue;
 	mutable Mutex staged_mutex;
 
+	// In-flight writes on the WorkerThreadPool, by slot. Save thread only.
+	HashMap<String, WorkerThreadPool::TaskID> slot_tasks;
+
 	// Configuration
 	SaveFormat current_format = FORMAT_TEXT;
 	String encryption_key;
@@ -109,9 +129,14 @@ private:
 	// Modular/Amend Persistence
 	Ref<Snapshot> base_snapshot;
 	String current_slot_name; // Tracks the context of the base_snapshot
+	SnapshotIndex record_index; // Persistence IDs of base_snapshot, main thread only.
 	HashMap<StringName, ObjectID> id_registry;
 	HashMap<ObjectID, HashSet<StringName>> staged_objects;
-	HashSet<NodePath> staged_deletions;
+	HashMap<NodePath, StringName> staged_deletions; // Path to persistence ID, if any.
+
+	void _set_base_snapshot(const String &p_slot_name, const Dictionary &p_data);
+	// Saves a sanitized slot without touching the base snapshot.
+	void _save_slot(const String &p_slot_name, const Dictionary &p_data, bool p_async, const Dictionary &p_metadata = Dictionary(), const Ref<Resource> &p_thumbnail = Ref<Resource>());
 
 	String save_path = "user://saves/";
 
@@ -125,23 +150,111 @@ private:
 	// ... threading ...
 	static void _save_thread_func(void *p_userdata);
 	void _process_queue();
+	void _push_task(const SaveTask &p_task);
+	void _dispatch_write(const SaveTask &p_task);
+	void _run_write_task(SaveTask *p_task);
+	void _wait_for_writes();
 	void _finish_load_async(const String &p_slot_name, ObjectID p_node_id, const Dictionary &p_data, const Callable &p_callback, bool p_dynamic_respawn);
+	void _finish_load_batched(const String &p_slot_name, ObjectID p_node_id, const Dictionary &p_data, const Callable &p_callback, bool p_dynamic_respawn);
+	void _finish_load_packed(const String &p_slot_name, ObjectID p_node_id, const Array &p_parts, const Callable &p_callback, bool p_dynamic_respawn, const TypedArray<StringName> &p_subtrees);
 	void _queue_save_task(const String &p_slot_name, Ref<Snapshot> p_snapshot, bool p_async);
 	void _merge_dictionaries_recursive(Dictionary &p_target, const Dictionary &p_source);
 
 	Error _save_to_disk(const SaveTask &p_task);
-	Ref<Snapshot> _read_snapshot_from_disk(const String &p_slot_name);
+	static String _get_format_extension(SaveFormat p_format);
+	Ref<FileAccess> _open_binary_for_read(const String &p_path) const;
+	Ref<FileAccess> _open_packed_for_read(const String &p_path) const;
+	Ref<PackedSnapshot> _read_packed_file(Ref<FileAccess> p_file, const HashSet<StringName> *p_subtrees = nullptr);
+	static Error _write_packed_file(Ref<FileAccess> p_file, const Ref<Snapshot> &p_snapshot, const String &p_key, bool p_compress, SnapshotHasher::Algorithm p_algorithm);
+	static Error _write_binary_file(Ref<FileAccess> p_file, const Ref<Snapshot> &p_snapshot, SnapshotHasher::Algorithm p_algorithm);
+	Ref<Snapshot> _read_binary_file(Ref<FileAccess> p_file, bool *r_verified);
+	Ref<Snapshot> _read_snapshot_file(const String &p_path, bool *r_verified = nullptr);
+	Ref<Snapshot> _read_snapshot_from_disk(const String &p_slot_name, bool *r_verified = nullptr);
 	Dictionary _load_from_disk(const String &p_slot_name);
+	Array _load_packed_from_disk(const String &p_slot_name, const HashSet<StringName> *p_subtrees = nullptr);
 
-	String _calculate_checksum(const Dictionary &p_data);
+	SnapshotHasher::Algorithm _get_checksum_algorithm() const;
+	bool _verify_checksum(const Dictionary &p_data, const String &p_checksum) const;
 	void _apply_migrations(Ref<Snapshot> p_snapshot);
 
+	// Time-sliced capture, driven by SceneTree::process_frame.
+	struct CaptureJob {
+		// The tree is listed when the capture starts, so nodes added, removed or moved
+		// while it's sliced don't shift the walk.
+		struct Entry {
+			ObjectID node;
+			StringName name;
+			uint32_t parent = UINT32_MAX; // Index into `entries`, parents precede their children.
+			bool skipped = false; // Freed before being visited, along with its descendants.
+			Dictionary data;
+			Dictionary children;
+		};
+
+		String slot_name;
+		ObjectID root_id;
+		TypedArray<StringName> tags;
+		Dictionary metadata;
+		Ref<Resource> thumbnail;
+
+		LocalVector<Entry> entries;
+		uint32_t next_entry = 1; // The root is captured when starting.
+		Dictionary result;
+	};
+
+	List<CaptureJob> capture_jobs;
+	uint64_t capture_budget_usec = 2000;
+
+	void _process_captures();
+	bool _step_capture(CaptureJob &p_job, uint64_t p_deadline);
+	void _finish_capture(CaptureJob &p_job);
+	void _commit_snapshot(const String &p_main_slot, const Dictionary &p_full_snapshot, const TypedArray<StringName> &p_tags, const Dictionary &p_metadata, const Ref<Resource> &p_thumbnail, bool p_async);
+
+	// Batched restore: scenes to respawn are loaded on threads first, then nodes are
+	// restored across frames, driven by SceneTree::process_frame.
+	struct RestoreJob {
+		struct Frame {
+			ObjectID node;
+			Dictionary data;
+			Dictionary children;
+			Array child_names;
+			HashMap<StringName, ObjectID> existing; // Children of the node, by name.
+			int next_child = 0;
+			bool applied = false;
+		};
+
+		String slot_name;
+		ObjectID root_id;
+		Callable callback;
+		bool dynamic_respawn = false;
+
+		HashSet<String> requested_scenes;
+		LocalVector<String> pending_scenes;
+		HashMap<String, Ref<PackedScene>> scenes;
+
+		LocalVector<Frame> stack;
+		int restored = 0;
+		int total = 0;
+	};
+
+	List<RestoreJob> restore_jobs;
+	uint64_t restore_budget_usec = 4000;
+
+	void _process_restores();
+	void _request_restore_scene(RestoreJob &p_job, const String &p_path);
+	bool _poll_restore_scenes(RestoreJob &p_job);
+	bool _step_restore(RestoreJob &p_job, uint64_t p_deadline);
+	static int _count_records(const Dictionary &p_data);
+
 	// Internal Recursive Logic
+	Dictionary _capture_node(Node *p_node, const TypedArray<StringName> &p_tags);
 	Dictionary _save_node_recursive(Node *p_node, const TypedArray<StringName> &p_tags);
 	Dictionary _filter_snapshot_by_tag(const Dictionary &p_full_snapshot, const StringName &p_tag);
 	void _load_node_recursive(Node *p_node, const Dictionary &p_data, bool p_dynamic_respawn);
+	void _load_packed_snapshot(Node *p_root, const Ref<PackedSnapshot> &p_packed, bool p_dynamic_respawn, HashMap<Node *, HashSet<StringName>> &r_kept_children);
+	void _remove_orphans(Node *p_node, const HashSet<StringName> &p_kept_children);
 	bool _patch_snapshot_data(Dictionary &p_root_data, const NodePath &p_relative_path, const Dictionary &p_new_node_data);
 	bool _remove_node_from_snapshot(Dictionary &p_root_data, const NodePath &p_relative_path);
+	void _amend_base_snapshot(const LocalVector<SaveJournal::Entry> &p_entries);
 
 protected:
 	static void _bind_methods();
@@ -159,7 +272,11 @@ public:
 
 	// Snapshot API (Node-based)
 	bool save_snapshot(Node *p_root, const String &p_slot_name, bool p_async = true, const TypedArray<StringName> &p_tags = TypedArray<StringName>(), const Dictionary &p_metadata = Dictionary(), Ref<Resource> p_thumbnail = Ref<Resource>());
+	bool save_snapshot_sliced(Node *p_root, const String &p_slot_name, const TypedArray<StringName> &p_tags = TypedArray<StringName>(), const Dictionary &p_metadata = Dictionary(), Ref<Resource> p_thumbnail = Ref<Resource>());
+	bool is_capturing(const String &p_slot_name) const;
 	void load_snapshot(Node *p_root, const String &p_slot_name, const Callable &p_callback = Callable(), bool p_dynamic_respawn = false);
+	void load_snapshot_batched(Node *p_root, const String &p_slot_name, const Callable &p_callback = Callable(), bool p_dynamic_respawn = false);
+	void load_snapshot_subtrees(Node *p_root, const String &p_slot_name, const TypedArray<StringName> &p_subtrees, const Callable &p_callback = Callable(), bool p_dynamic_respawn = false);
 	bool has_snapshot(const String &p_slot_name) const { return has_slot(p_slot_name); }
 
 	// Migrations
@@ -176,14 +293,46 @@ public:
 
 	bool amend_save(Node *p_root, const String &p_slot_name);
 
+	// Versions (retained backups)
+	PackedStringArray get_slot_versions(const String &p_slot_name) const;
+	Dictionary load_slot_version(const String &p_slot_name, const String &p_version);
+	Error restore_slot_version(const String &p_slot_name, const String &p_version);
+
 private:
 	// V3.0: Backup & Security System
+	// Backups are keyframes (full copies) or zstd deltas against the previous backup.
+	// Deltas are taken over the decoded contents of the slot file (see _read_backup_contents()),
+	// compressed and encrypted bytes barely match between two versions.
+	struct BackupVersion {
+		String id; // Timestamp.
+		String file;
+		String ext;
+		bool delta = false;
+	};
+
 	void _create_backup(const String &p_slot_name);
 	void _prune_backups(const String &p_slot_name);
-	String _get_latest_backup(const String &p_slot_name);
+	void _list_backups(const String &p_slot_name, LocalVector<BackupVersion> &r_versions) const;
+	Error _read_backup_contents(const String &p_path, const String &p_ext, Vector<uint8_t> &r_data);
+	Error _write_backup_contents(const String &p_path, const String &p_ext, const Vector<uint8_t> &p_data) const;
+	Error _reconstruct_backup(const LocalVector<BackupVersion> &p_versions, uint32_t p_index, Vector<uint8_t> &r_data);
+	Ref<Snapshot> _read_backup(const String &p_slot_name, const String &p_version, bool *r_verified = nullptr);
 	String _sanitize_slot_name(const String &p_slot_name) const;
 
 	int max_backups = 2;
+	int backup_keyframe_interval = 8;
+
+	Mutex backup_mutex;
+	HashMap<String, Pair<String, Vector<uint8_t>>> backup_cache; // Slot -> newest backup (id, contents), saves reconstructing it.
+
+	// Amend Journal
+	String _get_journal_path(const String &p_slot_name) const;
+	void _append_journal(const SaveTask &p_task);
+	bool _replay_journal(const String &p_slot_name, Dictionary &r_data);
+	void _apply_journal_entries(Dictionary &r_data, const LocalVector<SaveJournal::Entry> &p_entries);
+	Error _compact_journal(const SaveTask &p_task, bool p_apply_task);
+
+	uint64_t journal_max_size = 256 * 1024;
 
 	// Configuration
 	void set_save_format(SaveFormat p_format);
@@ -204,6 +353,12 @@ private:
 	void set_max_backups(int p_max);
 	int get_max_backups() const;
 
+	void set_capture_budget_usec(int p_usec);
+	int get_capture_budget_usec() const;
+
+	void set_restore_budget_usec(int p_usec);
+	int get_restore_budget_usec() const;
+
 	void set_integrity_check_level(IntegrityCheckLevel p_level);
 	IntegrityCheckLevel get_integrity_check_level() const;
 
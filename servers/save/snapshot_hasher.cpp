@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  snapshot_hasher.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "snapshot_hasher.h"
+
+#include "core/io/marshalls.h"
+
+// Inlined and privately namespaced, so it doesn't depend on zstd being built from thirdparty.
+#define XXH_INLINE_ALL
+#include "thirdparty/zstd/common/xxhash.h"
+
+void SnapshotHasher::start(Algorithm p_algorithm) {
+	static_assert(sizeof(XXH64_state_t) <= sizeof(xxh64_state));
+
+	algorithm = p_algorithm;
+	if (algorithm == ALGORITHM_SHA256) {
+		sha256.start();
+		return;
+	}
+
+	XXH64_reset((XXH64_state_t *)xxh64_state, 0);
+}
+
+void SnapshotHasher::update(const uint8_t *p_data, size_t p_length) {
+	if (algorithm == ALGORITHM_SHA256) {
+		sha256.update(p_data, p_length);
+		return;
+	}
+
+	XXH64_update((XXH64_state_t *)xxh64_state, p_data, p_length);
+}
+
+void SnapshotHasher::update_variant(const Variant &p_value) {
+	// Containers are walked so only leaf values are ever encoded, in a reused buffer.
+	uint8_t header[8];
+	switch (p_value.get_type()) {
+		case Variant::DICTIONARY: {
+			const Dictionary &dict = p_value;
+			encode_uint32(Variant::DICTIONARY, header);
+			encode_uint32(dict.size(), header + 4);
+			update(header, 8);
+			for (const KeyValue<Variant, Variant> &E : dict) {
+				update_variant(E.key);
+				update_variant(E.value);
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array &array = p_value;
+			encode_uint32(Variant::ARRAY, header);
+			encode_uint32(array.size(), header + 4);
+			update(header, 8);
+			for (const Variant &v : array) {
+				update_variant(v);
+			}
+		} break;
+		default: {
+			int len = 0;
+			Error err = encode_variant(p_value, nullptr, len, true);
+			ERR_FAIL_COND(err != OK);
+			if (scratch.size() < len) {
+				scratch.resize(len);
+			}
+			encode_variant(p_value, scratch.ptrw(), len, true);
+			update(scratch.ptr(), len);
+		} break;
+	}
+}
+
+String SnapshotHasher::finish() {
+	if (algorithm == ALGORITHM_SHA256) {
+		unsigned char hash[32];
+		sha256.finish(hash);
+		return "sha256:" + String::hex_encode_buffer(hash, 32);
+	}
+
+	XXH64_canonical_t hash; // Big endian.
+	XXH64_canonicalFromHash(&hash, XXH64_digest((const XXH64_state_t *)xxh64_state));
+	return "xxh64:" + String::hex_encode_buffer(hash.digest, 8);
+}
+
+uint64_t SnapshotHasher::xxh64(const uint8_t *p_data, size_t p_length) {
+	return XXH64(p_data, p_length, 0);
+}
+
+String SnapshotHasher::hash_variant(const Variant &p_value, Algorithm p_algorithm) {
+	SnapshotHasher hasher;
+	hasher.start(p_algorithm);
+	hasher.update_variant(p_value);
+	return hasher.finish();
+}
+
+bool SnapshotHasher::parse_algorithm(const String &p_checksum, Algorithm &r_algorithm) {
+	if (p_checksum.begins_with("xxh64:")) {
+		r_algorithm = ALGORITHM_XXH64;
+		return true;
+	}
+	if (p_checksum.begins_with("sha256:")) {
+		r_algorithm = ALGORITHM_SHA256;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  snapshot_hasher.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/crypto/crypto_core.h"
+#include "core/variant/variant.h"
+
+// Streaming integrity hash of snapshot data. Binary and packed saves feed it the encoding
+// as it's written, update_variant() walks decoded values for text saves and older files.
+//
+// Checksums are stored as "<algorithm>:<hex digest>". XXH64 is used for signature checks,
+// SHA-256 for strict ones.
+class SnapshotHasher {
+public:
+	enum Algorithm {
+		ALGORITHM_XXH64,
+		ALGORITHM_SHA256,
+	};
+
+private:
+	Algorithm algorithm = ALGORITHM_XXH64;
+
+	// XXH64_state_t of the bundled xxHash, kept opaque so it's only included by the implementation.
+	alignas(8) uint8_t xxh64_state[88] = {};
+
+	CryptoCore::SHA256Context sha256;
+
+	Vector<uint8_t> scratch;
+
+public:
+	void start(Algorithm p_algorithm);
+	void update(const uint8_t *p_data, size_t p_length);
+	void update_variant(const Variant &p_value);
+	String finish();
+
+	static uint64_t xxh64(const uint8_t *p_data, size_t p_length);
+	static String hash_variant(const Variant &p_value, Algorithm p_algorithm);
+	// Returns false if the checksum is not in the "<algorithm>:<hex digest>" form.
+	static bool parse_algorithm(const String &p_checksum, Algorithm &r_algorithm);
+};
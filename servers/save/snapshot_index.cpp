@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  snapshot_index.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "snapshot_index.h"
+
+void SnapshotIndex::merge_record(Dictionary &p_record, const Dictionary &p_new_data) {
+	// Store children before overwrite
+	Variant children = p_record.get(".children", Variant());
+
+	p_record.merge(p_new_data, true);
+
+	// Restore children map
+	if (children.get_type() == Variant::DICTIONARY) {
+		p_record[".children"] = children;
+	}
+}
+
+void SnapshotIndex::_index_recursive(const Dictionary &p_data, const Dictionary &p_parent, const StringName &p_name, Vector<StringName> &r_path) {
+	Variant id = p_data.get(".id", Variant());
+	if (id.get_type() == Variant::STRING_NAME || id.get_type() == Variant::STRING) {
+		Record record;
+		record.data = p_data;
+		record.parent = p_parent;
+		record.name = p_name;
+		record.path = NodePath(r_path, false);
+		records[id] = record;
+	}
+
+	Variant children = p_data.get(".children", Variant());
+	if (children.get_type() != Variant::DICTIONARY) {
+		return;
+	}
+
+	Dictionary children_data = children;
+	for (const KeyValue<Variant, Variant> &E : children_data) {
+		if (E.value.get_type() != Variant::DICTIONARY) {
+			continue;
+		}
+		StringName child_name = E.key;
+		r_path.push_back(child_name);
+		_index_recursive(E.value, p_data, child_name, r_path);
+		r_path.resize(r_path.size() - 1);
+	}
+}
+
+void SnapshotIndex::_unindex_recursive(const Dictionary &p_data) {
+	Variant id = p_data.get(".id", Variant());
+	if (id.get_type() == Variant::STRING_NAME || id.get_type() == Variant::STRING) {
+		records.erase(id);
+	}
+
+	Variant children = p_data.get(".children", Variant());
+	if (children.get_type() != Variant::DICTIONARY) {
+		return;
+	}
+
+	Dictionary children_data = children;
+	for (const KeyValue<Variant, Variant> &E : children_data) {
+		if (E.value.get_type() == Variant::DICTIONARY) {
+			_unindex_recursive(E.value);
+		}
+	}
+}
+
+void SnapshotIndex::_unindex_packed_descendants(const NodePath &p_path) {
+	LocalVector<StringName> descendants;
+	for (const KeyValue<StringName, Record> &E : records) {
+		const NodePath &path = E.value.path;
+		if (path.get_name_count() <= p_path.get_name_count()) {
+			continue;
+		}
+		bool inside = true;
+		for (int i = 0; i < p_path.get_name_count() && inside; i++) {
+			inside = path.get_name(i) == p_path.get_name(i);
+		}
+		if (inside) {
+			descendants.push_back(E.key);
+		}
+	}
+
+	for (const StringName &id : descendants) {
+		records.erase(id);
+	}
+}
+
+void SnapshotIndex::build(const Dictionary &p_root) {
+	records.clear();
+	Vector<StringName> path;
+	_index_recursive(p_root, Dictionary(), StringName(), path);
+}
+
+void SnapshotIndex::add_packed_chunk(const PackedSnapshot::Chunk &p_chunk) {
+	// Records are stored parents first, so the path of the parent is always known.
+	LocalVector<Vector<StringName>> paths;
+	paths.resize(p_chunk.records.size());
+
+	for (uint32_t i = 0; i < p_chunk.records.size(); i++) {
+		const PackedSnapshot::Record &packed = p_chunk.records[i];
+		if (packed.parent != PackedSnapshot::NO_INDEX) {
+			paths[i] = paths[packed.parent];
+			paths[i].push_back(p_chunk.names[packed.name]);
+		} else if (!p_chunk.is_root()) {
+			// Direct child of the root in subtree chunks, the root itself otherwise.
+			paths[i].push_back(p_chunk.names[packed.name]);
+		}
+
+		if (packed.id == PackedSnapshot::NO_INDEX) {
+			continue;
+		}
+		Record record;
+		record.name = paths[i].is_empty() ? StringName() : paths[i][paths[i].size() - 1];
+		record.path = NodePath(paths[i], false);
+		records[p_chunk.names[packed.id]] = record;
+	}
+}
+
+const SnapshotIndex::Record *SnapshotIndex::find(const StringName &p_id) const {
+	HashMap<StringName, Record>::ConstIterator E = records.find(p_id);
+	return E ? &E->value : nullptr;
+}
+
+bool SnapshotIndex::patch(const StringName &p_id, const Dictionary &p_new_data) {
+	HashMap<StringName, Record>::Iterator E = records.find(p_id);
+	if (!E) {
+		return false;
+	}
+
+	merge_record(E->value.data, p_new_data);
+	return true;
+}
+
+bool SnapshotIndex::remove(const StringName &p_id) {
+	HashMap<StringName, Record>::Iterator E = records.find(p_id);
+	if (!E) {
+		return false;
+	}
+
+	Record record = E->value;
+	records.erase(p_id);
+
+	if (record.data.is_empty()) {
+		// Packed record, there is no data to walk: descendants are found by their path.
+		_unindex_packed_descendants(record.path);
+		return true;
+	}
+
+	_unindex_recursive(record.data);
+
+	if (record.parent.is_empty()) {
+		// Root of the snapshot.
+		record.data.clear();
+		return true;
+	}
+
+	Dictionary children = record.parent.get(".children", Dictionary());
+	children.erase(record.name);
+
+	// Cleanup parent if no children left
+	if (children.is_empty()) {
+		record.parent.erase(".children");
+	}
+	return true;
+}
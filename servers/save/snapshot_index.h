@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  snapshot_index.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "packed_snapshot.h"
+
+#include "core/string/node_path.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Maps the persistence IDs (`.id`) of a snapshot to their records.
+//
+// Records are the nested dictionaries of the snapshot itself (shared, not copied), so
+// patching or removing through the index edits the snapshot directly, without walking
+// `.children` by path. Nodes that were renamed or moved since the snapshot was taken
+// are still found by their ID.
+//
+// Packed snapshots have no nested dictionaries to share, their records only carry a name and a path.
+class SnapshotIndex {
+public:
+	struct Record {
+		Dictionary data;
+		Dictionary parent; // Record of the parent node, empty for the root.
+		StringName name;
+		NodePath path; // Relative to the root of the snapshot.
+	};
+
+private:
+	HashMap<StringName, Record> records;
+
+	void _index_recursive(const Dictionary &p_data, const Dictionary &p_parent, const StringName &p_name, Vector<StringName> &r_path);
+	void _unindex_recursive(const Dictionary &p_data);
+	void _unindex_packed_descendants(const NodePath &p_path);
+
+public:
+	// Merges `p_new_data` into a record, keeping its children.
+	static void merge_record(Dictionary &p_record, const Dictionary &p_new_data);
+
+	void build(const Dictionary &p_root);
+	// Adds the records of a packed chunk, replacing the ones with the same ID.
+	void add_packed_chunk(const PackedSnapshot::Chunk &p_chunk);
+	void clear() { records.clear(); }
+
+	const Record *find(const StringName &p_id) const;
+	bool patch(const StringName &p_id, const Dictionary &p_new_data);
+	bool remove(const StringName &p_id);
+
+	int size() const { return records.size(); }
+};
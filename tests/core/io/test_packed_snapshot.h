@@ -0,0 +1,230 @@
+/**************************************************************************/
+/*  test_packed_snapshot.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "scene/resources/snapshot.h"
+#include "servers/save/packed_snapshot.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestPackedSnapshot {
+
+// A root with a player subtree and many enemies sharing a layout, so values end up in typed columns.
+static Dictionary create_snapshot_data() {
+	Dictionary root_general;
+	root_general["level"] = "Forest";
+	root_general["time"] = 12.5;
+	Dictionary root;
+	root[".id"] = StringName("world");
+	root["general"] = root_general;
+	root["flags"] = Array();
+
+	Dictionary weapon_general;
+	weapon_general["damage"] = 7;
+	weapon_general["owner_path"] = NodePath("../..");
+	Dictionary weapon;
+	weapon["general"] = weapon_general;
+
+	Dictionary player_children;
+	player_children["Weapon"] = weapon;
+	Dictionary player_general;
+	player_general["health"] = 100;
+	player_general["position"] = Vector2(3, 4);
+	player_general["alive"] = true;
+	Dictionary player;
+	player[".id"] = StringName("player");
+	player[".scene"] = "res://player.tscn";
+	player["general"] = player_general;
+	player[".children"] = player_children;
+
+	Dictionary enemies_children;
+	for (int i = 0; i < 20; i++) {
+		Dictionary enemy_general;
+		enemy_general["health"] = i * 10;
+		enemy_general["speed"] = i * 0.5;
+		enemy_general["name"] = vformat("Enemy %d", i);
+		// Mixed types in a single column are stored as plain variants.
+		enemy_general["loot"] = i % 2 ? Variant(i) : Variant("none");
+		Dictionary enemy;
+		enemy[".scene"] = "res://enemy.tscn";
+		enemy["general"] = enemy_general;
+		enemies_children[vformat("Enemy%d", i)] = enemy;
+	}
+	Dictionary enemies;
+	enemies[".children"] = enemies_children;
+
+	Dictionary root_children;
+	root_children["Player"] = player;
+	root_children["Enemies"] = enemies;
+	root[".children"] = root_children;
+	return root;
+}
+
+static Ref<PackedSnapshot> save_and_load(const Dictionary &p_data, const String &p_key, bool p_compress, bool p_sha256, const HashSet<StringName> *p_subtrees = nullptr) {
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(p_data);
+	snapshot->set_version("1.2");
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+	ERR_FAIL_COND_V(packed.is_null(), Ref<PackedSnapshot>());
+
+	const String path = TestUtils::get_temp_path("packed_snapshot.snap");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		ERR_FAIL_COND_V(f.is_null(), Ref<PackedSnapshot>());
+		ERR_FAIL_COND_V(packed->save(f, p_key, p_compress, p_sha256) != OK, Ref<PackedSnapshot>());
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	ERR_FAIL_COND_V(f.is_null() || !PackedSnapshot::is_packed_file(f), Ref<PackedSnapshot>());
+	Ref<PackedSnapshot> loaded;
+	loaded.instantiate();
+	ERR_FAIL_COND_V(loaded->load(f, p_key, true, p_subtrees) != OK, Ref<PackedSnapshot>());
+	return loaded;
+}
+
+TEST_CASE("[PackedSnapshot] Round-trips through a file") {
+	const Dictionary data = create_snapshot_data();
+
+	SUBCASE("Plain") {
+		Ref<PackedSnapshot> loaded = save_and_load(data, String(), false, false);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->is_checksum_valid());
+		CHECK(loaded->get_version() == "1.2");
+		CHECK(loaded->to_dictionary() == data);
+	}
+
+	SUBCASE("Compressed and encrypted") {
+		Ref<PackedSnapshot> loaded = save_and_load(data, "secret", true, false);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->is_checksum_valid());
+		CHECK(loaded->to_dictionary() == data);
+	}
+
+	SUBCASE("SHA-256 hashes") {
+		Ref<PackedSnapshot> loaded = save_and_load(data, String(), true, true);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->is_checksum_valid());
+		CHECK(loaded->get_checksum().length() == 64);
+		CHECK(loaded->to_dictionary() == data);
+	}
+}
+
+TEST_CASE("[PackedSnapshot] Subtrees are read on their own") {
+	const Dictionary data = create_snapshot_data();
+	const Dictionary root_children = data[".children"];
+
+	HashSet<StringName> subtrees;
+	subtrees.insert("Player");
+	Ref<PackedSnapshot> loaded = save_and_load(data, "secret", true, false, &subtrees);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->is_checksum_valid());
+
+	// Only the requested chunk is read, but every subtree of the file is still listed.
+	REQUIRE(loaded->get_chunks().size() == 1);
+	CHECK(loaded->get_chunks()[0].subtree == StringName("Player"));
+	CHECK(loaded->get_subtree_names().size() == 2);
+
+	Dictionary loaded_children = loaded->to_dictionary()[".children"];
+	CHECK(loaded_children.size() == 1);
+	CHECK(loaded_children["Player"] == root_children["Player"]);
+
+	// Filtering chunks already in memory gives the same result.
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(data);
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+	packed->filter_subtrees(subtrees);
+	CHECK(packed->to_dictionary() == loaded->to_dictionary());
+}
+
+TEST_CASE("[PackedSnapshot] Nodes sharing fields share a layout") {
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(create_snapshot_data());
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+	REQUIRE(packed.is_valid());
+
+	// The root chunk, then one chunk per top-level subtree.
+	const LocalVector<PackedSnapshot::Chunk> &chunks = packed->get_chunks();
+	REQUIRE(chunks.size() == 3);
+	CHECK(chunks[0].is_root());
+	CHECK(packed->get_subtree_names().size() == 2);
+
+	for (const PackedSnapshot::Chunk &chunk : chunks) {
+		if (chunk.subtree != StringName("Enemies")) {
+			continue;
+		}
+		CHECK(chunk.records.size() == 21);
+		REQUIRE(chunk.layouts.size() == 1);
+		const PackedSnapshot::Layout &layout = chunk.layouts[0];
+		CHECK(layout.rows == 20);
+		for (uint32_t i = 0; i < layout.fields.size(); i++) {
+			const StringName &property = chunk.names[layout.fields[i].property];
+			if (property == StringName("health")) {
+				CHECK(layout.columns[i].encoding == PackedSnapshot::COLUMN_INT);
+			} else if (property == StringName("speed")) {
+				CHECK(layout.columns[i].encoding == PackedSnapshot::COLUMN_FLOAT);
+			} else if (property == StringName("name")) {
+				CHECK(layout.columns[i].encoding == PackedSnapshot::COLUMN_STRING);
+			} else if (property == StringName("loot")) {
+				CHECK(layout.columns[i].encoding == PackedSnapshot::COLUMN_VARIANT);
+			}
+		}
+	}
+}
+
+TEST_CASE("[PackedSnapshot] Loading with the wrong key is detected") {
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(create_snapshot_data());
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+
+	const String path = TestUtils::get_temp_path("packed_snapshot_key.snap");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		REQUIRE(packed->save(f, "secret", true, false) == OK);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	Ref<PackedSnapshot> loaded;
+	loaded.instantiate();
+	ERR_PRINT_OFF;
+	Error err = loaded->load(f, "wrong", true);
+	ERR_PRINT_ON;
+	CHECK((err != OK || !loaded->is_checksum_valid()));
+}
+
+} // namespace TestPackedSnapshot
@@ -116,4 +116,164 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Packs without compressed entries keep the previous format version") {
+	const String source_path = TestUtils::get_temp_path("version_source.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (int i = 0; i < 200; i++) {
+			f->store_line("Compressible line of text.");
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		const bool compressed = i == 1;
+		PCKPacker pck_packer;
+		const String output_pck_path = TestUtils::get_temp_path("output_version.pck");
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		pck_packer.set_compression_enabled(compressed);
+		REQUIRE(pck_packer.add_file("version_source.txt", source_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(
+				f->get_32() == (compressed ? PACK_FORMAT_VERSION_V4 : PACK_FORMAT_VERSION_V3),
+				"Only packs with compressed entries should need the newer format version.");
+	}
+}
+
+TEST_CASE("[PCKPacker] Read files from a loaded PCK") {
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_mapped.pck");
+	const String source_path = OS::get_singleton()->get_executable_path().get_base_dir().path_join("../version.py");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("test_mapped_pack/version.py", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://test_mapped_pack/version.py");
+	REQUIRE(f.is_valid());
+	const Vector<uint8_t> expected = FileAccess::get_file_as_bytes(source_path);
+	REQUIRE(f->get_length() == (uint64_t)expected.size());
+
+#ifdef LINUXBSD_ENABLED
+	// Uncompressed entries of packs on disk are mapped, so they can be read in place.
+	Span<uint8_t> span = f->get_buffer_span(expected.size());
+	CHECK_MESSAGE(
+			span.size() == (uint64_t)expected.size(),
+			"The whole file should be readable as a span from the mapped pack.");
+	CHECK(memcmp(span.ptr(), expected.ptr(), expected.size()) == 0);
+	CHECK(f->get_position() == f->get_length());
+	CHECK_MESSAGE(
+			f->get_buffer_span(1).is_empty(),
+			"Reading a span past the end of the file should fail.");
+	f->seek(0);
+#endif
+
+	CHECK_MESSAGE(
+			f->get_buffer(expected.size()) == expected,
+			"Reading the packed file should return the original contents.");
+
+	PackedData::get_singleton()->remove_path("res://test_mapped_pack/version.py");
+}
+
+TEST_CASE("[PCKPacker] Read compressed files from a loaded PCK") {
+	// Spans several compression blocks, with a partial one at the end.
+	Vector<uint8_t> expected;
+	expected.resize(PACK_COMPRESSED_BLOCK_SIZE * 5 + 1234);
+	for (int i = 0; i < expected.size(); i++) {
+		expected.write[i] = (i / 7) % 61;
+	}
+	const String source_path = TestUtils::get_temp_path("compressed_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(expected);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compression_enabled(true);
+	REQUIRE(pck_packer.add_file("test_compressed_pack/data.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < expected.size(),
+			"The PCK file should be smaller than the repetitive file it contains.");
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://test_compressed_pack/data.bin");
+	REQUIRE(f.is_valid());
+	REQUIRE(f->get_length() == (uint64_t)expected.size());
+	CHECK_MESSAGE(
+			f->get_buffer_span(16).is_empty(),
+			"Compressed files can't be read in place.");
+
+	SUBCASE("Whole file at once") {
+		CHECK(f->get_buffer(expected.size()) == expected);
+		CHECK(f->get_position() == f->get_length());
+	}
+
+	SUBCASE("Small sequential reads") {
+		Vector<uint8_t> read;
+		read.resize(expected.size());
+		uint64_t pos = 0;
+		while (pos < (uint64_t)expected.size()) {
+			uint64_t chunk = MIN((uint64_t)1000, (uint64_t)expected.size() - pos);
+			CHECK(f->get_buffer(read.ptrw() + pos, chunk) == chunk);
+			pos += chunk;
+		}
+		CHECK(read == expected);
+	}
+
+	SUBCASE("Unaligned reads across blocks") {
+		const uint64_t from = PACK_COMPRESSED_BLOCK_SIZE / 2;
+		const uint64_t length = PACK_COMPRESSED_BLOCK_SIZE * 3;
+		f->seek(from);
+		Vector<uint8_t> read = f->get_buffer(length);
+		REQUIRE(read.size() == (int64_t)length);
+		CHECK(memcmp(read.ptr(), expected.ptr() + from, length) == 0);
+
+		f->seek(expected.size() - 10);
+		read = f->get_buffer(100);
+		REQUIRE(read.size() == 10);
+		CHECK(memcmp(read.ptr(), expected.ptr() + expected.size() - 10, 10) == 0);
+		CHECK(f->eof_reached());
+	}
+
+	SUBCASE("Sequential reads handed over between tasks") {
+		// The read-ahead tasks posted by the first task are older than the second one,
+		// which can't await them and must leave their blocks alone.
+		struct Reader {
+			Ref<FileAccess> file;
+			Vector<uint8_t> read;
+			uint64_t from = 0;
+			uint64_t to = 0;
+			static void read_range(void *p_userdata) {
+				Reader *reader = (Reader *)p_userdata;
+				for (uint64_t pos = reader->from; pos < reader->to; pos += 1000) {
+					uint64_t chunk = MIN((uint64_t)1000, reader->to - pos);
+					reader->file->get_buffer(reader->read.ptrw() + pos, chunk);
+				}
+			}
+		};
+		Reader reader;
+		reader.file = f;
+		reader.read.resize(expected.size());
+		reader.to = PACK_COMPRESSED_BLOCK_SIZE * 2;
+		WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(&Reader::read_range, &reader);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+
+		reader.from = reader.to;
+		reader.to = expected.size();
+		WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task(&Reader::read_range, &reader);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+		CHECK(reader.read == expected);
+	}
+
+	PackedData::get_singleton()->remove_path("res://test_compressed_pack/data.bin");
+}
 } // namespace TestPCKPacker
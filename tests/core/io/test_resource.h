@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -573,6 +574,39 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Threaded loading with dependency prefetch") {
+	const String save_path_child = TestUtils::get_temp_path("prefetch_child.res");
+	const String save_path_parent = TestUtils::get_temp_path("prefetch_parent.res");
+	{
+		Ref<Resource> child_resource = memnew(Resource);
+		child_resource->set_name("I'm an external child resource");
+		ResourceSaver::save(child_resource, save_path_child, ResourceSaver::FLAG_CHANGE_PATH | ResourceSaver::FLAG_COMPRESS);
+
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name("Hello world");
+		resource->set_meta("other_resource", child_resource);
+		ResourceSaver::save(resource, save_path_parent);
+	}
+	// Both resources are out of the cache now, so the whole closure gets read ahead.
+	REQUIRE_FALSE(ResourceCache::has(save_path_child));
+
+	const uint64_t prefetch_hits = ResourceLoader::get_prefetch_hit_count();
+	CHECK(ResourceLoader::load_threaded_request(save_path_parent, "", true) == OK);
+	const Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path_parent);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Hello world");
+	const Ref<Resource> loaded_child_resource = loaded_resource->get_meta("other_resource");
+	REQUIRE(loaded_child_resource.is_valid());
+	CHECK(loaded_child_resource->get_name() == "I'm an external child resource");
+
+	CHECK_MESSAGE(
+			ResourceLoader::get_prefetch_hit_count() - prefetch_hits == 2,
+			"Both the resource and its dependency should be loaded from read-ahead data.");
+	CHECK_MESSAGE(
+			ResourceLoader::take_prefetched_file(ProjectSettings::get_singleton()->localize_path(save_path_child)).is_null(),
+			"Read-ahead data should be consumed or released once the load finishes.");
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
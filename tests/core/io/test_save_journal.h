@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_save_journal.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/save/save_journal.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSaveJournal {
+
+static SaveJournal::Entry create_patch(const NodePath &p_path, int p_health) {
+	Dictionary general;
+	general["health"] = p_health;
+	SaveJournal::Entry entry;
+	entry.op = SaveJournal::OP_PATCH;
+	entry.path = p_path;
+	entry.data["general"] = general;
+	return entry;
+}
+
+static SaveJournal::Entry create_removal(const NodePath &p_path) {
+	SaveJournal::Entry entry;
+	entry.op = SaveJournal::OP_REMOVE;
+	entry.path = p_path;
+	return entry;
+}
+
+static String get_journal_path(const String &p_name) {
+	const String path = TestUtils::get_temp_path(p_name);
+	if (FileAccess::exists(path)) {
+		DirAccess::remove_absolute(path);
+	}
+	return path;
+}
+
+static void check_entry(const SaveJournal::Entry &p_entry, const SaveJournal::Entry &p_expected) {
+	CHECK(p_entry.op == p_expected.op);
+	CHECK(p_entry.path == p_expected.path);
+	CHECK(p_entry.data == p_expected.data);
+}
+
+TEST_CASE("[SaveJournal] Frames are replayed in order") {
+	const String path = get_journal_path("journal_replay.journal");
+
+	LocalVector<SaveJournal::Entry> first;
+	first.push_back(create_patch(NodePath("Player"), 10));
+	first.push_back(create_removal(NodePath("Enemies/Enemy1")));
+	LocalVector<SaveJournal::Entry> second;
+	second.push_back(create_patch(NodePath("Player"), 20));
+
+	SUBCASE("Plain") {
+		REQUIRE(SaveJournal::append(path, first, String()) == OK);
+		REQUIRE(SaveJournal::append(path, second, String()) == OK);
+
+		LocalVector<SaveJournal::Entry> entries;
+		REQUIRE(SaveJournal::read(path, String(), entries) == OK);
+		REQUIRE(entries.size() == 3);
+		check_entry(entries[0], first[0]);
+		check_entry(entries[1], first[1]);
+		check_entry(entries[2], second[0]);
+	}
+
+	SUBCASE("Encrypted") {
+		REQUIRE(SaveJournal::append(path, first, "secret") == OK);
+		REQUIRE(SaveJournal::append(path, second, "secret") == OK);
+
+		LocalVector<SaveJournal::Entry> entries;
+		REQUIRE(SaveJournal::read(path, "secret", entries) == OK);
+		REQUIRE(entries.size() == 3);
+		check_entry(entries[2], second[0]);
+
+		ERR_PRINT_OFF;
+		LocalVector<SaveJournal::Entry> without_key;
+		CHECK(SaveJournal::read(path, String(), without_key) != OK);
+		ERR_PRINT_ON;
+	}
+
+	CHECK(SaveJournal::get_size(path) > 0);
+}
+
+TEST_CASE("[SaveJournal] A torn frame is discarded and truncated by the next append") {
+	const String path = get_journal_path("journal_torn.journal");
+
+	LocalVector<SaveJournal::Entry> first;
+	first.push_back(create_patch(NodePath("Player"), 10));
+	LocalVector<SaveJournal::Entry> second;
+	second.push_back(create_patch(NodePath("Player"), 20));
+	LocalVector<SaveJournal::Entry> third;
+	third.push_back(create_patch(NodePath("Player"), 30));
+
+	REQUIRE(SaveJournal::append(path, first, String()) == OK);
+	REQUIRE(SaveJournal::append(path, second, String()) == OK);
+
+	// Cut the second frame short, as a crash while appending would.
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		REQUIRE(f->resize(f->get_length() - 3) == OK);
+	}
+
+	ERR_PRINT_OFF;
+	LocalVector<SaveJournal::Entry> entries;
+	CHECK(SaveJournal::read(path, String(), entries) == OK);
+	REQUIRE(entries.size() == 1);
+	check_entry(entries[0], first[0]);
+
+	// Appending drops the torn frame, or the new one would never be replayed.
+	REQUIRE(SaveJournal::append(path, third, String()) == OK);
+	ERR_PRINT_ON;
+
+	entries.clear();
+	REQUIRE(SaveJournal::read(path, String(), entries) == OK);
+	REQUIRE(entries.size() == 2);
+	check_entry(entries[0], first[0]);
+	check_entry(entries[1], third[0]);
+}
+
+TEST_CASE("[SaveJournal] Entries round-trip through arrays") {
+	LocalVector<SaveJournal::Entry> entries;
+	entries.push_back(create_patch(NodePath("Player"), 10));
+	entries.push_back(create_removal(NodePath("Enemies/Enemy1")));
+
+	LocalVector<SaveJournal::Entry> restored;
+	SaveJournal::entries_from_array(SaveJournal::entries_to_array(entries), restored);
+	REQUIRE(restored.size() == 2);
+	check_entry(restored[0], entries[0]);
+	check_entry(restored[1], entries[1]);
+}
+
+} // namespace TestSaveJournal
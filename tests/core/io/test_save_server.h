@@ -0,0 +1,449 @@
+/**************************************************************************/
+/*  test_save_server.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/object/message_queue.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "servers/save/save_server.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSaveServer {
+
+// Points the SaveServer at an empty folder with the given settings, and puts the previous ones back afterwards.
+class SaveServerScope {
+	SaveServer *server = nullptr;
+	Variant previous_path;
+	Variant previous_format;
+	Variant previous_key;
+	Variant previous_project_key;
+	Variant previous_max_backups;
+	Variant previous_backup_enabled;
+	Variant previous_integrity_level;
+	Variant previous_capture_budget;
+	Variant previous_restore_budget;
+	Variant previous_compression_enabled;
+
+public:
+	String path;
+	String key;
+
+	SaveServerScope(const String &p_folder, SaveServer::SaveFormat p_format, const String &p_key = String()) {
+		server = SaveServer::get_singleton();
+		path = TestUtils::get_temp_path("save_server").path_join(p_folder);
+		key = p_key;
+
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		if (da->dir_exists(path) && da->change_dir(path) == OK) {
+			da->erase_contents_recursive();
+		}
+		da->make_dir_recursive(path);
+
+		previous_path = server->get("save_path");
+		previous_format = server->get("save_format");
+		previous_key = server->get("encryption_key");
+		previous_project_key = GLOBAL_GET("application/persistence/encryption_key");
+		previous_max_backups = server->get("max_backups");
+		previous_backup_enabled = server->get("backup_enabled");
+		previous_integrity_level = server->get("integrity_check_level");
+		previous_capture_budget = server->get("capture_budget_usec");
+		previous_restore_budget = server->get("restore_budget_usec");
+		previous_compression_enabled = server->get("compression_enabled");
+
+		server->set("save_path", path);
+		server->set("save_format", p_format);
+		server->set("encryption_key", p_key);
+		ProjectSettings::get_singleton()->set_setting("application/persistence/encryption_key", p_key);
+		server->set("max_backups", 8);
+		server->set("backup_enabled", true);
+		server->set("integrity_check_level", SaveServer::INTEGRITY_SIGNATURE);
+	}
+
+	~SaveServerScope() {
+		server->set("save_path", previous_path);
+		server->set("save_format", previous_format);
+		server->set("encryption_key", previous_key);
+		ProjectSettings::get_singleton()->set_setting("application/persistence/encryption_key", previous_project_key);
+		server->set("max_backups", previous_max_backups);
+		server->set("backup_enabled", previous_backup_enabled);
+		server->set("integrity_check_level", previous_integrity_level);
+		server->set("capture_budget_usec", previous_capture_budget);
+		server->set("restore_budget_usec", previous_restore_budget);
+		server->set("compression_enabled", previous_compression_enabled);
+	}
+
+	// Contents of a binary slot file, decrypted.
+	Vector<uint8_t> read_contents(const String &p_file) const {
+		Ref<FileAccess> f = key.is_empty() ? FileAccess::open(path.path_join(p_file), FileAccess::READ) : FileAccess::open_encrypted_pass(path.path_join(p_file), FileAccess::READ, key);
+		if (f.is_null()) {
+			return Vector<uint8_t>();
+		}
+		return f->get_buffer(f->get_length());
+	}
+};
+
+// Counts the save notifications it receives.
+class SaveNotificationNode : public Node {
+	GDCLASS(SaveNotificationNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_SAVE_PREPARE) {
+			prepared++;
+		} else if (p_what == NOTIFICATION_SAVE_COMPLETED) {
+			completed++;
+		}
+	}
+
+public:
+	int prepared = 0;
+	int completed = 0;
+};
+
+// Persists a single integer.
+class PersistentValueNode : public Node {
+	GDCLASS(PersistentValueNode, Node);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &PersistentValueNode::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &PersistentValueNode::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_PERSISTENCE), "set_value", "get_value");
+	}
+
+public:
+	void set_value(int p_value) { value = p_value; }
+	int get_value() const { return value; }
+};
+
+static PersistentValueNode *add_value_node(Node *p_parent, const String &p_name, int p_value) {
+	PersistentValueNode *node = memnew(PersistentValueNode);
+	node->set_name(p_name);
+	node->set_value(p_value);
+	p_parent->add_child(node);
+	return node;
+}
+
+// Runs frames and deferred calls until `p_condition` holds, which is how threaded loads get back to the tree.
+template <typename F>
+static bool wait_until(F p_condition) {
+	for (int i = 0; i < 5000; i++) {
+		MessageQueue::get_singleton()->flush();
+		SceneTree::get_singleton()->process(0);
+		if (p_condition()) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+static Dictionary create_slot_data(int p_entries) {
+	Dictionary data;
+	for (int i = 0; i < p_entries; i++) {
+		data[vformat("entry_%d", i)] = vformat("Value of entry %d, long enough to matter.", i);
+	}
+	return data;
+}
+
+TEST_CASE("[SceneTree][SaveServer] Backups of encrypted slots are stored as small deltas") {
+	SaveServerScope scope("backup_delta", SaveServer::FORMAT_BINARY, "0123456789abcdef0123456789abcdef");
+	SaveServer *server = SaveServer::get_singleton();
+
+	Dictionary data = create_slot_data(500);
+	server->save_slot("slot", data, false);
+	data["entry_0"] = "First change.";
+	server->save_slot("slot", data, false);
+	const Vector<uint8_t> second = scope.read_contents("slot.data");
+	REQUIRE(!second.is_empty());
+
+	// Backups are named after the second they were taken in, a save within the same second replaces the newest.
+	OS::get_singleton()->delay_usec(1100000);
+	data["entry_1"] = "Second change.";
+	server->save_slot("slot", data, false);
+
+	PackedStringArray versions = server->get_slot_versions("slot");
+	REQUIRE(versions.size() == 2);
+
+	// The first backup is a keyframe, the second a delta against it.
+	String delta_path = scope.path.path_join("backups").path_join("slot_" + versions[1] + ".data.delta");
+	REQUIRE(FileAccess::exists(delta_path));
+	const uint64_t delta_size = FileAccess::get_file_as_bytes(delta_path).size();
+	CHECK_MESSAGE(delta_size < (uint64_t)second.size() / 10, vformat("A one-entry change should make a small delta, got %d bytes for %d.", (int64_t)delta_size, second.size()));
+
+	CHECK(String(server->load_slot_version("slot", versions[1])["entry_0"]) == "First change.");
+
+	// Restoring rewrites the slot with a fresh IV, what it decrypts to must match exactly.
+	REQUIRE(server->restore_slot_version("slot", versions[1]) == OK);
+	CHECK(scope.read_contents("slot.data") == second);
+	Dictionary restored = server->load_slot("slot");
+	CHECK(String(restored["entry_0"]) == "First change.");
+	CHECK(String(restored["entry_1"]) == "Value of entry 1, long enough to matter.");
+}
+
+TEST_CASE("[SceneTree][SaveServer] Binary slots are verified against the hash written with them") {
+	SaveServerScope scope("integrity", SaveServer::FORMAT_BINARY);
+	SaveServer *server = SaveServer::get_singleton();
+	server->set("backup_enabled", false);
+
+	// Small enough to be stored uncompressed, so a value can be altered in place.
+	Dictionary data = create_slot_data(5);
+	server->save_slot("slot", data, false);
+	CHECK(server->load_slot("slot") == data);
+
+	const String path = scope.path.path_join("slot.data");
+	Vector<uint8_t> contents = FileAccess::get_file_as_bytes(path);
+	const CharString value = String("entry 3").utf8();
+	int offset = -1;
+	for (int i = 0; i + value.length() <= contents.size() && offset < 0; i++) {
+		if (memcmp(contents.ptr() + i, value.get_data(), value.length()) == 0) {
+			offset = i;
+		}
+	}
+	REQUIRE(offset >= 0);
+	contents.write[offset + value.length() - 1] = '7';
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	ERR_PRINT_OFF;
+	// Signature checks only warn.
+	Dictionary loaded = server->load_slot("slot");
+	CHECK(String(loaded["entry_3"]) == "Value of entry 7, long enough to matter.");
+
+	server->set("integrity_check_level", SaveServer::INTEGRITY_STRICT);
+	CHECK(server->load_slot("slot").is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneTree][SaveServer] Packed chunks are verified at the configured level") {
+	SaveServerScope scope("packed_integrity", SaveServer::FORMAT_PACKED);
+	SaveServer *server = SaveServer::get_singleton();
+	server->set("backup_enabled", false);
+	// Stored as is, so a value can be altered in place.
+	server->set("compression_enabled", false);
+
+	Dictionary data = create_slot_data(5);
+	server->save_slot("slot", data, false);
+	CHECK(server->load_slot("slot") == data);
+
+	const String path = scope.path.path_join("slot.snap");
+	Vector<uint8_t> contents = FileAccess::get_file_as_bytes(path);
+	const CharString value = String("entry 3").utf8();
+	int offset = -1;
+	for (int i = 0; i + value.length() <= contents.size() && offset < 0; i++) {
+		if (memcmp(contents.ptr() + i, value.get_data(), value.length()) == 0) {
+			offset = i;
+		}
+	}
+	REQUIRE(offset >= 0);
+	contents.write[offset + value.length() - 1] = '7';
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	ERR_PRINT_OFF;
+	// Signature checks only warn.
+	Dictionary loaded = server->load_slot("slot");
+	CHECK(String(loaded["entry_3"]) == "Value of entry 7, long enough to matter.");
+
+	server->set("integrity_check_level", SaveServer::INTEGRITY_STRICT);
+	CHECK(server->load_slot("slot").is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneTree][SaveServer] Packed slots round-trip") {
+	SaveServerScope scope("packed", SaveServer::FORMAT_PACKED, "0123456789abcdef0123456789abcdef");
+	SaveServer *server = SaveServer::get_singleton();
+
+	Dictionary player_general;
+	player_general["health"] = 75;
+	player_general["name"] = "Hero";
+	Dictionary player;
+	player[".id"] = StringName("player");
+	player["general"] = player_general;
+	Dictionary children;
+	children["Player"] = player;
+	Dictionary data = create_slot_data(50);
+	data[".children"] = children;
+
+	server->save_slot("slot", data, false);
+	CHECK(FileAccess::exists(scope.path.path_join("slot.snap")));
+	CHECK(server->load_slot("slot") == data);
+}
+
+TEST_CASE("[SceneTree][SaveServer] Packed subtrees load on their own") {
+	GDREGISTER_CLASS(PersistentValueNode);
+	SaveServerScope scope("subtrees", SaveServer::FORMAT_PACKED);
+	SaveServer *server = SaveServer::get_singleton();
+
+	PersistentValueNode *root = add_value_node(SceneTree::get_singleton()->get_root(), "SaveRoot", 1);
+	PersistentValueNode *first = add_value_node(root, "First", 10);
+	PersistentValueNode *nested = add_value_node(first, "Nested", 11);
+	PersistentValueNode *second = add_value_node(root, "Second", 20);
+	REQUIRE(server->save_snapshot(root, "slot", false));
+
+	root->set_value(0);
+	first->set_value(0);
+	nested->set_value(0);
+	second->set_value(0);
+
+	TypedArray<StringName> subtrees;
+	subtrees.push_back("First");
+	server->load_snapshot_subtrees(root, "slot", subtrees);
+	CHECK(wait_until([&]() { return first->get_value() == 10; }));
+	CHECK(nested->get_value() == 11);
+
+	// Neither the root nor the other subtrees are touched.
+	CHECK(root->get_value() == 0);
+	CHECK(second->get_value() == 0);
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][SaveServer] Superseded sliced captures complete") {
+	GDREGISTER_CLASS(SaveNotificationNode);
+	SaveServer *server = SaveServer::get_singleton();
+
+	SaveNotificationNode *root = memnew(SaveNotificationNode);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	for (int i = 0; i < 4; i++) {
+		root->add_child(memnew(Node));
+	}
+
+	REQUIRE(server->save_snapshot_sliced(root, "superseded"));
+	CHECK(root->prepared == 1);
+	CHECK(root->completed == 0);
+	CHECK(server->is_capturing("superseded"));
+
+	// Every SAVE_PREPARE gets its SAVE_COMPLETED, even when the capture is replaced.
+	REQUIRE(server->save_snapshot_sliced(root, "superseded"));
+	CHECK(root->prepared == 2);
+	CHECK(root->completed == 1);
+	CHECK(server->is_capturing("superseded"));
+
+	// Freeing the root discards the remaining capture without saving anything.
+	memdelete(root);
+	ERR_PRINT_OFF;
+	for (int i = 0; i < 10 && server->is_capturing("superseded"); i++) {
+		SceneTree::get_singleton()->process(0);
+	}
+	ERR_PRINT_ON;
+	CHECK_FALSE(server->is_capturing("superseded"));
+}
+
+TEST_CASE("[SceneTree][SaveServer] Sliced captures save each node as it was when visited") {
+	GDREGISTER_CLASS(PersistentValueNode);
+	SaveServerScope scope("sliced", SaveServer::FORMAT_BINARY);
+	SaveServer *server = SaveServer::get_singleton();
+	// The budget is checked every 16 nodes, so each frame captures 15 of them.
+	server->set("capture_budget_usec", 1);
+
+	PersistentValueNode *root = add_value_node(SceneTree::get_singleton()->get_root(), "SaveRoot", 1);
+	LocalVector<PersistentValueNode *> children;
+	for (int i = 0; i < 40; i++) {
+		children.push_back(add_value_node(root, vformat("Child%d", i), i));
+	}
+
+	REQUIRE(server->save_snapshot_sliced(root, "slot"));
+	SceneTree::get_singleton()->process(0);
+	REQUIRE(server->is_capturing("slot"));
+
+	// The first child was visited on the first frame, the last one wasn't yet.
+	children[0]->set_value(100);
+	children[39]->set_value(139);
+	CHECK(wait_until([&]() { return !server->is_capturing("slot"); }));
+
+	for (PersistentValueNode *child : children) {
+		child->set_value(-1);
+	}
+	server->load_snapshot(root, "slot");
+	CHECK(wait_until([&]() { return children[1]->get_value() != -1; }));
+
+	CHECK(children[0]->get_value() == 0);
+	CHECK(children[1]->get_value() == 1);
+	CHECK(children[39]->get_value() == 139);
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][SaveServer] Batched loads restore nodes across frames") {
+	GDREGISTER_CLASS(PersistentValueNode);
+	SaveServerScope scope("batched", SaveServer::FORMAT_BINARY);
+	SaveServer *server = SaveServer::get_singleton();
+	// The budget is checked every 4 nodes, so each frame restores 3 of them.
+	server->set("restore_budget_usec", 1);
+
+	PersistentValueNode *root = add_value_node(SceneTree::get_singleton()->get_root(), "SaveRoot", 1);
+	LocalVector<PersistentValueNode *> children;
+	for (int i = 0; i < 20; i++) {
+		PersistentValueNode *child = add_value_node(root, vformat("Child%d", i), i);
+		add_value_node(child, "Nested", i + 100);
+		children.push_back(child);
+	}
+	REQUIRE(server->save_snapshot(root, "slot", false));
+
+	root->set_value(0);
+	for (PersistentValueNode *child : children) {
+		child->set_value(-1);
+		Object::cast_to<PersistentValueNode>(child->get_child(0))->set_value(-1);
+	}
+
+	server->load_snapshot_batched(root, "slot");
+	bool partial = false;
+	CHECK(wait_until([&]() {
+		partial = partial || (root->get_value() == 1 && children[19]->get_value() == -1);
+		return Object::cast_to<PersistentValueNode>(children[19]->get_child(0))->get_value() != -1;
+	}));
+	CHECK_MESSAGE(partial, "The restore should have been spread across several frames.");
+
+	CHECK(root->get_value() == 1);
+	for (int i = 0; i < 20; i++) {
+		CHECK(children[i]->get_value() == i);
+		CHECK(Object::cast_to<PersistentValueNode>(children[i]->get_child(0))->get_value() == i + 100);
+	}
+
+	memdelete(root);
+}
+
+} // namespace TestSaveServer
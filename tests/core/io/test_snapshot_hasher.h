@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_snapshot_hasher.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/save/snapshot_hasher.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSnapshotHasher {
+
+static String hash_buffer(const uint8_t *p_data, size_t p_length, SnapshotHasher::Algorithm p_algorithm) {
+	SnapshotHasher hasher;
+	hasher.start(p_algorithm);
+	hasher.update(p_data, p_length);
+	return hasher.finish();
+}
+
+TEST_CASE("[SnapshotHasher] Known digests") {
+	const uint8_t abc[] = { 'a', 'b', 'c' };
+
+	CHECK(SnapshotHasher::xxh64(abc, 0) == 0xEF46DB3751D8E999ULL);
+	CHECK(SnapshotHasher::xxh64(abc, 3) == 0x44BC2CF5AD770999ULL);
+
+	// Digests are written in canonical (big endian) order.
+	CHECK(hash_buffer(abc, 3, SnapshotHasher::ALGORITHM_XXH64) == "xxh64:44bc2cf5ad770999");
+	CHECK(hash_buffer(abc, 3, SnapshotHasher::ALGORITHM_SHA256) == "sha256:ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST_CASE("[SnapshotHasher] Streaming matches hashing at once") {
+	Vector<uint8_t> data;
+	data.resize(1000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 31) & 0xFF;
+	}
+
+	for (SnapshotHasher::Algorithm algorithm : { SnapshotHasher::ALGORITHM_XXH64, SnapshotHasher::ALGORITHM_SHA256 }) {
+		const String expected = hash_buffer(data.ptr(), data.size(), algorithm);
+
+		// Uneven pieces, crossing the 32 byte XXH64 stripes.
+		SnapshotHasher hasher;
+		hasher.start(algorithm);
+		int offset = 0;
+		for (int piece = 1; offset < data.size(); piece = piece * 3 % 97 + 1) {
+			int size = MIN(piece, data.size() - offset);
+			hasher.update(data.ptr() + offset, size);
+			offset += size;
+		}
+		CHECK(hasher.finish() == expected);
+	}
+}
+
+TEST_CASE("[SnapshotHasher] Variants") {
+	Dictionary general;
+	general["health"] = 100;
+	general["name"] = "Hero";
+	Array items;
+	items.push_back("sword");
+	items.push_back(3.5);
+	Dictionary data;
+	data["general"] = general;
+	data["items"] = items;
+
+	const String hash = SnapshotHasher::hash_variant(data, SnapshotHasher::ALGORITHM_XXH64);
+	CHECK(hash.begins_with("xxh64:"));
+	CHECK(SnapshotHasher::hash_variant(data.duplicate(true), SnapshotHasher::ALGORITHM_XXH64) == hash);
+
+	general["health"] = 99;
+	CHECK(SnapshotHasher::hash_variant(data, SnapshotHasher::ALGORITHM_XXH64) != hash);
+	CHECK(SnapshotHasher::hash_variant(data, SnapshotHasher::ALGORITHM_SHA256).begins_with("sha256:"));
+}
+
+TEST_CASE("[SnapshotHasher] Parsing the algorithm of a checksum") {
+	SnapshotHasher::Algorithm algorithm = SnapshotHasher::ALGORITHM_XXH64;
+	CHECK(SnapshotHasher::parse_algorithm("sha256:ba7816bf", algorithm));
+	CHECK(algorithm == SnapshotHasher::ALGORITHM_SHA256);
+	CHECK(SnapshotHasher::parse_algorithm("xxh64:44bc2cf5ad770999", algorithm));
+	CHECK(algorithm == SnapshotHasher::ALGORITHM_XXH64);
+
+	// Legacy MD5 checksums have no prefix.
+	CHECK_FALSE(SnapshotHasher::parse_algorithm("900150983cd24fb0d6963f7d28e17f72", algorithm));
+}
+
+} // namespace TestSnapshotHasher
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_snapshot_index.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/resources/snapshot.h"
+#include "servers/save/packed_snapshot.h"
+#include "servers/save/snapshot_index.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSnapshotIndex {
+
+// Root (".id" = "root") with a "Player" child and a "Weapon" grandchild, plus an "Enemy" child.
+static Dictionary create_snapshot_data() {
+	Dictionary weapon_general;
+	weapon_general["damage"] = 5;
+	Dictionary weapon;
+	weapon[".id"] = "weapon";
+	weapon["general"] = weapon_general;
+
+	Dictionary player_children;
+	player_children["Weapon"] = weapon;
+	Dictionary player_general;
+	player_general["health"] = 100;
+	Dictionary player;
+	player[".id"] = "player";
+	player["general"] = player_general;
+	player[".children"] = player_children;
+
+	Dictionary enemy_general;
+	enemy_general["health"] = 50;
+	Dictionary enemy;
+	enemy[".id"] = "enemy";
+	enemy["general"] = enemy_general;
+
+	Dictionary root_children;
+	root_children["Player"] = player;
+	root_children["Enemy"] = enemy;
+	Dictionary root;
+	root[".id"] = "root";
+	root[".children"] = root_children;
+	return root;
+}
+
+TEST_CASE("[SnapshotIndex] Records are found by ID and patched in place") {
+	Dictionary data = create_snapshot_data();
+	SnapshotIndex index;
+	index.build(data);
+	CHECK(index.size() == 4);
+
+	const SnapshotIndex::Record *record = index.find("weapon");
+	REQUIRE(record != nullptr);
+	CHECK(record->name == StringName("Weapon"));
+	CHECK(record->path == NodePath("Player/Weapon"));
+	CHECK(index.find("missing") == nullptr);
+
+	Dictionary new_general;
+	new_general["damage"] = 8;
+	Dictionary new_data;
+	new_data["general"] = new_general;
+	CHECK(index.patch("player", new_data));
+
+	// The snapshot itself is patched, and the children of the record are kept.
+	Dictionary player = Dictionary(data[".children"])["Player"];
+	CHECK(Dictionary(player["general"])["damage"] == Variant(8));
+	CHECK(Dictionary(player[".children"]).has("Weapon"));
+	CHECK_FALSE(index.patch("missing", new_data));
+}
+
+TEST_CASE("[SnapshotIndex] Removing a record removes its descendants") {
+	Dictionary data = create_snapshot_data();
+	SnapshotIndex index;
+	index.build(data);
+
+	CHECK(index.remove("player"));
+	CHECK(index.find("player") == nullptr);
+	CHECK(index.find("weapon") == nullptr);
+	CHECK(index.find("enemy") != nullptr);
+	CHECK(index.size() == 2);
+
+	Dictionary root_children = data[".children"];
+	CHECK_FALSE(root_children.has("Player"));
+	CHECK(root_children.has("Enemy"));
+	CHECK_FALSE(index.remove("player"));
+}
+
+TEST_CASE("[SnapshotIndex] Removing a packed record") {
+	Ref<Snapshot> snapshot;
+	snapshot.instantiate();
+	snapshot->set_snapshot(create_snapshot_data());
+	Ref<PackedSnapshot> packed = PackedSnapshot::create_from_snapshot(snapshot);
+	REQUIRE(packed.is_valid());
+
+	SnapshotIndex index;
+	for (const PackedSnapshot::Chunk &chunk : packed->get_chunks()) {
+		index.add_packed_chunk(chunk);
+	}
+	CHECK(index.size() == 4);
+
+	const SnapshotIndex::Record *record = index.find("weapon");
+	REQUIRE(record != nullptr);
+	CHECK(record->path == NodePath("Player/Weapon"));
+
+	// Packed records have no data, the record and its descendants must still be removed.
+	CHECK(index.remove("player"));
+	CHECK(index.find("player") == nullptr);
+	CHECK(index.find("weapon") == nullptr);
+	CHECK(index.find("enemy") != nullptr);
+	CHECK(index.find("root") != nullptr);
+	CHECK_FALSE(index.remove("player"));
+}
+
+} // namespace TestSnapshotIndex
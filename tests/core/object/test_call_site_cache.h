@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  test_call_site_cache.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/call_site_cache.h"
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+
+#include "tests/test_macros.h"
+
+// Registered in the middle of a test, to bump the ClassDB methods version.
+class _TestCallSiteCacheLateClass : public Object {
+	GDCLASS(_TestCallSiteCacheLateClass, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("ping"), &_TestCallSiteCacheLateClass::ping);
+	}
+
+public:
+	int ping() const { return 1; }
+};
+
+namespace TestCallSiteCache {
+
+TEST_CASE("[CallSiteCache] Object methods") {
+	Object object;
+	Variant self = &object;
+	CallSiteCache cache;
+	Callable::CallError ce;
+	Variant ret;
+
+	// Exact argument types take the validated path.
+	Variant key = StringName("value");
+	Variant value = 42;
+	const Variant *args[2] = { &key, &value };
+	cache.call(self, "set_meta", args, 2, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(object.get_meta("value") == Variant(42));
+	CHECK(cache.get_resolve_count() == 1);
+
+	// A String where a StringName is expected goes through the regular, converting path.
+	Variant string_key = String("other");
+	const Variant *string_args[2] = { &string_key, &value };
+	cache.call(self, "set_meta", string_args, 2, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(object.get_meta("other") == Variant(42));
+	CHECK(cache.get_resolve_count() == 1);
+
+	CallSiteCache get_cache;
+	const Variant *get_args[1] = { &key };
+	get_cache.call(self, "get_meta", get_args, 1, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(ret == Variant(42));
+
+	CallSiteCache missing_cache;
+	missing_cache.call(self, "no_such_method", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD);
+}
+
+TEST_CASE("[CallSiteCache] Builtin methods") {
+	CallSiteCache cache;
+	Callable::CallError ce;
+	Variant ret;
+
+	Variant text = String("hello");
+	cache.call(text, "to_upper", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(ret == Variant("HELLO"));
+
+	Variant other_text = String("world");
+	cache.call(other_text, "to_upper", nullptr, 0, ret, ce);
+	CHECK(ret == Variant("WORLD"));
+	CHECK(cache.get_resolve_count() == 1);
+
+	// Another type at the same call site resolves again.
+	Variant name = StringName("name");
+	cache.call(name, "to_upper", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(ret == Variant("NAME"));
+	CHECK(cache.get_resolve_count() == 2);
+
+	// Mismatched arguments are still reported.
+	CallSiteCache begins_cache;
+	Variant number = 3;
+	const Variant *args[1] = { &number };
+	ERR_PRINT_OFF;
+	begins_cache.call(text, "begins_with", args, 1, ret, ce);
+	ERR_PRINT_ON;
+	CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_CASE("[CallSiteCache] Signal emission") {
+	Object emitter;
+	Object target;
+	emitter.add_user_signal(MethodInfo("changed", PropertyInfo(Variant::STRING_NAME, "key"), PropertyInfo(Variant::INT, "value")));
+	emitter.connect("changed", Callable(&target, "set_meta"));
+
+	emitter.emit_signal("changed", StringName("counter"), 1);
+	CHECK(target.get_meta("counter") == Variant(1));
+	emitter.emit_signal("changed", StringName("counter"), 2);
+	CHECK(target.get_meta("counter") == Variant(2));
+	// Arguments needing conversion still work with a resolved cache.
+	emitter.emit_signal("changed", String("counter"), 3);
+	CHECK(target.get_meta("counter") == Variant(3));
+}
+
+TEST_CASE("[CallSiteCache] Stays resolved after the methods version changes") {
+	Object object;
+	Variant self = &object;
+	Callable::CallError ce;
+	Variant ret;
+	Variant key = StringName("value");
+	Variant value = 1;
+	const Variant *args[2] = { &key, &value };
+
+	// Owners call through a copy and write it back when it resolved again, like signal emission does.
+	CallSiteCache stored;
+	CallSiteCache copy = stored;
+	copy.call(self, "set_meta", args, 2, ret, ce);
+	REQUIRE(copy.get_resolve_count() != stored.get_resolve_count());
+	stored = copy;
+
+	const uint32_t version = ClassDB::get_methods_version();
+	GDREGISTER_CLASS(_TestCallSiteCacheLateClass);
+	REQUIRE(ClassDB::get_methods_version() != version);
+
+	copy = stored;
+	copy.call(self, "set_meta", args, 2, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK_MESSAGE(copy.get_resolve_count() == 2, "Resolving again after a reset must still count, or owners never write the cache back.");
+	stored = copy;
+
+	// Written back, later calls don't resolve again.
+	for (int i = 0; i < 3; i++) {
+		copy = stored;
+		copy.call(self, "set_meta", args, 2, ret, ce);
+		CHECK(copy.get_resolve_count() == stored.get_resolve_count());
+	}
+}
+
+} // namespace TestCallSiteCache
@@ -66,6 +66,42 @@ public:
 	int get_property() const { return property_value; }
 };
 
+// Persists a property whose name depends on the instance.
+class _TestDynamicPersistenceObject : public Object {
+	GDCLASS(_TestDynamicPersistenceObject, Object);
+
+	Variant persisted_value;
+
+protected:
+	bool _set(const StringName &p_name, const Variant &p_value) {
+		if (p_name != persisted_name) {
+			return false;
+		}
+		persisted_value = p_value;
+		return true;
+	}
+
+	bool _get(const StringName &p_name, Variant &r_ret) const {
+		if (p_name != persisted_name) {
+			return false;
+		}
+		r_ret = persisted_value;
+		return true;
+	}
+
+	void _get_property_list(List<PropertyInfo> *p_list) const {
+		p_list->push_back(PropertyInfo(Variant::INT, persisted_name, PROPERTY_HINT_NONE, "", PROPERTY_USAGE_PERSISTENCE));
+	}
+
+	virtual void _load_persistence(const Dictionary &p_data) override {
+		loaded_data = p_data;
+	}
+
+public:
+	StringName persisted_name;
+	Dictionary loaded_data;
+};
+
 namespace TestObject {
 
 class _MockScriptInstance : public ScriptInstance {
@@ -664,6 +700,68 @@ TEST_CASE("[Object] Destruction at the end of the call chain is safe") {
 			"Object was tail-deleted without crashes.");
 }
 
+TEST_CASE("[Object] Persistent properties listed per instance") {
+	GDREGISTER_CLASS(_TestDynamicPersistenceObject);
+
+	_TestDynamicPersistenceObject *first = memnew(_TestDynamicPersistenceObject);
+	first->persisted_name = "health";
+	first->set("health", 10);
+	_TestDynamicPersistenceObject *second = memnew(_TestDynamicPersistenceObject);
+	second->persisted_name = "mana";
+	second->set("mana", 20);
+
+	// Both share a class, the schema compiled for the first must not be reused for the second.
+	Dictionary first_data = first->get_persistent_properties(TypedArray<StringName>());
+	Dictionary second_data = second->get_persistent_properties(TypedArray<StringName>());
+	CHECK(Dictionary(first_data["general"]).get("health", Variant()) == Variant(10));
+	CHECK(Dictionary(second_data["general"]).get("mana", Variant()) == Variant(20));
+	CHECK_FALSE(Dictionary(second_data["general"]).has("health"));
+
+	Dictionary restore;
+	Dictionary restore_tag;
+	restore_tag["mana"] = 30;
+	restore["general"] = restore_tag;
+	second->set_persistent_properties(restore);
+	CHECK(second->get("mana") == Variant(30));
+
+	memdelete(first);
+	memdelete(second);
+}
+
+TEST_CASE("[Object] Persistent values are all handed to _load_persistence") {
+	GDREGISTER_CLASS(_TestDynamicPersistenceObject);
+
+	_TestDynamicPersistenceObject *object = memnew(_TestDynamicPersistenceObject);
+	object->persisted_name = "mana";
+
+	// A schema property, a value unknown to the schema and a tag holding a plain value.
+	Dictionary general;
+	general["mana"] = 30;
+	general["bonus"] = 5;
+	Dictionary data;
+	data["general"] = general;
+	data["notes"] = "plain";
+
+	object->set_persistent_properties(data);
+	CHECK(object->get("mana") == Variant(30));
+	CHECK(object->loaded_data == data);
+
+	// The columnar variant used by packed snapshots must see the same data.
+	object->set("mana", 0);
+	object->loaded_data.clear();
+	const StringName tags[] = { "general", "general", "notes" };
+	const StringName properties[] = { "mana", "bonus", StringName() };
+	const Variant mana = 30;
+	const Variant bonus = 5;
+	const Variant notes = "plain";
+	const Variant *values[] = { &mana, &bonus, &notes };
+	object->set_persistent_values(tags, properties, values, 3);
+	CHECK(object->get("mana") == Variant(30));
+	CHECK(object->loaded_data == data);
+
+	memdelete(object);
+}
+
 int required_param_compare(const Ref<RefCounted> &p_ref, const RequiredParam<RefCounted> &rp_required) {
 	EXTRACT_PARAM_OR_FAIL_V(p_required, rp_required, false);
 	ERR_FAIL_COND_V(p_ref->get_reference_count() != p_required->get_reference_count(), -1);
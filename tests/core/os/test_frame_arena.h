@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Falls back to the heap on threads without frames") {
+	FrameArena::disable();
+	CHECK_FALSE(FrameArena::is_active());
+
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector[999] == 999);
+	CHECK(FrameArena::get_used_bytes() == 0);
+}
+
+TEST_CASE("[FrameArena] Allocations are reclaimed at frame boundaries") {
+	FrameArena::begin_frame();
+	REQUIRE(FrameArena::is_active());
+	uint32_t frame = FrameArena::get_frame();
+
+	void *a = FrameArena::alloc(100);
+	void *b = FrameArena::alloc(3);
+	CHECK(((uintptr_t)a % 16) == 0);
+	CHECK(((uintptr_t)b % 16) == 0);
+	CHECK(FrameArena::get_live_allocations() == 2);
+	CHECK(FrameArena::get_used_bytes() > 0);
+
+	// Freeing the last allocation gives its space back.
+	uint64_t used = FrameArena::get_used_bytes();
+	FrameArena::free(b);
+	CHECK(FrameArena::get_used_bytes() < used);
+	FrameArena::free(a);
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	FrameArena::begin_frame();
+	CHECK(FrameArena::get_frame() == frame + 1);
+	CHECK(FrameArena::get_used_bytes() == 0);
+	CHECK(FrameArena::get_escaped_allocations() == 0);
+
+	FrameArena::disable();
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameArena::begin_frame();
+
+	{
+		FrameLocalVector<uint32_t> vector;
+		for (uint32_t i = 0; i < 10000; i++) {
+			vector.push_back(i * 3);
+		}
+		bool all_match = true;
+		for (uint32_t i = 0; i < vector.size(); i++) {
+			all_match = all_match && vector[i] == i * 3;
+		}
+		CHECK(all_match);
+
+		FrameHashMap<int, String> map;
+		for (int i = 0; i < 500; i++) {
+			map.insert(i, itos(i));
+		}
+		CHECK(map.size() == 500);
+		CHECK(map[250] == "250");
+		map.erase(250);
+		CHECK_FALSE(map.has(250));
+	}
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	// Outgrowing the first chunk adds another one, which is merged into a single chunk on the next frame.
+	void *big = FrameArena::alloc(FrameArena::DEFAULT_CHUNK_SIZE * 2);
+	CHECK(FrameArena::get_capacity() > FrameArena::DEFAULT_CHUNK_SIZE * 2);
+	FrameArena::free(big);
+	uint64_t capacity = FrameArena::get_capacity();
+	FrameArena::begin_frame();
+	CHECK(FrameArena::get_capacity() == capacity);
+
+	FrameArena::disable();
+}
+
+TEST_CASE("[FrameArena] Heap allocations stay on the heap once a frame begins") {
+	FrameArena::disable();
+	void *heap = FrameArena::alloc(64);
+	void *grown = FrameArena::alloc(16);
+
+	FrameArena::begin_frame();
+	void *arena = FrameArena::alloc(64);
+	CHECK(FrameArena::get_live_allocations() == 1);
+
+	// Neither is inside the arena's chunks, so both go back to the heap without touching the arena.
+	grown = FrameArena::realloc(grown, 4096);
+	FrameArena::free(grown);
+	FrameArena::free(heap);
+	CHECK(FrameArena::get_live_allocations() == 1);
+
+	FrameArena::free(arena);
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	FrameArena::disable();
+}
+
+TEST_CASE("[FrameArena] Scopes") {
+	FrameArena::disable();
+
+	{
+		FrameArena::Scope scope;
+		CHECK(FrameArena::is_active());
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(FrameArena::get_used_bytes() > 0);
+	}
+	CHECK_FALSE(FrameArena::is_active());
+	CHECK(FrameArena::get_used_bytes() == 0);
+	// The chunk is kept for the next scope.
+	CHECK(FrameArena::get_capacity() > 0);
+
+	// Nested in an active frame, the scope leaves the frame alone.
+	FrameArena::begin_frame();
+	uint32_t frame = FrameArena::get_frame();
+	void *outer = FrameArena::alloc(32);
+	{
+		FrameArena::Scope scope;
+		FrameArena::free(FrameArena::alloc(32));
+	}
+	CHECK(FrameArena::is_active());
+	CHECK(FrameArena::get_frame() == frame);
+	FrameArena::free(outer);
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	FrameArena::disable();
+}
+
+TEST_CASE("[FrameArena] Escaping pointers are detected") {
+	FrameArena::begin_frame();
+
+	void *escaping = FrameArena::alloc(64);
+	ERR_PRINT_OFF;
+	FrameArena::begin_frame();
+#ifdef DEBUG_ENABLED
+	CHECK(FrameArena::get_escaped_allocations() == 1);
+#endif
+
+	FrameArena::free(escaping);
+	ERR_PRINT_ON;
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	FrameArena::disable();
+
+	// Pointers escaping a scope are still recognized as arena pointers once it ended.
+	{
+		FrameArena::Scope scope;
+		escaping = FrameArena::alloc(64);
+		ERR_PRINT_OFF;
+	}
+	FrameArena::free(escaping);
+	ERR_PRINT_ON;
+	CHECK(FrameArena::get_live_allocations() == 0);
+
+	FrameArena::disable();
+}
+
+} // namespace TestFrameArena
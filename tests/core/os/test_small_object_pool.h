@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  test_small_object_pool.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/small_object_pool.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallObjectPool {
+
+TEST_CASE("[SmallObjectPool] Blocks are reused within a size class") {
+	void *a = SmallObjectPool::alloc(40);
+	CHECK(((uintptr_t)a % 16) == 0);
+	SmallObjectPool::free(a, 40);
+	// Same class (33-48 bytes), so the block just freed comes back.
+	void *b = SmallObjectPool::alloc(48);
+	CHECK(a == b);
+	SmallObjectPool::free(b, 48);
+
+	// Oversized requests go to the heap.
+	void *big = SmallObjectPool::alloc(SmallObjectPool::MAX_SIZE + 1);
+	CHECK(big != nullptr);
+	SmallObjectPool::free(big, SmallObjectPool::MAX_SIZE + 1);
+}
+
+TEST_CASE("[SmallObjectPool] Blocks survive overflowing the thread cache") {
+	LocalVector<uint64_t *> blocks;
+	for (uint32_t i = 0; i < SmallObjectPool::THREAD_CACHE_LIMIT * 3; i++) {
+		uint64_t *block = static_cast<uint64_t *>(SmallObjectPool::alloc(sizeof(uint64_t) * 4));
+		block[0] = i;
+		block[3] = i;
+		blocks.push_back(block);
+	}
+	bool intact = true;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		intact = intact && blocks[i][0] == i && blocks[i][3] == i;
+	}
+	CHECK(intact);
+
+	SmallObjectPool::Stats before = SmallObjectPool::get_stats();
+	for (uint64_t *block : blocks) {
+		SmallObjectPool::free(block, sizeof(uint64_t) * 4);
+	}
+	SmallObjectPool::Stats after = SmallObjectPool::get_stats();
+	CHECK(after.batches_returned > before.batches_returned);
+	// Freed blocks stay in the pool for reuse, the slabs holding them are not released.
+	CHECK(after.bytes_reserved == before.bytes_reserved);
+	CHECK(after.bytes_reserved >= (uint64_t)blocks.size() * sizeof(uint64_t) * 4);
+}
+
+struct LateFree {
+	void *block = nullptr;
+
+	~LateFree() {
+		// Runs after the thread cache was flushed, because it was created before the cache was first used.
+		SmallObjectPool::free(block, LATE_FREE_SIZE);
+	}
+
+	static constexpr size_t LATE_FREE_SIZE = 240;
+};
+
+static void *late_freed_block = nullptr;
+
+static void late_free_thread_func(void *p_userdata) {
+	static thread_local LateFree late_free;
+	late_free.block = SmallObjectPool::alloc(LateFree::LATE_FREE_SIZE);
+	late_freed_block = late_free.block;
+}
+
+TEST_CASE("[SmallObjectPool] Blocks freed after the thread cache is flushed") {
+	Thread thread;
+	thread.start(late_free_thread_func, nullptr);
+	thread.wait_to_finish();
+	REQUIRE(late_freed_block != nullptr);
+
+	// The block went to the global pool, so it's handed out again once this thread's cache runs dry.
+	LocalVector<void *> blocks;
+	bool reused = false;
+	for (uint32_t i = 0; i <= SmallObjectPool::THREAD_CACHE_LIMIT && !reused; i++) {
+		blocks.push_back(SmallObjectPool::alloc(LateFree::LATE_FREE_SIZE));
+		reused = blocks[i] == late_freed_block;
+	}
+	CHECK(reused);
+	for (void *block : blocks) {
+		SmallObjectPool::free(block, LateFree::LATE_FREE_SIZE);
+	}
+}
+
+struct PoolBenchmark {
+	uint32_t iterations = 0;
+	bool use_pool = false;
+
+	static void thread_func(void *p_userdata) {
+		PoolBenchmark *bench = static_cast<PoolBenchmark *>(p_userdata);
+		void *live[64];
+		for (uint32_t i = 0; i < bench->iterations; i++) {
+			for (uint32_t j = 0; j < 64; j++) {
+				live[j] = bench->use_pool ? SmallObjectPool::alloc(128) : Memory::alloc_static(128);
+			}
+			for (uint32_t j = 0; j < 64; j++) {
+				if (bench->use_pool) {
+					SmallObjectPool::free(live[j], 128);
+				} else {
+					Memory::free_static(live[j]);
+				}
+			}
+		}
+	}
+
+	uint64_t run(uint32_t p_threads) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		LocalVector<Thread> threads;
+		threads.resize(p_threads);
+		for (Thread &thread : threads) {
+			thread.start(&PoolBenchmark::thread_func, this);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		return MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+	}
+};
+
+TEST_CASE("[SmallObjectPool] Stress benchmark against the heap") {
+	const uint32_t threads = CLAMP(OS::get_singleton()->get_processor_count(), 2, 8);
+	PoolBenchmark bench;
+	bench.iterations = 2000;
+
+	bench.use_pool = false;
+	uint64_t heap_usec = bench.run(threads);
+	bench.use_pool = true;
+	SmallObjectPool::Stats before = SmallObjectPool::get_stats();
+	uint64_t pool_usec = bench.run(threads);
+	SmallObjectPool::Stats after = SmallObjectPool::get_stats();
+
+	int64_t allocations = (int64_t)threads * bench.iterations * 64;
+	MESSAGE(vformat("%d threads, %d allocations of 128 bytes: heap %d usec (%d heap allocations), pool %d usec (%d heap allocations).",
+			threads, allocations, (int64_t)heap_usec, allocations, (int64_t)pool_usec, (int64_t)(after.slabs_allocated - before.slabs_allocated)));
+	// 64 live blocks are two batches per thread. Those stay in each thread's cache, so no slab is needed past the first iteration.
+	CHECK(after.slabs_allocated - before.slabs_allocated <= (uint64_t)threads * 64 / SmallObjectPool::BATCH_SIZE);
+	// Every thread hands its blocks back when it exits.
+	CHECK(after.batches_returned - before.batches_returned >= (uint64_t)threads * 64 / SmallObjectPool::BATCH_SIZE);
+
+	// Containers the way JSON parsing or snapshots build them: many tiny dictionaries nested in arrays.
+	before = SmallObjectPool::get_stats();
+	SmallObjectPool::Stats after_first_round;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int64_t containers = 0;
+	for (int round = 0; round < 200; round++) {
+		Array records;
+		for (int i = 0; i < 100; i++) {
+			Dictionary record;
+			record["id"] = i;
+			record["name"] = "record";
+			Array tags;
+			tags.push_back(round);
+			record["tags"] = tags;
+			records.push_back(record);
+		}
+		containers += 201;
+		CHECK_EQ(records.size(), 100);
+		if (round == 0) {
+			after_first_round = SmallObjectPool::get_stats();
+		}
+	}
+	uint64_t containers_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	after = SmallObjectPool::get_stats();
+	MESSAGE(vformat("%d containers created in %d usec, %d heap slabs allocated by the pool.",
+			containers, (int64_t)containers_usec, (int64_t)(after.slabs_allocated - before.slabs_allocated)));
+	// Every round frees what the previous one allocated, so only the first needs new slabs.
+	CHECK(after.slabs_allocated == after_first_round.slabs_allocated);
+}
+
+} // namespace TestSmallObjectPool
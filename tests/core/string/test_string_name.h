@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "string_name_interning_test";
+	StringName b = String("string_name_interning_test");
+	StringName c = StringName("string_name_interning_other");
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a.hash() == String("string_name_interning_test").hash());
+	CHECK(String(a) == "string_name_interning_test");
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+}
+
+TEST_CASE("[StringName] Released names can be interned again") {
+	String name = "string_name_released_test";
+	uint32_t hash = 0;
+	{
+		StringName first = name;
+		hash = first.hash();
+	}
+	StringName second = name;
+	CHECK(second == name);
+	CHECK(second.hash() == hash);
+}
+
+struct InternBenchmark {
+	LocalVector<String> names;
+	LocalVector<StringName> expected;
+	uint32_t rounds = 0;
+	SafeNumeric<uint32_t> mismatches;
+
+	static void thread_func(void *p_userdata) {
+		InternBenchmark *bench = static_cast<InternBenchmark *>(p_userdata);
+		for (uint32_t round = 0; round < bench->rounds; round++) {
+			for (uint32_t i = 0; i < bench->names.size(); i++) {
+				// Every other round also creates names nobody else holds, to exercise insertion and release.
+				StringName sn = (round & 1) ? StringName(bench->names[i] + "_transient") : StringName(bench->names[i]);
+				if (!(round & 1) && sn != bench->expected[i]) {
+					bench->mismatches.increment();
+				}
+			}
+		}
+	}
+};
+
+static uint64_t bench_string_name_creation(InternBenchmark &p_bench, uint32_t p_threads) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<Thread> threads;
+	threads.resize(p_threads);
+	for (Thread &thread : threads) {
+		thread.start(&InternBenchmark::thread_func, &p_bench);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	return MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+}
+
+TEST_CASE("[StringName] Multithreaded creation throughput") {
+	InternBenchmark bench;
+	bench.rounds = 20;
+	for (int i = 0; i < 2000; i++) {
+		bench.names.push_back(vformat("bench_string_name_%d", i));
+		bench.expected.push_back(bench.names[i]);
+	}
+
+	const uint32_t max_threads = CLAMP(OS::get_singleton()->get_processor_count(), 2, 16);
+	for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+		uint64_t usec = bench_string_name_creation(bench, threads);
+		int64_t created = (int64_t)threads * bench.rounds * bench.names.size();
+		MESSAGE(vformat("%d thread(s): %d StringNames created per second.", threads, created * 1000000 / (int64_t)usec));
+	}
+	CHECK(bench.mismatches.get() == 0);
+}
+
+} // namespace TestStringName
@@ -283,10 +283,11 @@ public:
 	}
 };
 
-static void test_command_queue_basic(bool p_use_thread_pool_sync) {
+static void test_command_queue_basic(bool p_use_thread_pool_sync, uint32_t p_ring_size_kb = 0) {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
 	SharedThreadState sts;
+	sts.command_queue.set_ring_size(p_ring_size_kb);
 	sts.init_threads(p_use_thread_pool_sync);
 
 	sts.add_msg_to_write(SharedThreadState::TEST_MSG_FUNC1_TRANSFORM);
@@ -333,6 +334,14 @@ TEST_CASE("[CommandQueue] Test Queue Basics with WorkerThreadPool sync.") {
 	test_command_queue_basic(true);
 }
 
+TEST_CASE("[CommandQueue] Test Queue Basics in lock-free ring mode") {
+	test_command_queue_basic(false, 4);
+}
+
+TEST_CASE("[CommandQueue] Test Queue Basics in lock-free ring mode with WorkerThreadPool sync.") {
+	test_command_queue_basic(true, 4);
+}
+
 TEST_CASE("[CommandQueue] Test Queue Wrapping to same spot.") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
@@ -518,4 +527,71 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+class BenchQueueState {
+public:
+	CommandQueueMT command_queue;
+	SafeNumeric<uint32_t> producers_left;
+	uint32_t commands_per_producer = 0;
+	uint32_t executed = 0; // Only touched by the consumer.
+	Transform3D transform;
+
+	void command(Transform3D p_transform, uint32_t p_index) {
+		executed++;
+	}
+
+	static void static_producer(void *p_state) {
+		BenchQueueState *state = static_cast<BenchQueueState *>(p_state);
+		for (uint32_t i = 0; i < state->commands_per_producer; i++) {
+			state->command_queue.push(state, &BenchQueueState::command, state->transform, i);
+		}
+		state->producers_left.decrement();
+	}
+
+	static void static_consumer(void *p_state) {
+		BenchQueueState *state = static_cast<BenchQueueState *>(p_state);
+		while (state->producers_left.get()) {
+			state->command_queue.flush_if_pending();
+		}
+		state->command_queue.flush_all();
+	}
+};
+
+static uint64_t bench_command_queue(uint32_t p_ring_size_kb, uint32_t p_producers, uint32_t p_commands_per_producer) {
+	BenchQueueState state;
+	state.command_queue.set_ring_size(p_ring_size_kb);
+	state.commands_per_producer = p_commands_per_producer;
+	state.producers_left.set(p_producers);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	Thread consumer;
+	consumer.start(&BenchQueueState::static_consumer, &state);
+	LocalVector<Thread> producers;
+	producers.resize(p_producers);
+	for (Thread &producer : producers) {
+		producer.start(&BenchQueueState::static_producer, &state);
+	}
+	for (Thread &producer : producers) {
+		producer.wait_to_finish();
+	}
+	consumer.wait_to_finish();
+
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(state.executed == p_producers * p_commands_per_producer);
+	return MAX(elapsed, (uint64_t)1);
+}
+
+TEST_CASE("[CommandQueue] Benchmark mutex mode against lock-free ring mode") {
+	const uint32_t commands_per_producer = 50000;
+	const uint32_t producer_counts[2] = { 1, 4 };
+	for (uint32_t producers : producer_counts) {
+		uint64_t mutex_usec = bench_command_queue(0, producers, commands_per_producer);
+		uint64_t ring_usec = bench_command_queue(256, producers, commands_per_producer);
+		int64_t total = producers * commands_per_producer;
+		MESSAGE(vformat("%d producer(s): %d commands/s with the mutex, %d commands/s with the lock-free ring.",
+				producers, total * 1000000 / (int64_t)mutex_usec, total * 1000000 / (int64_t)ring_usec));
+	}
+}
+
 } // namespace TestCommandQueue
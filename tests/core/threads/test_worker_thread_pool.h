@@ -172,4 +172,167 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<uint32_t> graph_step;
+static uint32_t graph_seen[4];
+
+static void static_graph_node(void *p_arg) {
+	graph_seen[(uintptr_t)p_arg] = graph_step.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run a task graph respecting its dependencies") {
+	// Diamond: 0 -> (1, 2) -> 3.
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID nodes[4];
+	for (int i = 0; i < 4; i++) {
+		nodes[i] = graph.add_native_node(static_graph_node, (void *)(uintptr_t)i);
+	}
+	graph.add_continuation(nodes[0], nodes[1]);
+	graph.add_continuation(nodes[0], nodes[2]);
+	graph.add_dependency(nodes[3], nodes[1]);
+	graph.add_dependency(nodes[3], nodes[2]);
+
+	for (int run = 0; run < 100; run++) {
+		graph_step.set(0);
+		REQUIRE(graph.run() == OK);
+		graph.wait();
+
+		CHECK(graph_seen[0] == 1);
+		CHECK(graph_seen[1] > graph_seen[0]);
+		CHECK(graph_seen[2] > graph_seen[0]);
+		CHECK(graph_seen[3] == 4);
+
+		WorkerThreadPool::TaskGraph::NodeTiming first = graph.get_node_timing(nodes[0]);
+		WorkerThreadPool::TaskGraph::NodeTiming last = graph.get_node_timing(nodes[3]);
+		CHECK(first.end_usec <= last.start_usec);
+	}
+
+	// Cycles are rejected before anything runs.
+	graph.add_dependency(nodes[0], nodes[3]);
+	ERR_PRINT_OFF;
+	CHECK(graph.run() == ERR_CYCLIC_LINK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(graph.is_running());
+}
+
+static LocalVector<SafeNumeric<uint32_t>> fan_out_runs;
+
+static void static_fan_out_task(void *p_arg) {
+	fan_out_runs[(uintptr_t)p_arg].increment();
+}
+
+struct FanOut {
+	uint32_t count = 0;
+	bool high_priority = true;
+};
+
+static void static_fan_out_post_and_wait(void *p_arg) {
+	const FanOut *fan_out = (const FanOut *)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	ids.resize(fan_out->count);
+	for (uint32_t i = 0; i < fan_out->count; i++) {
+		ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_task, (void *)(uintptr_t)i, fan_out->high_priority);
+	}
+	for (uint32_t i = 0; i < fan_out->count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Fan out more tasks than the deques can hold") {
+	// Overflowing the deques spills tasks to the shared queues, which must still run each exactly once.
+	FanOut fan_out;
+	fan_out.count = 3000;
+
+	for (int i = 0; i < 4; i++) {
+		fan_out.high_priority = i % 2 == 0;
+		const bool from_pool_thread = i >= 2;
+
+		fan_out_runs.clear();
+		fan_out_runs.resize(fan_out.count);
+
+		if (from_pool_thread) {
+			WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_post_and_wait, &fan_out, true);
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(id);
+		} else {
+			static_fan_out_post_and_wait(&fan_out);
+		}
+
+		uint32_t runs_ok = 0;
+		for (uint32_t j = 0; j < fan_out.count; j++) {
+			if (fan_out_runs[j].get() == 1) {
+				runs_ok++;
+			}
+		}
+		CHECK_MESSAGE(runs_ok == fan_out.count, vformat("Every task should have run once (%s priority, posted from %s).", fan_out.high_priority ? "high" : "low", from_pool_thread ? "a pool thread" : "outside the pool"));
+	}
+}
+
+static SafeNumeric<uint32_t> bench_done;
+
+static void static_bench_tiny_task(void *p_arg) {
+	bench_done.increment();
+}
+
+static void static_bench_large_task(void *p_arg) {
+	uint64_t acc = (uintptr_t)p_arg;
+	for (uint32_t i = 0; i < 50000; i++) {
+		acc = acc * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	// Never true, only keeps the loop from being optimized out.
+	bench_done.add(acc == 0 ? 2 : 1);
+}
+
+struct BenchWorkload {
+	void (*func)(void *) = nullptr;
+	uint32_t count = 0;
+};
+
+static void static_bench_post_and_wait(void *p_arg) {
+	const BenchWorkload *workload = (const BenchWorkload *)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	ids.resize(workload->count);
+	for (uint32_t i = 0; i < workload->count; i++) {
+		ids[i] = WorkerThreadPool::get_singleton()->add_native_task(workload->func, (void *)(uintptr_t)(i + 1), true);
+	}
+	for (uint32_t i = 0; i < workload->count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(ids[i]);
+	}
+}
+
+static uint64_t bench_workload(const BenchWorkload &p_workload, bool p_from_pool_thread) {
+	bench_done.set(0);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	if (p_from_pool_thread) {
+		// Fan-out from within a task, served from the local deque of the posting thread.
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->add_native_task(static_bench_post_and_wait, (void *)&p_workload, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(id);
+	} else {
+		// Posted from outside the pool, served from the shared queue.
+		static_bench_post_and_wait((void *)&p_workload);
+	}
+
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(bench_done.get() == p_workload.count);
+	return MAX(elapsed, (uint64_t)1);
+}
+
+TEST_CASE("[WorkerThreadPool] Throughput of tiny and large tasks") {
+	BenchWorkload tiny;
+	tiny.func = static_bench_tiny_task;
+	tiny.count = 20000;
+
+	BenchWorkload large;
+	large.func = static_bench_large_task;
+	large.count = 512;
+
+	const BenchWorkload *workloads[2] = { &tiny, &large };
+	const char *names[2] = { "Tiny", "Large" };
+	for (int i = 0; i < 2; i++) {
+		uint64_t shared_usec = bench_workload(*workloads[i], false);
+		uint64_t local_usec = bench_workload(*workloads[i], true);
+		MESSAGE(vformat("%s tasks (%d): %d tasks/s posted from outside the pool, %d tasks/s posted from a pool thread.",
+				names[i], workloads[i]->count, (int64_t)(workloads[i]->count * 1000000ULL / shared_usec), (int64_t)(workloads[i]->count * 1000000ULL / local_usec)));
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
@@ -308,4 +309,172 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+static Ref<Animation> create_compressed_animation(int p_tracks_per_type) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(2.0);
+	for (int i = 0; i < p_tracks_per_type; i++) {
+		NodePath path = vformat("Skeleton:bone%d", i);
+		int track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(track, path);
+		track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(track, path);
+		track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+		animation->track_set_path(track, NodePath(vformat("Mesh:shape%d", i)));
+		for (int k = 0; k <= 20; k++) {
+			double time = k * 0.1;
+			real_t phase = time * 3.0 + i * 0.37;
+			animation->position_track_insert_key(track - 3, time, Vector3(Math::sin(phase), Math::cos(phase * 0.5), i * 0.1));
+			animation->rotation_track_insert_key(track - 2, time, Quaternion(Vector3(0, 1, 0), phase));
+			animation->scale_track_insert_key(track - 1, time, Vector3(1, 1, 1) * (1.5 + Math::sin(phase) * 0.5));
+			animation->blend_shape_track_insert_key(track, time, Math::sin(phase));
+		}
+	}
+	animation->compress();
+	return animation;
+}
+
+static bool check_sampled_tracks(const Ref<Animation> &p_animation, double p_time, const Animation::TrackSamples &p_samples) {
+	for (int i = 0; i < p_animation->get_track_count(); i++) {
+		const Quaternion &value = p_samples.values[i];
+		switch (p_animation->track_get_type(i)) {
+			case Animation::TYPE_POSITION_3D: {
+				if (!p_samples.valid[i] || !p_animation->position_track_interpolate(i, p_time).is_equal_approx(Vector3(value.x, value.y, value.z))) {
+					return false;
+				}
+			} break;
+			case Animation::TYPE_ROTATION_3D: {
+				if (!p_samples.valid[i] || !p_animation->rotation_track_interpolate(i, p_time).is_equal_approx(value)) {
+					return false;
+				}
+			} break;
+			case Animation::TYPE_SCALE_3D: {
+				if (!p_samples.valid[i] || !p_animation->scale_track_interpolate(i, p_time).is_equal_approx(Vector3(value.x, value.y, value.z))) {
+					return false;
+				}
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+				if (!p_samples.valid[i] || !Math::is_equal_approx(p_animation->blend_shape_track_interpolate(i, p_time), value.x)) {
+					return false;
+				}
+			} break;
+			default: {
+				if (p_samples.valid[i]) {
+					return false;
+				}
+			} break;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Animation] Sample all tracks at once") {
+	Ref<Animation> animation = create_compressed_animation(4);
+	REQUIRE(animation->track_is_compressed(0));
+	const int value_track = animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(value_track, NodePath("Node:visible"));
+	const int uncompressed_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(uncompressed_track, NodePath("Node:position"));
+	animation->position_track_insert_key(uncompressed_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(uncompressed_track, 2.0, Vector3(2, 0, 0));
+	CHECK(!animation->track_is_compressed(uncompressed_track));
+
+	Animation::TrackSamples samples;
+	for (double time : { -0.5, 0.0, 0.05, 0.1, 0.73, 1.0, 1.99, 2.0, 3.0 }) {
+		animation->sample_tracks(time, samples);
+		REQUIRE(samples.values.size() == (uint32_t)animation->get_track_count());
+		CHECK_MESSAGE(check_sampled_tracks(animation, time, samples), vformat("Samples at %f should match the interpolation of each track.", time));
+	}
+	CHECK(!samples.valid[value_track]);
+}
+
+TEST_CASE("[Animation] Batched sampling stays within tolerance on large ranges") {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(2.0);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Skeleton:root"));
+	const int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Mesh:shape"));
+	for (int k = 0; k <= 40; k++) {
+		double time = k * 0.05;
+		animation->position_track_insert_key(position_track, time, Vector3(Math::sin(time * 3.0) * 1000.0, Math::cos(time * 2.0) * 1000.0, time * 500.0));
+		animation->blend_shape_track_insert_key(blend_shape_track, time, Math::sin(time * 5.0) * 7.5);
+	}
+	animation->compress();
+	REQUIRE(animation->track_is_compressed(position_track));
+
+	// Batched decoding works in single precision, so it may differ from the per-track path by float rounding.
+	// Allow a tenth of the quantization step (1/65535 of the widest range, and of the -8 to 8 blend shape range).
+	const real_t position_tolerance = 2000.0 / 65535.0 * 0.1;
+	const real_t blend_shape_tolerance = 16.0 / 65535.0 * 0.1;
+
+	Animation::TrackSamples samples;
+	for (int k = 0; k <= 200; k++) {
+		double time = k * 0.01 + 0.003;
+		animation->sample_tracks(time, samples);
+		REQUIRE(samples.valid[position_track]);
+		REQUIRE(samples.valid[blend_shape_track]);
+
+		const Vector3 expected = animation->position_track_interpolate(position_track, time);
+		const Quaternion &value = samples.values[position_track];
+		CHECK_MESSAGE(Math::abs(value.x - expected.x) <= position_tolerance, vformat("Position x at %f is off by %f.", time, value.x - expected.x));
+		CHECK_MESSAGE(Math::abs(value.y - expected.y) <= position_tolerance, vformat("Position y at %f is off by %f.", time, value.y - expected.y));
+		CHECK_MESSAGE(Math::abs(value.z - expected.z) <= position_tolerance, vformat("Position z at %f is off by %f.", time, value.z - expected.z));
+
+		const float expected_blend = animation->blend_shape_track_interpolate(blend_shape_track, time);
+		CHECK_MESSAGE(Math::abs(samples.values[blend_shape_track].x - expected_blend) <= blend_shape_tolerance, vformat("Blend shape at %f is off by %f.", time, samples.values[blend_shape_track].x - expected_blend));
+	}
+}
+
+TEST_CASE("[Animation] Compressed track sampling throughput") {
+	const int tracks_per_type = 250; // 1000 tracks.
+	Ref<Animation> animation = create_compressed_animation(tracks_per_type);
+	const int track_count = animation->get_track_count();
+	const int rounds = 50;
+
+	Vector3 vector;
+	Quaternion rotation;
+	float blend = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		double time = r * 2.0 / rounds;
+		for (int i = 0; i < track_count; i++) {
+			switch (animation->track_get_type(i)) {
+				case Animation::TYPE_POSITION_3D: {
+					animation->try_position_track_interpolate(i, time, &vector);
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					animation->try_rotation_track_interpolate(i, time, &rotation);
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					animation->try_scale_track_interpolate(i, time, &vector);
+				} break;
+				default: {
+					animation->try_blend_shape_track_interpolate(i, time, &blend);
+				} break;
+			}
+		}
+	}
+	uint64_t per_track_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+	Animation::TrackSamples samples;
+	bool matches = true;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		animation->sample_tracks(r * 2.0 / rounds, samples);
+	}
+	uint64_t batch_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+	for (int r = 0; r < rounds; r += 7) {
+		double time = r * 2.0 / rounds;
+		animation->sample_tracks(time, samples);
+		matches = matches && check_sampled_tracks(animation, time, samples);
+	}
+
+	MESSAGE(vformat("%d compressed tracks sampled %d times: %d usec track by track, %d usec in batches.", track_count, rounds, per_track_usec, batch_usec));
+	CHECK(matches);
+}
+
 } // namespace TestAnimation
@@ -30,7 +30,12 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/skeleton_3d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_sample_cache.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 #include "tests/test_macros.h"
 
@@ -61,4 +66,208 @@ TEST_CASE("[AnimationPlayer] get & set blend_time") {
 	memdelete(animation_player);
 }
 
+#ifndef _3D_DISABLED
+static LocalVector<Transform3D> _play_bone_animations(bool p_parallel, bool p_shared_sampling, int p_characters) {
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_processing", p_parallel);
+
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < 2; i++) {
+		NodePath path = vformat("Skeleton:bone%d", i);
+		int track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(track, path);
+		animation->position_track_insert_key(track, 0.0, Vector3(0, 1, 0));
+		animation->position_track_insert_key(track, 1.0, Vector3(2, 1 + i, 0));
+		track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		animation->rotation_track_insert_key(track, 0.0, Quaternion());
+		animation->rotation_track_insert_key(track, 1.0, Quaternion(Vector3(0, 0, 1), Math::PI * 0.5));
+		track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(track, path);
+		animation->scale_track_insert_key(track, 0.0, Vector3(1, 1, 1));
+		animation->scale_track_insert_key(track, 1.0, Vector3(3, 1, 1));
+	}
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", animation);
+
+	LocalVector<Node *> characters;
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < p_characters; i++) {
+		Node *character = memnew(Node);
+		Skeleton3D *skeleton = memnew(Skeleton3D);
+		skeleton->set_name("Skeleton");
+		skeleton->add_bone("bone0");
+		skeleton->add_bone("bone1");
+		skeleton->set_bone_parent(1, 0);
+		character->add_child(skeleton);
+		AnimationPlayer *player = memnew(AnimationPlayer);
+		player->add_animation_library("", library);
+		player->set_shared_sampling_enabled(p_shared_sampling);
+		character->add_child(player);
+		SceneTree::get_singleton()->get_root()->add_child(character);
+		player->play("walk");
+		player->seek((i % 4) * 0.1, true);
+		characters.push_back(character);
+		skeletons.push_back(skeleton);
+	}
+
+	SceneTree::get_singleton()->process(0.25);
+	SceneTree::get_singleton()->process(0.25);
+
+	LocalVector<Transform3D> poses;
+	for (Skeleton3D *skeleton : skeletons) {
+		poses.push_back(skeleton->get_bone_global_pose(1));
+	}
+	for (Node *character : characters) {
+		memdelete(character);
+	}
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_processing", false);
+	return poses;
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] Parallel processing matches serial processing") {
+	const int characters = 8;
+	LocalVector<Transform3D> serial = _play_bone_animations(false, false, characters);
+	LocalVector<Transform3D> parallel = _play_bone_animations(true, false, characters);
+	REQUIRE(serial.size() == parallel.size());
+	for (int i = 0; i < characters; i++) {
+		CHECK_MESSAGE(parallel[i].is_equal_approx(serial[i]), vformat("Pose of character %d differs.", i));
+		CHECK_FALSE_MESSAGE(serial[i].is_equal_approx(Transform3D()), "Animation should have moved the bone.");
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] Shared sampling matches regular sampling") {
+	const int characters = 8;
+	LocalVector<Transform3D> regular = _play_bone_animations(false, false, characters);
+	LocalVector<Transform3D> shared = _play_bone_animations(false, true, characters);
+	LocalVector<Transform3D> shared_parallel = _play_bone_animations(true, true, characters);
+	REQUIRE(regular.size() == shared.size());
+	REQUIRE(regular.size() == shared_parallel.size());
+	for (int i = 0; i < characters; i++) {
+		CHECK_MESSAGE(shared[i].is_equal_approx(regular[i]), vformat("Pose of character %d differs.", i));
+		CHECK_MESSAGE(shared_parallel[i].is_equal_approx(regular[i]), vformat("Pose of character %d differs.", i));
+	}
+	AnimationSampleCache::clear();
+}
+
+TEST_CASE("[AnimationPlayer] Shared sampling cache entries") {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Skeleton:bone"));
+	animation->position_track_insert_key(position_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(position_track, 1.0, Vector3(4, 0, 0));
+	int value_track = animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(value_track, NodePath("Node:visible"));
+	int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Mesh:smile"));
+	animation->blend_shape_track_insert_key(blend_shape_track, 0.0, 0.0);
+	animation->blend_shape_track_insert_key(blend_shape_track, 1.0, 1.0);
+
+	AnimationSampleCache::clear();
+	const AnimationSampleCache::Entry *entry = AnimationSampleCache::get_entry(animation, 0.25);
+	REQUIRE(entry != nullptr);
+	CHECK_MESSAGE(AnimationSampleCache::get_entry(animation, 0.25) == entry, "Sampling the same time again should reuse the entry.");
+	CHECK(AnimationSampleCache::get_entry(animation, 0.5) != entry);
+	CHECK(entry->is_valid_for(animation.ptr(), 0.25));
+	CHECK_FALSE(entry->is_valid_for(animation.ptr(), 0.5));
+
+	// Same track layout, different keys.
+	Ref<Animation> other_animation = animation->duplicate();
+	other_animation->track_set_key_value(position_track, 1, Vector3(8, 0, 0));
+	const AnimationSampleCache::Entry *other_entry = AnimationSampleCache::get_entry(other_animation, 0.25);
+	REQUIRE(other_entry != entry);
+	CHECK_FALSE_MESSAGE(entry->is_valid_for(other_animation.ptr(), 0.25), "Entries should not be used for another animation with the same track count.");
+	Vector3 other_position;
+	CHECK(other_entry->get_position(position_track, &other_position) == OK);
+	CHECK(other_position.is_equal_approx(Vector3(2, 0, 0)));
+
+	animation->add_track(Animation::TYPE_SCALE_3D);
+	CHECK_FALSE_MESSAGE(entry->is_valid_for(animation.ptr(), 0.25), "Entries should not be used once tracks are added.");
+	animation->remove_track(animation->get_track_count() - 1);
+
+	Vector3 position;
+	CHECK(entry->get_position(position_track, &position) == OK);
+	CHECK(position.is_equal_approx(Vector3(1, 0, 0)));
+	float blend = 0;
+	CHECK(entry->get_blend_shape(blend_shape_track, &blend) == OK);
+	CHECK(blend == doctest::Approx(0.25));
+	Quaternion rotation;
+	CHECK_MESSAGE(entry->get_rotation(value_track, &rotation) != OK, "Value tracks are not sampled by the cache.");
+
+	CHECK(AnimationSampleCache::quantize_time(0.26, 0.0) == doctest::Approx(0.26));
+	CHECK(AnimationSampleCache::quantize_time(0.26, 0.1) == doctest::Approx(0.3));
+	AnimationSampleCache::clear();
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] Level of detail throttles and masks tracks") {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(4.0);
+	int body_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(body_track, NodePath("Skeleton:body"));
+	animation->position_track_insert_key(body_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(body_track, 4.0, Vector3(4, 0, 0));
+	int finger_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(finger_track, NodePath("Skeleton:finger"));
+	animation->position_track_insert_key(finger_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(finger_track, 4.0, Vector3(4, 0, 0));
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", animation);
+
+	Camera3D *camera = memnew(Camera3D);
+	SceneTree::get_singleton()->get_root()->add_child(camera);
+	camera->make_current();
+
+	Node3D *character = memnew(Node3D);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton");
+	skeleton->add_bone("body");
+	skeleton->add_bone("finger");
+	skeleton->set_bone_parent(1, 0);
+	character->add_child(skeleton);
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->add_animation_library("", library);
+	player->set_lod_enabled(true);
+	player->set_lod_thresholds(PackedFloat32Array({ 10, 20 }));
+	player->set_lod_bone_mask(PackedStringArray({ "Skeleton:*finger*" }));
+	player->set_lod_bone_mask_level(2);
+	character->add_child(player);
+	character->set_position(Vector3(0, 0, -50));
+	SceneTree::get_singleton()->get_root()->add_child(character);
+	player->play("walk");
+
+	for (int i = 0; i < 12; i++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(player->get_lod_level() == 2);
+	CHECK_MESSAGE(skeleton->get_bone_pose_position(1).is_equal_approx(Vector3()), "Masked bones should not be animated.");
+	real_t last_x = skeleton->get_bone_pose_position(0).x;
+	CHECK(last_x > 0);
+	for (int i = 0; i < 4; i++) {
+		SceneTree::get_singleton()->process(0.1);
+		real_t x = skeleton->get_bone_pose_position(0).x;
+		CHECK_MESSAGE(x > last_x, "Bones should be interpolated between updates.");
+		last_x = x;
+	}
+
+	character->set_position(Vector3(0, 0, -5));
+	for (int i = 0; i < 5; i++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(player->get_lod_level() == 0);
+	Vector3 expected = animation->position_track_interpolate(body_track, player->get_current_animation_position());
+	CHECK_MESSAGE(skeleton->get_bone_pose_position(0).is_equal_approx(expected), "Full detail should evaluate every frame.");
+	CHECK(skeleton->get_bone_pose_position(1).is_equal_approx(expected));
+
+	memdelete(character);
+	memdelete(camera);
+}
+#endif // _3D_DISABLED
+
 } // namespace TestAnimationPlayer
@@ -105,6 +105,28 @@ public:
 	}
 };
 
+class TestThreadSafeNode : public Node {
+	GDCLASS(TestThreadSafeNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			process_counter.increment();
+			if (read_node) {
+				read_node->can_auto_translate();
+			}
+		}
+	}
+
+	virtual Node *_get_process_thread_scope() const override {
+		return const_cast<TestThreadSafeNode *>(this);
+	}
+
+public:
+	SafeNumeric<int> process_counter;
+	Node *read_node = nullptr;
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -913,4 +935,118 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Automatic thread groups") {
+	SceneTree *tree = SceneTree::get_singleton();
+	bool was_enabled = tree->is_automatic_thread_groups_enabled();
+	tree->set_automatic_thread_groups_enabled(true);
+
+	Node *parent = memnew(Node);
+	tree->get_root()->add_child(parent);
+
+	TestThreadSafeNode *safe = memnew(TestThreadSafeNode);
+	safe->set_process(true);
+	parent->add_child(safe);
+
+	SUBCASE("Thread-safe nodes get their own group") {
+		TestThreadSafeNode *safe2 = memnew(TestThreadSafeNode);
+		safe2->set_process(true);
+		parent->add_child(safe2);
+
+		tree->process(0);
+		CHECK_EQ(2, tree->get_automatic_thread_group_count());
+		CHECK_EQ(1, safe->process_counter.get());
+		CHECK_EQ(1, safe2->process_counter.get());
+		CHECK_EQ(Node::PROCESS_THREAD_GROUP_INHERIT, safe->get_process_thread_group());
+	}
+
+	SUBCASE("Nested thread-safe nodes are merged") {
+		TestThreadSafeNode *child = memnew(TestThreadSafeNode);
+		child->set_process(true);
+		safe->add_child(child);
+
+		tree->process(0);
+		CHECK_EQ(1, tree->get_automatic_thread_group_count());
+		CHECK_EQ(1, child->process_counter.get());
+	}
+
+	SUBCASE("Unknown nodes stay on the main thread") {
+		TestNode *child = memnew(TestNode);
+		child->set_process(true);
+		safe->add_child(child);
+
+		tree->process(0);
+		CHECK_EQ(0, tree->get_automatic_thread_group_count());
+		CHECK_EQ(1, safe->process_counter.get());
+		CHECK_EQ(1, child->process_counter);
+
+		// Removing it allows the group again.
+		memdelete(child);
+		tree->process(0);
+		CHECK_EQ(1, tree->get_automatic_thread_group_count());
+	}
+
+	SUBCASE("Signal targets must declare their scope") {
+		Node *target = memnew(Node);
+		parent->add_child(target);
+		safe->connect(SceneStringName(ready), callable_mp(target, &Node::queue_free));
+
+		tree->process(0);
+		CHECK_EQ(0, tree->get_automatic_thread_group_count());
+
+		safe->disconnect(SceneStringName(ready), callable_mp(target, &Node::queue_free));
+		safe->connect(SceneStringName(ready), callable_mp(target, &Node::queue_free), Object::CONNECT_DEFERRED);
+		safe->set_process(false);
+		safe->set_process(true);
+
+		tree->process(0);
+		CHECK_EQ(1, tree->get_automatic_thread_group_count());
+	}
+
+	SUBCASE("Explicit thread groups are left alone") {
+		parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+
+		tree->process(0);
+		CHECK_EQ(0, tree->get_automatic_thread_group_count());
+		CHECK_EQ(1, safe->process_counter.get());
+	}
+
+	SUBCASE("Disabling removes the groups") {
+		tree->process(0);
+		CHECK_EQ(1, tree->get_automatic_thread_group_count());
+
+		tree->set_automatic_thread_groups_enabled(false);
+		CHECK_EQ(0, tree->get_automatic_thread_group_count());
+		tree->process(0);
+		CHECK_EQ(2, safe->process_counter.get());
+
+		// Nodes added while disabled are found when enabling again.
+		TestThreadSafeNode *safe2 = memnew(TestThreadSafeNode);
+		safe2->set_process(true);
+		parent->add_child(safe2);
+		tree->set_automatic_thread_groups_enabled(true);
+		tree->process(0);
+		CHECK_EQ(2, tree->get_automatic_thread_group_count());
+	}
+
+#ifdef DEBUG_ENABLED
+	SUBCASE("Groups accessing other nodes are moved back to the main thread") {
+		Node *other = memnew(Node);
+		parent->add_child(other);
+		safe->read_node = other;
+
+		ERR_PRINT_OFF;
+		tree->process(0);
+		ERR_PRINT_ON;
+		CHECK_EQ(1, safe->process_counter.get());
+
+		tree->process(0);
+		CHECK_EQ(0, tree->get_automatic_thread_group_count());
+		CHECK_EQ(2, safe->process_counter.get());
+	}
+#endif // DEBUG_ENABLED
+
+	memdelete(parent);
+	tree->set_automatic_thread_groups_enabled(was_enabled);
+}
+
 } // namespace TestNode
@@ -72,4 +72,33 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	skeleton->set_bone_meta(0, "non-existing-key", Variant());
 	memdelete(skeleton);
 }
+
+TEST_CASE("[Skeleton3D] Set bone poses in batch") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->add_bone("root");
+	skeleton->add_bone("child");
+	skeleton->set_bone_parent(1, 0);
+	skeleton->set_bone_pose_scale(1, Vector3(2, 2, 2));
+
+	LocalVector<Skeleton3D::BonePoseUpdate> updates;
+	Skeleton3D::BonePoseUpdate update;
+	update.bone = 0;
+	update.components = Skeleton3D::BONE_POSE_POSITION | Skeleton3D::BONE_POSE_ROTATION;
+	update.position = Vector3(1, 2, 3);
+	update.rotation = Quaternion(Vector3(0, 1, 0), Math::PI * 0.5);
+	updates.push_back(update);
+	update.bone = 1;
+	update.components = Skeleton3D::BONE_POSE_POSITION;
+	update.position = Vector3(0, 1, 0);
+	updates.push_back(update);
+	skeleton->set_bone_poses(updates);
+
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(1, 2, 3)));
+	CHECK(skeleton->get_bone_pose_rotation(0).is_equal_approx(Quaternion(Vector3(0, 1, 0), Math::PI * 0.5)));
+	CHECK(skeleton->get_bone_pose_position(1).is_equal_approx(Vector3(0, 1, 0)));
+	CHECK_MESSAGE(skeleton->get_bone_pose_scale(1).is_equal_approx(Vector3(2, 2, 2)), "Components not in the mask should be left untouched.");
+	CHECK(skeleton->get_bone_global_pose(1).origin.is_equal_approx(Vector3(1, 2, 3) + Quaternion(Vector3(0, 1, 0), Math::PI * 0.5).xform(Vector3(0, 1, 0))));
+
+	memdelete(skeleton);
+}
 } // namespace TestSkeleton3D
@@ -54,10 +54,15 @@
 #include "tests/core/io/test_json_native.h"
 #include "tests/core/io/test_logger.h"
 #include "tests/core/io/test_marshalls.h"
+#include "tests/core/io/test_packed_snapshot.h"
 #include "tests/core/io/test_packet_peer.h"
 #include "tests/core/io/test_pck_packer.h"
 #include "tests/core/io/test_resource.h"
 #include "tests/core/io/test_resource_uid.h"
+#include "tests/core/io/test_save_journal.h"
+#include "tests/core/io/test_save_server.h"
+#include "tests/core/io/test_snapshot_hasher.h"
+#include "tests/core/io/test_snapshot_index.h"
 #include "tests/core/io/test_stream_peer.h"
 #include "tests/core/io/test_stream_peer_buffer.h"
 #include "tests/core/io/test_stream_peer_gzip.h"
@@ -88,14 +93,18 @@
 #include "tests/core/math/test_vector3i.h"
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
+#include "tests/core/object/test_call_site_cache.h"
 #include "tests/core/object/test_class_db.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/os/test_frame_arena.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/os/test_small_object_pool.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_a_hash_map.h"